@@ -0,0 +1,44 @@
+# Copyright (C) 2017 Chalmers Revere
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation; either version 2
+# of the License, or (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+# Builds the benchmarks in benchmarks/ into ${PROJECT_NAME}-bench, which is
+# only part of the default build with PERFTESTS, and adds
+# ${PROJECT_NAME}-bench-json, which runs them and writes the results to
+# ${PROJECT_NAME}-bench.json, and ${PROJECT_NAME}-bench-baseline, which writes
+# the baseline of the perf test to benchmarks/baseline.json.
+file(GLOB BENCHMARKS "${CMAKE_CURRENT_SOURCE_DIR}/benchmarks/*.cpp")
+
+if(BENCHMARKS)
+  if(PERFTESTS)
+    add_executable(${PROJECT_NAME}-bench ${BENCHMARKS})
+  else()
+    add_executable(${PROJECT_NAME}-bench EXCLUDE_FROM_ALL ${BENCHMARKS})
+  endif()
+  target_link_libraries(${PROJECT_NAME}-bench ${PROJECT_NAME}-static ${LIBRARIES})
+
+  set(BENCHMARK_ARGS "")
+  if(EXISTS "${CMAKE_CURRENT_SOURCE_DIR}/benchmarks/recording.rec")
+    set(BENCHMARK_ARGS --benchmark_rec=${CMAKE_CURRENT_SOURCE_DIR}/benchmarks/recording.rec)
+  endif()
+
+  add_custom_target(${PROJECT_NAME}-bench-json
+    COMMAND ${PROJECT_NAME}-bench ${BENCHMARK_ARGS} --benchmark_out=${CMAKE_CURRENT_BINARY_DIR}/${PROJECT_NAME}-bench.json
+    DEPENDS ${PROJECT_NAME}-bench)
+
+  add_custom_target(${PROJECT_NAME}-bench-baseline
+    COMMAND ${PROJECT_NAME}-bench ${BENCHMARK_ARGS} --benchmark_out=${CMAKE_CURRENT_SOURCE_DIR}/benchmarks/baseline.json
+    DEPENDS ${PROJECT_NAME}-bench)
+endif()
@@ -31,3 +31,20 @@ if(CXXTEST_FOUND)
     target_link_libraries(${TESTSUITE-FILENAME}-TestSuite ${PROJECT_NAME}-static ${LIBRARIES})
   endforeach()
 endif(CXXTEST_FOUND)
+
+# With PERFTESTS, ${PROJECT_NAME}-PerfTest runs the benchmarks on their fixed
+# inputs, and on benchmarks/recording.rec if there is one, and fails if any
+# got slower than in benchmarks/baseline.json by more than PERFTEST_THRESHOLD.
+# The test fails until the baseline has been written on the machine it runs
+# on, which is done by the ${PROJECT_NAME}-bench-baseline target.
+file(GLOB PERFTEST_BENCHMARKS "${CMAKE_CURRENT_SOURCE_DIR}/benchmarks/*.cpp")
+
+if(PERFTESTS AND PERFTEST_BENCHMARKS)
+  set(PERFTEST_ARGS --benchmark_baseline=${CMAKE_CURRENT_SOURCE_DIR}/benchmarks/baseline.json --benchmark_threshold=${PERFTEST_THRESHOLD})
+  if(EXISTS "${CMAKE_CURRENT_SOURCE_DIR}/benchmarks/recording.rec")
+    list(APPEND PERFTEST_ARGS --benchmark_rec=${CMAKE_CURRENT_SOURCE_DIR}/benchmarks/recording.rec)
+  endif()
+
+  add_test(NAME ${PROJECT_NAME}-PerfTest COMMAND ${PROJECT_NAME}-bench ${PERFTEST_ARGS})
+  set_tests_properties(${PROJECT_NAME}-PerfTest PROPERTIES TIMEOUT 3000 RUN_SERIAL TRUE)
+endif()
@@ -0,0 +1,132 @@
+/**
+* Copyright (C) 2017 Chalmers Revere
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+* USA.
+*/
+
+#include <vector>
+
+#include <opendavinci/odcore/data/TimeStamp.h>
+
+#include <odvdcfsd18/GeneratedHeaders_ODVDcfsd18.h>
+
+#include "benchmark.hpp"
+#include "delaycompensator.hpp"
+#include "geometriccontroller.hpp"
+#include "inprocessbus.hpp"
+#include "lateral.hpp"
+#include "modelpredictivecontroller.hpp"
+
+namespace {
+
+using opendlv::logic::cfsd18::common::BenchmarkState;
+using opendlv::logic::cfsd18::common::InProcessBus;
+using opendlv::logic::cfsd18::common::doNotOptimize;
+
+void solveModelPredictive(BenchmarkState &a_state)
+{
+  opendlv::logic::cfsd18::action::ModelPredictiveController controller(1.53f,
+      0.02f, 1.0f, 1.0f, 0.1f, 1.0f);
+  float lateralError = 0.3f;
+  while (a_state.keepRunning()) {
+    float const groundSteering =
+      controller.solve(lateralError, 0.05f, 10.0f, 0.4f);
+    doNotOptimize(groundSteering);
+    lateralError = -lateralError;
+  }
+}
+
+void steerPurePursuit(BenchmarkState &a_state)
+{
+  opendlv::logic::cfsd18::action::GeometricController controller(1.53f);
+  while (a_state.keepRunning()) {
+    float const groundSteering = controller.purePursuit(0.1f, 6.0f, 10.0f);
+    doNotOptimize(groundSteering);
+  }
+}
+
+void steerStanley(BenchmarkState &a_state)
+{
+  opendlv::logic::cfsd18::action::GeometricController controller(1.53f);
+  while (a_state.keepRunning()) {
+    float const groundSteering = controller.stanley(0.1f, 6.0f, 10.0f);
+    doNotOptimize(groundSteering);
+  }
+}
+
+void predictAimPoint(BenchmarkState &a_state)
+{
+  opendlv::logic::cfsd18::action::DelayCompensator compensator(1.53f, 0.05f);
+  opendlv::logic::action::AimPoint aimPoint(0.1f, 0.0f, 6.0f);
+  while (a_state.keepRunning()) {
+    auto predicted = compensator.predict(aimPoint, 10.0f, 0.05f, 0.02f);
+    doNotOptimize(predicted);
+  }
+}
+
+/**
+ * Decoding, control and sending of the steering request for every aim point.
+ * The aim points are made fresh, so that none misses the deadline.
+ */
+void controlAimPoints(BenchmarkState &a_state,
+    std::vector<odcore::data::Container> &a_aimPoints)
+{
+  InProcessBus bus(opendlv::logic::cfsd18::common::Delivery::Direct,
+      opendlv::logic::cfsd18::common::Mirroring::None);
+  auto lateral = opendlv::logic::cfsd18::common::createMicroservice<
+    opendlv::logic::cfsd18::action::Lateral>(bus);
+  uint64_t i = 0;
+  while (a_state.keepRunning()) {
+    odcore::data::Container &aimPoint = a_aimPoints[i++ % a_aimPoints.size()];
+    aimPoint.setSampleTimeStamp(odcore::data::TimeStamp());
+    lateral->nextContainer(aimPoint);
+  }
+  a_state.setItemsProcessed(a_state.iterations());
+}
+
+void controlSyntheticAimPoints(BenchmarkState &a_state)
+{
+  std::vector<odcore::data::Container> containers;
+  for (uint32_t i = 0; i < 16; i++) {
+    opendlv::logic::action::AimPoint aimPoint(
+        0.02f * static_cast<float>(i) - 0.15f, 0.0f, 6.0f);
+    containers.push_back(odcore::data::Container(aimPoint));
+  }
+  controlAimPoints(a_state, containers);
+}
+
+void controlRecordedAimPoints(BenchmarkState &a_state)
+{
+  std::vector<odcore::data::Container> containers =
+    opendlv::logic::cfsd18::common::Benchmarks::instance().recorded(
+        opendlv::logic::action::AimPoint::ID());
+  if (containers.empty()) {
+    a_state.skip("No recorded aim points.");
+    return;
+  }
+  controlAimPoints(a_state, containers);
+}
+
+CFSD18_BENCHMARK(solveModelPredictive);
+CFSD18_BENCHMARK(steerPurePursuit);
+CFSD18_BENCHMARK(steerStanley);
+CFSD18_BENCHMARK(predictAimPoint);
+CFSD18_BENCHMARK(controlSyntheticAimPoints);
+CFSD18_BENCHMARK(controlRecordedAimPoints);
+
+}
+
+CFSD18_BENCHMARK_MAIN()
@@ -0,0 +1,57 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_ACTION_DELAYCOMPENSATOR_HPP
+#define OPENDLV_LOGIC_CFSD18_ACTION_DELAYCOMPENSATOR_HPP
+
+#include <odvdcfsd18/GeneratedHeaders_ODVDcfsd18.h>
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace action {
+
+/**
+ * Moves an aim point into the vehicle frame that the car will have when a
+ * steering request sent now takes effect, i.e. after the pipeline latency of
+ * the aim point plus the transport delay of the steering actuator. The car
+ * is assumed to follow the kinematic bicycle model at constant speed and
+ * with the currently requested steering angle.
+ */
+class DelayCompensator {
+ public:
+  DelayCompensator(float, float);
+  DelayCompensator(DelayCompensator const &) = default;
+  DelayCompensator &operator=(DelayCompensator const &) = default;
+  virtual ~DelayCompensator();
+
+  opendlv::logic::action::AimPoint predict(
+      opendlv::logic::action::AimPoint const &, float, float, float) const;
+
+ private:
+  float m_wheelBase;
+  float m_actuatorDelay;
+};
+
+}
+}
+}
+}
+
+#endif
@@ -0,0 +1,52 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_ACTION_GEOMETRICCONTROLLER_HPP
+#define OPENDLV_LOGIC_CFSD18_ACTION_GEOMETRICCONTROLLER_HPP
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace action {
+
+/**
+ * Pure pursuit and Stanley steering towards the aim point, with gains
+ * scheduled over speed from tables that are generated at compile time. Both
+ * are closed-form and serve as cheap fallbacks to the MPC.
+ */
+class GeometricController {
+ public:
+  explicit GeometricController(float);
+  GeometricController(GeometricController const &) = default;
+  GeometricController &operator=(GeometricController const &) = default;
+  virtual ~GeometricController();
+
+  float purePursuit(float, float, float) const;
+  float stanley(float, float, float) const __attribute__((const));
+
+ private:
+  float m_wheelBase;
+};
+
+}
+}
+}
+}
+
+#endif
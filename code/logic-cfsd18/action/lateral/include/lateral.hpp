@@ -20,17 +20,34 @@
 #ifndef OPENDLV_LOGIC_CFSD18_ACTION_LATERAL_HPP
 #define OPENDLV_LOGIC_CFSD18_ACTION_LATERAL_HPP
 
+#include <opendavinci/odcore/base/KeyValueConfiguration.h>
 #include <opendavinci/odcore/base/module/DataTriggeredConferenceClientModule.h>
 #include <opendavinci/odcore/data/Container.h>
+#include <opendavinci/odcore/data/TimeStamp.h>
 
 //#include <odvdopendlvstandardmessageset/GeneratedHeaders_ODVDOpenDLVStandardMessageSet.h>
 #include <odvdcfsd18/GeneratedHeaders_ODVDcfsd18.h>
 
+#include "busport.hpp"
+#include "dispatcher.hpp"
+#include "fixedrateloop.hpp"
+#include "mailbox.hpp"
+
+#include "delaycompensator.hpp"
+#include "geometriccontroller.hpp"
+#include "modelpredictivecontroller.hpp"
+
 namespace opendlv {
 namespace logic {
 namespace cfsd18 {
 namespace action {
 
+enum class ControllerMode {
+  ModelPredictive,
+  PurePursuit,
+  Stanley
+};
+
 class Lateral : public odcore::base::module::DataTriggeredConferenceClientModule {
  public:
   Lateral(int32_t const &, char **);
@@ -38,10 +55,42 @@ class Lateral : public odcore::base::module::DataTriggeredConferenceClientModule
   Lateral &operator=(Lateral const &) = delete;
   virtual ~Lateral();
   virtual void nextContainer(odcore::data::Container &);
+  void attachBus(common::InProcessBus &);
+  void setUp(odcore::base::KeyValueConfiguration const &);
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 
  private:
   void setUp();
   void tearDown();
+  void process(odcore::data::Container &);
+  void step();
+  float computeSteering(opendlv::logic::action::AimPoint const &);
+  float ageSince(odcore::data::TimeStamp const &) const;
+  void receive(odcore::data::Container &);
+  void onGroundSteeringLimit(
+      opendlv::logic::cognition::GroundSteeringLimit const &,
+      odcore::data::Container &);
+  void onGroundSpeedReading(opendlv::proxy::GroundSpeedReading const &,
+      odcore::data::Container &);
+  void onAimPoint(odcore::data::Container &);
+
+  common::BusPort m_busPort;
+  common::Dispatcher<Lateral> m_dispatcher;
+  ControllerMode m_controllerMode;
+  ModelPredictiveController m_modelPredictiveController;
+  GeometricController m_geometricController;
+  DelayCompensator m_delayCompensator;
+  float m_aimPointDeadline;
+  double m_mpcDeadline;
+  uint32_t m_mpcBackoff;
+  float m_groundSpeed;
+  float m_steeringLimit;
+  float m_groundSteering;
+  common::Mailbox<odcore::data::Container> m_aimPointInput;
+  common::Mailbox<odcore::data::Container> m_groundSpeedInput;
+  common::Mailbox<odcore::data::Container> m_steeringLimitInput;
+  common::FixedRateLoop m_controlLoop;
 };
 
 }
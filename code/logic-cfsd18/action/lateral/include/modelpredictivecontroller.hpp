@@ -0,0 +1,81 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_ACTION_MODELPREDICTIVECONTROLLER_HPP
+#define OPENDLV_LOGIC_CFSD18_ACTION_MODELPREDICTIVECONTROLLER_HPP
+
+#include <cstdint>
+
+#include <opendavinci/odcore/wrapper/Eigen.h>
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace action {
+
+/**
+ * Lateral model predictive controller on the kinematic bicycle model, with
+ * the lateral and heading error to the reference line as states and the
+ * steering angle as input. The prediction is condensed into a box
+ * constrained QP over the steering sequence, which is solved with a fixed
+ * maximum number of ADMM iterations and warm-started from the shifted
+ * solution of the previous call. All matrices have a compile-time size.
+ */
+class ModelPredictiveController {
+ public:
+  static int32_t const HORIZON = 10;
+  typedef Eigen::Matrix<float, HORIZON, 1> InputSequence;
+  typedef Eigen::Matrix<float, HORIZON, HORIZON> Hessian;
+  typedef Eigen::Matrix<float, 2 * HORIZON, 2> FreeResponse;
+  typedef Eigen::Matrix<float, 2 * HORIZON, HORIZON> ForcedResponse;
+
+  ModelPredictiveController(float, float, float, float, float, float);
+  ModelPredictiveController(ModelPredictiveController const &) = default;
+  ModelPredictiveController &operator=(ModelPredictiveController const &) = default;
+  virtual ~ModelPredictiveController();
+
+  float solve(float, float, float, float);
+  InputSequence const &solution() const __attribute__((const));
+  uint32_t iterations() const;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+ private:
+  void predict(float);
+
+  float m_wheelBase;
+  float m_sampleTime;
+  float m_lateralWeight;
+  float m_headingWeight;
+  float m_steeringWeight;
+  float m_steeringRateWeight;
+  float m_previousSteering;
+  uint32_t m_iterations;
+  FreeResponse m_freeResponse;
+  ForcedResponse m_forcedResponse;
+  InputSequence m_z;
+  InputSequence m_w;
+};
+
+}
+}
+}
+}
+
+#endif
@@ -0,0 +1,81 @@
+/**
+* Copyright (C) 2017 Chalmers Revere
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+* USA.
+*/
+
+#include <cmath>
+
+#include "delaycompensator.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace action {
+
+DelayCompensator::DelayCompensator(float a_wheelBase, float a_actuatorDelay) :
+  m_wheelBase(a_wheelBase),
+  m_actuatorDelay(a_actuatorDelay)
+{
+}
+
+DelayCompensator::~DelayCompensator()
+{
+}
+
+/**
+ * Returns the aim point as seen from the predicted pose, given the ground
+ * speed [m/s], the current steering angle [rad] and the age of the aim
+ * point [s].
+ */
+opendlv::logic::action::AimPoint DelayCompensator::predict(
+    opendlv::logic::action::AimPoint const &a_aimPoint, float a_groundSpeed,
+    float a_groundSteering, float a_latency) const
+{
+  float const horizon = m_actuatorDelay + a_latency;
+  float const travelled = a_groundSpeed * horizon;
+  float const curvature = std::tan(a_groundSteering) / m_wheelBase;
+  float const headingChange = travelled * curvature;
+
+  // Pose after driving along the arc, with the straight line as the limit
+  // for small heading changes.
+  float x = travelled;
+  float y = 0.5f * travelled * headingChange;
+  if (std::fabs(headingChange) > 1e-3f) {
+    x = std::sin(headingChange) / curvature;
+    y = (1.0f - std::cos(headingChange)) / curvature;
+  }
+
+  float const aimX = a_aimPoint.getDistance()
+    * std::cos(a_aimPoint.getAzimuthAngle()) - x;
+  float const aimY = a_aimPoint.getDistance()
+    * std::sin(a_aimPoint.getAzimuthAngle()) - y;
+  float const cosHeading = std::cos(headingChange);
+  float const sinHeading = std::sin(headingChange);
+  float const predictedX = cosHeading * aimX + sinHeading * aimY;
+  float const predictedY = -sinHeading * aimX + cosHeading * aimY;
+
+  opendlv::logic::action::AimPoint predicted(a_aimPoint);
+  predicted.setAzimuthAngle(std::atan2(predictedY, predictedX));
+  predicted.setDistance(std::sqrt(predictedX * predictedX
+        + predictedY * predictedY));
+  return predicted;
+}
+
+}
+}
+}
+}
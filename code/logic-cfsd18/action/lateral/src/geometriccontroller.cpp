@@ -0,0 +1,105 @@
+/**
+* Copyright (C) 2017 Chalmers Revere
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+* USA.
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include "gainschedule.hpp"
+#include "geometriccontroller.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace action {
+
+namespace {
+
+uint32_t const gainScheduleSize = 16;
+
+/**
+ * Scales the pure pursuit curvature down at speed, 1 / (1 + c v^2), to avoid
+ * oscillations from the fixed look-ahead.
+ */
+constexpr common::GainSchedule<gainScheduleSize> makePurePursuitGains()
+{
+  common::GainSchedule<gainScheduleSize> schedule{2.0f, {}};
+  for (uint32_t i = 0; i < gainScheduleSize; i++) {
+    float const speed = schedule.speedStep * static_cast<float>(i);
+    schedule.gains[i] = 1.0f / (1.0f + 0.002f * speed * speed);
+  }
+  return schedule;
+}
+
+/**
+ * Stanley cross-track gain divided by the softened speed, k / (k_s + v), so
+ * that the steering angle is atan(gain * e).
+ */
+constexpr common::GainSchedule<gainScheduleSize> makeStanleyGains()
+{
+  common::GainSchedule<gainScheduleSize> schedule{2.0f, {}};
+  for (uint32_t i = 0; i < gainScheduleSize; i++) {
+    float const speed = schedule.speedStep * static_cast<float>(i);
+    float const gain = 2.5f / (1.0f + 0.01f * speed);
+    schedule.gains[i] = gain / (1.0f + speed);
+  }
+  return schedule;
+}
+
+constexpr common::GainSchedule<gainScheduleSize> purePursuitGains = makePurePursuitGains();
+constexpr common::GainSchedule<gainScheduleSize> stanleyGains = makeStanleyGains();
+
+}
+
+GeometricController::GeometricController(float a_wheelBase) :
+  m_wheelBase(a_wheelBase)
+{
+}
+
+GeometricController::~GeometricController()
+{
+}
+
+/**
+ * Steers along the circular arc through the aim point, given by its azimuth
+ * angle [rad] and distance [m].
+ */
+float GeometricController::purePursuit(float a_azimuthAngle, float a_distance,
+    float a_groundSpeed) const
+{
+  float const curvature = 2.0f * std::sin(a_azimuthAngle)
+    / std::max(a_distance, 0.1f);
+  return std::atan(purePursuitGains.at(a_groundSpeed) * m_wheelBase * curvature);
+}
+
+/**
+ * Steers onto the line through the aim point that is parallel to the current
+ * heading, so that the cross-track error is the lateral offset of the aim
+ * point.
+ */
+float GeometricController::stanley(float a_azimuthAngle, float a_distance,
+    float a_groundSpeed) const
+{
+  float const crossTrackError = a_distance * std::sin(a_azimuthAngle);
+  return std::atan(stanleyGains.at(a_groundSpeed) * crossTrackError);
+}
+
+}
+}
+}
+}
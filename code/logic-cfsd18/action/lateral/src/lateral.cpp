@@ -17,13 +17,17 @@
 * USA.
 */
 
+#include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <string>
 
 #include <opendavinci/odcore/data/TimeStamp.h>
 #include <opendavinci/odcore/strings/StringToolbox.h>
 #include <opendavinci/odcore/wrapper/Eigen.h>
 
 #include "lateral.hpp"
+#include "trace.hpp"
 
 namespace opendlv {
 namespace logic {
@@ -31,43 +35,271 @@ namespace cfsd18 {
 namespace action {
 
 Lateral::Lateral(int32_t const &a_argc, char **a_argv) :
-  DataTriggeredConferenceClientModule(a_argc, a_argv, "logic-cfsd18-action-lateral")
+  DataTriggeredConferenceClientModule(a_argc, a_argv, "logic-cfsd18-action-lateral"),
+  m_busPort([this](odcore::data::Container &a_container) { receive(a_container); },
+      [this](odcore::data::Container &a_container) { getConference().send(a_container); }),
+  m_dispatcher(),
+  m_controllerMode(ControllerMode::ModelPredictive),
+  m_modelPredictiveController(1.53f, 0.02f, 1.0f, 1.0f, 0.1f, 1.0f),
+  m_geometricController(1.53f),
+  m_delayCompensator(1.53f, 0.05f),
+  m_aimPointDeadline(0.1f),
+  m_mpcDeadline(0.001),
+  m_mpcBackoff(0),
+  m_groundSpeed(0.0f),
+  m_steeringLimit(0.4f),
+  m_groundSteering(0.0f),
+  m_aimPointInput(),
+  m_groundSpeedInput(),
+  m_steeringLimitInput(),
+  m_controlLoop()
 {
+  m_dispatcher
+    .add<opendlv::logic::cognition::GroundSteeringLimit, &Lateral::onGroundSteeringLimit>()
+    .add<opendlv::proxy::GroundSpeedReading, &Lateral::onGroundSpeedReading>()
+    .add<opendlv::logic::action::AimPoint, &Lateral::onAimPoint>();
 }
 
 Lateral::~Lateral()
 {
 }
 
-
+void Lateral::attachBus(common::InProcessBus &a_bus)
+{
+  m_busPort.attach(a_bus);
+}
 
 void Lateral::nextContainer(odcore::data::Container &a_container)
 {
+  m_busPort.receive(a_container);
+}
+
+/**
+ * In the time-triggered mode, incoming data is only left in the mailboxes and
+ * the control loop does the work at its own pace.
+ */
+void Lateral::receive(odcore::data::Container &a_container)
+{
+  if (!m_controlLoop.isRunning()) {
+    process(a_container);
+    return;
+  }
+
   if (a_container.getDataType() == opendlv::logic::cognition::GroundSteeringLimit::ID()) {
-    // auto kinematicState = a_container.getData<opendlv::coord::KinematicState>();
+    m_steeringLimitInput.post(a_container);
+  }
+  if (a_container.getDataType() == opendlv::proxy::GroundSpeedReading::ID()) {
+    m_groundSpeedInput.post(a_container);
   }
   if (a_container.getDataType() == opendlv::logic::action::AimPoint::ID()) {
-    // auto kinematicState = a_container.getData<opendlv::coord::KinematicState>();
+    m_aimPointInput.post(a_container);
+  }
+}
 
-    opendlv::proxy::GroundSteeringRequest o1;
-    odcore::data::Container c1(o1);
-    getConference().send(c1);
+void Lateral::process(odcore::data::Container &a_container)
+{
+  m_dispatcher.dispatch(*this, a_container);
+}
+
+void Lateral::onGroundSteeringLimit(
+    opendlv::logic::cognition::GroundSteeringLimit const &a_groundSteeringLimit,
+    odcore::data::Container &)
+{
+  m_steeringLimit = a_groundSteeringLimit.getSteeringLimit();
+}
+
+void Lateral::onGroundSpeedReading(
+    opendlv::proxy::GroundSpeedReading const &a_groundSpeedReading,
+    odcore::data::Container &)
+{
+  m_groundSpeed = a_groundSpeedReading.getGroundSpeed();
+}
+
+/**
+ * An aim point older than the deadline is not worth the computation, nor the
+ * deserialisation, so the last command, which was already extrapolated, is
+ * repeated instead. The age on the last hop decides whether the aim point is
+ * stale, while the prediction covers the whole pipeline from its origin.
+ */
+void Lateral::onAimPoint(odcore::data::Container &a_container)
+{
+  if (ageSince(a_container.getSentTimeStamp()) < m_aimPointDeadline) {
+    float const latency = ageSince(common::originOf(a_container));
+    auto aimPoint = a_container.getData<opendlv::logic::action::AimPoint>();
+    auto predictedAimPoint = m_delayCompensator.predict(aimPoint,
+        m_groundSpeed, m_groundSteering, latency);
+    m_groundSteering = computeSteering(predictedAimPoint);
   }
+
+  opendlv::proxy::GroundSteeringRequest o1(m_groundSteering);
+  odcore::data::Container c1(o1);
+  common::propagateOrigin(a_container, c1);
+  m_busPort.send(c1);
+}
+
+/**
+ * One iteration of the time-triggered control loop. The latest aim point is
+ * reused until a new one arrives, which makes it older on every iteration
+ * until the aim point deadline stops it from being steered on.
+ */
+void Lateral::step()
+{
+  odcore::data::Container container;
+  if (m_steeringLimitInput.take(container)) {
+    process(container);
+  }
+  if (m_groundSpeedInput.take(container)) {
+    process(container);
+  }
+  if (m_aimPointInput.peek(container)) {
+    process(container);
+  }
+}
+
+/**
+ * Runs the configured controller. If the MPC misses its deadline, the pure
+ * pursuit controller is used for the following aim points before the MPC is
+ * tried again.
+ */
+float Lateral::computeSteering(opendlv::logic::action::AimPoint const &a_aimPoint)
+{
+  uint32_t const backoffAimPoints = 50;
+
+  float const azimuthAngle = a_aimPoint.getAzimuthAngle();
+  float const distance = a_aimPoint.getDistance();
+
+  float groundSteering = 0.0f;
+  if (m_controllerMode == ControllerMode::Stanley) {
+    groundSteering = m_geometricController.stanley(azimuthAngle, distance,
+        m_groundSpeed);
+  } else if (m_controllerMode == ControllerMode::PurePursuit
+      || m_mpcBackoff > 0) {
+    groundSteering = m_geometricController.purePursuit(azimuthAngle, distance,
+        m_groundSpeed);
+    m_mpcBackoff = (m_mpcBackoff > 0) ? m_mpcBackoff - 1 : 0;
+  } else {
+    // The reference line runs from the car to the aim point, so the car is on
+    // the line and its heading error is the negative aim point azimuth.
+    auto const start = std::chrono::steady_clock::now();
+    groundSteering = m_modelPredictiveController.solve(0.0f, -azimuthAngle,
+        m_groundSpeed, m_steeringLimit);
+    std::chrono::duration<double> const duration =
+      std::chrono::steady_clock::now() - start;
+    if (duration.count() > m_mpcDeadline) {
+      m_mpcBackoff = backoffAimPoints;
+      if (isVerbose()) {
+        std::cout << "MPC missed its deadline (" << duration.count()
+          << " s), falling back to pure pursuit." << std::endl;
+      }
+    }
+  }
+  return std::min(std::max(groundSteering, -m_steeringLimit), m_steeringLimit);
+}
+
+/**
+ * Time [s] since the given time stamp. From the sent time stamp, it is the
+ * age on the last hop, which the deadline is on: a deadline on the origin
+ * would drop every aim point as soon as the stages upstream took longer than
+ * the deadline.
+ */
+float Lateral::ageSince(odcore::data::TimeStamp const &a_timeStamp) const
+{
+  odcore::data::TimeStamp const now = m_busPort.now();
+  float const age = static_cast<float>(
+      (now - a_timeStamp).toMicroseconds()) / 1000000.0f;
+  return std::max(age, 0.0f);
 }
 
 void Lateral::setUp()
 {
-  // std::string const exampleConfig = 
-  //   getKeyValueConfiguration().getValue<std::string>(
-  //     "logic-cfsd18-action-lateral.example-config");
+  setUp(getKeyValueConfiguration());
+}
 
-  // if (isVerbose()) {
-  //   std::cout << "Example config is " << exampleConfig << std::endl;
-  // }
+void Lateral::setUp(
+    odcore::base::KeyValueConfiguration const &a_configuration)
+{
+  float const statisticsPeriod =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-action-lateral.statistics-period");
+  m_busPort.publishStatistics(getName(), statisticsPeriod);
+
+  float const wheelBase =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-action-lateral.wheel-base");
+  float const sampleTime =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-action-lateral.sample-time");
+  float const lateralWeight =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-action-lateral.lateral-weight");
+  float const headingWeight =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-action-lateral.heading-weight");
+  float const steeringWeight =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-action-lateral.steering-weight");
+  float const steeringRateWeight =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-action-lateral.steering-rate-weight");
+  m_modelPredictiveController = ModelPredictiveController(wheelBase,
+      sampleTime, lateralWeight, headingWeight, steeringWeight,
+      steeringRateWeight);
+  m_geometricController = GeometricController(wheelBase);
+  float const actuatorDelay =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-action-lateral.actuator-delay");
+  m_delayCompensator = DelayCompensator(wheelBase, actuatorDelay);
+  m_aimPointDeadline = a_configuration.getValue<float>(
+      "logic-cfsd18-action-lateral.aim-point-deadline");
+  m_mpcDeadline = a_configuration.getValue<double>(
+      "logic-cfsd18-action-lateral.mpc-deadline");
+
+  std::string const controller =
+    a_configuration.getValue<std::string>(
+      "logic-cfsd18-action-lateral.controller");
+  if (controller == "pure-pursuit") {
+    m_controllerMode = ControllerMode::PurePursuit;
+  } else if (controller == "stanley") {
+    m_controllerMode = ControllerMode::Stanley;
+  } else {
+    m_controllerMode = ControllerMode::ModelPredictive;
+  }
+  m_steeringLimit = a_configuration.getValue<float>(
+      "logic-cfsd18-action-lateral.max-steering");
+
+  if (isVerbose()) {
+    std::cout << "Using the " << controller << " controller, MPC horizon "
+      << ModelPredictiveController::HORIZON << " and sample time "
+      << sampleTime << " s, steering limited to "
+      << m_steeringLimit << " rad." << std::endl;
+  }
+
+  bool const isTimeTriggered = a_configuration.getValue<int32_t>(
+      "logic-cfsd18-action-lateral.time-triggered") == 1;
+  if (isTimeTriggered) {
+    float const frequency = a_configuration.getValue<float>(
+        "logic-cfsd18-action-lateral.control-frequency");
+    m_controlLoop.start(frequency, [this]() { step(); });
+    if (isVerbose()) {
+      std::cout << "Running time-triggered at " << frequency << " Hz."
+        << std::endl;
+    }
+  }
 }
 
 void Lateral::tearDown()
 {
+  if (m_controlLoop.isRunning()) {
+    m_controlLoop.stop();
+    if (isVerbose()) {
+      std::cout << "Control loop: " << m_controlLoop.statistics() << "."
+        << std::endl;
+    }
+  }
+  if (isVerbose()) {
+    std::cout << "Stage trace: " << m_busPort.traceReport() << "."
+      << std::endl;
+  }
 }
 
 }
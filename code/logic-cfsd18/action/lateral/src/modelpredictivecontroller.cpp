@@ -0,0 +1,160 @@
+/**
+* Copyright (C) 2017 Chalmers Revere
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+* USA.
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include "modelpredictivecontroller.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace action {
+
+int32_t const ModelPredictiveController::HORIZON;
+
+ModelPredictiveController::ModelPredictiveController(float a_wheelBase,
+    float a_sampleTime, float a_lateralWeight, float a_headingWeight,
+    float a_steeringWeight, float a_steeringRateWeight) :
+  m_wheelBase(a_wheelBase),
+  m_sampleTime(a_sampleTime),
+  m_lateralWeight(a_lateralWeight),
+  m_headingWeight(a_headingWeight),
+  m_steeringWeight(a_steeringWeight),
+  m_steeringRateWeight(a_steeringRateWeight),
+  m_previousSteering(0.0f),
+  m_iterations(0),
+  m_freeResponse(FreeResponse::Zero()),
+  m_forcedResponse(ForcedResponse::Zero()),
+  m_z(InputSequence::Zero()),
+  m_w(InputSequence::Zero())
+{
+}
+
+ModelPredictiveController::~ModelPredictiveController()
+{
+}
+
+/**
+ * Returns the steering angle to apply now, given the lateral error [m] and
+ * heading error [rad] to the reference line, the ground speed [m/s] and the
+ * steering limit [rad].
+ */
+float ModelPredictiveController::solve(float a_lateralError,
+    float a_headingError, float a_groundSpeed, float a_steeringLimit)
+{
+  uint32_t const maxIterations = 50;
+  float const tolerance = 1e-4f;
+
+  predict(std::max(a_groundSpeed, 0.1f));
+
+  Eigen::Vector2f const initialState(a_lateralError, a_headingError);
+  Eigen::Matrix<float, 2 * HORIZON, 1> stateWeights;
+  for (int32_t k = 0; k < HORIZON; k++) {
+    stateWeights(2 * k) = m_lateralWeight;
+    stateWeights(2 * k + 1) = m_headingWeight;
+  }
+
+  // Condensed cost 1/2 u'Hu + f'u, where the steering rate term couples
+  // neighbouring inputs and the first input to the previously applied one.
+  Hessian hessian = m_forcedResponse.transpose()
+    * stateWeights.asDiagonal() * m_forcedResponse;
+  InputSequence gradient = m_forcedResponse.transpose()
+    * stateWeights.asDiagonal() * (m_freeResponse * initialState);
+  for (int32_t k = 0; k < HORIZON; k++) {
+    hessian(k, k) += m_steeringWeight + 2.0f * m_steeringRateWeight;
+    if (k > 0) {
+      hessian(k, k - 1) -= m_steeringRateWeight;
+      hessian(k - 1, k) -= m_steeringRateWeight;
+    }
+  }
+  hessian(HORIZON - 1, HORIZON - 1) -= m_steeringRateWeight;
+  gradient(0) -= m_steeringRateWeight * m_previousSteering;
+
+  float const rho = hessian.trace() / static_cast<float>(HORIZON);
+  Eigen::LLT<Hessian> const factorisation(
+      hessian + rho * Hessian::Identity());
+
+  // Warm start from the previous solution, shifted one sample.
+  m_z.head<HORIZON - 1>() = m_z.tail<HORIZON - 1>().eval();
+  m_w.head<HORIZON - 1>() = m_w.tail<HORIZON - 1>().eval();
+
+  InputSequence u = m_z;
+  uint32_t i = 0;
+  while (i < maxIterations) {
+    u = factorisation.solve(rho * (m_z - m_w) - gradient);
+    InputSequence const previousZ = m_z;
+    m_z = (u + m_w).cwiseMax(-a_steeringLimit).cwiseMin(a_steeringLimit);
+    m_w += u - m_z;
+    i++;
+
+    float const primalResidual = (u - m_z).lpNorm<Eigen::Infinity>();
+    float const dualResidual = rho * (m_z - previousZ).lpNorm<Eigen::Infinity>();
+    if (primalResidual < tolerance && dualResidual < tolerance) {
+      break;
+    }
+  }
+  m_iterations = i;
+  m_previousSteering = m_z(0);
+  return m_previousSteering;
+}
+
+ModelPredictiveController::InputSequence const &ModelPredictiveController::solution() const
+{
+  return m_z;
+}
+
+uint32_t ModelPredictiveController::iterations() const
+{
+  return m_iterations;
+}
+
+/**
+ * Builds the condensed prediction X = Phi x0 + Gamma U of the discretised
+ * model
+ *
+ *   e_y(k+1)   = e_y(k) + v T e_psi(k)
+ *   e_psi(k+1) = e_psi(k) + v T / L delta(k)
+ */
+void ModelPredictiveController::predict(float a_groundSpeed)
+{
+  Eigen::Matrix2f a;
+  a << 1.0f, a_groundSpeed * m_sampleTime,
+       0.0f, 1.0f;
+  Eigen::Vector2f const b(0.0f, a_groundSpeed * m_sampleTime / m_wheelBase);
+
+  Eigen::Matrix2f power = a;
+  m_forcedResponse.setZero();
+  for (int32_t k = 0; k < HORIZON; k++) {
+    m_freeResponse.block<2, 2>(2 * k, 0) = power;
+    power = a * power;
+  }
+  for (int32_t k = 0; k < HORIZON; k++) {
+    Eigen::Vector2f response = b;
+    for (int32_t j = k; j < HORIZON; j++) {
+      m_forcedResponse.block<2, 1>(2 * j, k) = response;
+      response = a * response;
+    }
+  }
+}
+
+}
+}
+}
+}
@@ -21,7 +21,13 @@
 
 #include "cxxtest/TestSuite.h"
 
+#include "benchmark.hpp"
+#include "inprocessbus.hpp"
+
+#include "../include/delaycompensator.hpp"
+#include "../include/geometriccontroller.hpp"
 #include "../include/lateral.hpp"
+#include "../include/modelpredictivecontroller.hpp"
 
 class LateralTest : public CxxTest::TestSuite {
   public:
@@ -37,6 +43,180 @@ class LateralTest : public CxxTest::TestSuite {
     {
       TS_ASSERT(true);
     }
+
+    void testMpcKeepsZeroErrorAtZeroSteering()
+    {
+      opendlv::logic::cfsd18::action::ModelPredictiveController mpc(1.53f,
+          0.02f, 1.0f, 1.0f, 0.1f, 1.0f);
+      TS_ASSERT_DELTA(mpc.solve(0.0f, 0.0f, 10.0f, 0.4f), 0.0f, 1e-5f);
+    }
+
+    void testMpcSteersTowardsReferenceWithinLimit()
+    {
+      float const steeringLimit = 0.05f;
+      opendlv::logic::cfsd18::action::ModelPredictiveController mpc(1.53f,
+          0.02f, 1.0f, 10.0f, 0.01f, 0.01f);
+      float const steering = mpc.solve(0.0f, -0.5f, 10.0f, steeringLimit);
+      TS_ASSERT_LESS_THAN(0.0f, steering);
+      TS_ASSERT_LESS_THAN_EQUALS(steering, steeringLimit + 1e-5f);
+      TS_ASSERT_LESS_THAN_EQUALS(mpc.iterations(), 50u);
+    }
+
+    void testMpcMatchesUnconstrainedOptimum()
+    {
+      opendlv::logic::cfsd18::action::ModelPredictiveController mpc(1.53f,
+          0.02f, 1.0f, 1.0f, 0.1f, 0.0f);
+      float const first = mpc.solve(0.0f, -0.01f, 5.0f, 10.0f);
+      for (uint32_t i = 0; i < 5; i++) {
+        mpc.solve(0.0f, -0.01f, 5.0f, 10.0f);
+      }
+      float const warmStarted = mpc.solve(0.0f, -0.01f, 5.0f, 10.0f);
+      TS_ASSERT_DELTA(first, warmStarted, 1e-3f);
+      TS_ASSERT_LESS_THAN(0.0f, warmStarted);
+
+      // Without a binding limit the QP has the closed form -H^-1 f, with the
+      // prediction built here by stepping the bicycle model.
+      int32_t const horizon =
+        opendlv::logic::cfsd18::action::ModelPredictiveController::HORIZON;
+      Eigen::Matrix2f a;
+      a << 1.0f, 5.0f * 0.02f,
+           0.0f, 1.0f;
+      Eigen::Vector2f const b(0.0f, 5.0f * 0.02f / 1.53f);
+      Eigen::MatrixXf freeResponse(2 * horizon, 2);
+      Eigen::MatrixXf forcedResponse = Eigen::MatrixXf::Zero(2 * horizon,
+          horizon);
+      Eigen::Matrix2f power = a;
+      for (int32_t k = 0; k < horizon; k++) {
+        freeResponse.block(2 * k, 0, 2, 2) = power;
+        power = a * power;
+        Eigen::Vector2f response = b;
+        for (int32_t j = k; j < horizon; j++) {
+          forcedResponse.block(2 * j, k, 2, 1) = response;
+          response = a * response;
+        }
+      }
+      Eigen::MatrixXf const hessian = forcedResponse.transpose()
+        * forcedResponse + 0.1f * Eigen::MatrixXf::Identity(horizon, horizon);
+      Eigen::VectorXf const gradient = forcedResponse.transpose()
+        * freeResponse * Eigen::Vector2f(0.0f, -0.01f);
+      Eigen::VectorXf const optimum = -hessian.ldlt().solve(gradient);
+      TS_ASSERT_DELTA(warmStarted, optimum(0), 1e-3f);
+      TS_ASSERT_LESS_THAN(
+          (mpc.solution() - optimum).lpNorm<Eigen::Infinity>(), 1e-3f);
+    }
+
+    void testGeometricControllersSteerTowardsAimPoint()
+    {
+      opendlv::logic::cfsd18::action::GeometricController controller(1.53f);
+      TS_ASSERT_DELTA(controller.purePursuit(0.0f, 5.0f, 10.0f), 0.0f, 1e-6f);
+      TS_ASSERT_DELTA(controller.stanley(0.0f, 5.0f, 10.0f), 0.0f, 1e-6f);
+      TS_ASSERT_LESS_THAN(0.0f, controller.purePursuit(0.2f, 5.0f, 10.0f));
+      TS_ASSERT_LESS_THAN(controller.stanley(-0.2f, 5.0f, 10.0f), 0.0f);
+      TS_ASSERT_LESS_THAN(controller.purePursuit(0.2f, 5.0f, 20.0f),
+          controller.purePursuit(0.2f, 5.0f, 5.0f));
+    }
+
+    void testDelayCompensationOnStraight()
+    {
+      opendlv::logic::cfsd18::action::DelayCompensator compensator(1.53f,
+          0.1f);
+      opendlv::logic::action::AimPoint aimPoint(0.0f, 0.0f, 10.0f);
+      auto predicted = compensator.predict(aimPoint, 10.0f, 0.0f, 0.1f);
+      TS_ASSERT_DELTA(predicted.getDistance(), 8.0f, 1e-4f);
+      TS_ASSERT_DELTA(predicted.getAzimuthAngle(), 0.0f, 1e-5f);
+    }
+
+    void testDelayCompensationWhileTurning()
+    {
+      // Turning left moves an aim point straight ahead to the right.
+      opendlv::logic::cfsd18::action::DelayCompensator compensator(1.53f,
+          0.05f);
+      opendlv::logic::action::AimPoint aimPoint(0.0f, 0.0f, 10.0f);
+      auto predicted = compensator.predict(aimPoint, 10.0f, 0.2f, 0.05f);
+      TS_ASSERT_LESS_THAN(predicted.getAzimuthAngle(), 0.0f);
+      TS_ASSERT_LESS_THAN(predicted.getDistance(), 10.0f);
+    }
+
+    void testAimPointDeadlineCountsOnlyTheLastHop()
+    {
+      opendlv::logic::cfsd18::common::InProcessBus bus(
+          opendlv::logic::cfsd18::common::Delivery::Direct,
+          opendlv::logic::cfsd18::common::Mirroring::None);
+      float steering = 0.0f;
+      bus.subscribe([&steering](odcore::data::Container &a_container) {
+          if (a_container.getDataType()
+              == opendlv::proxy::GroundSteeringRequest::ID()) {
+            steering = a_container.getData<
+              opendlv::proxy::GroundSteeringRequest>().getGroundSteering();
+          }
+        });
+      auto lateral = opendlv::logic::cfsd18::common::createMicroservice<
+        opendlv::logic::cfsd18::action::Lateral>(bus);
+
+      odcore::data::Container groundSpeed(
+          opendlv::proxy::GroundSpeedReading(5.0f));
+      lateral->nextContainer(groundSpeed);
+
+      // An origin older than the deadline only means that the pipeline
+      // upstream was slow, the aim point itself was just sent.
+      odcore::data::TimeStamp const now;
+      odcore::data::TimeStamp const secondAgo(now.getSeconds() - 1,
+          now.getFractionalMicroseconds());
+      odcore::data::Container left(
+          opendlv::logic::action::AimPoint(0.2f, 0.0f, 6.0f));
+      left.setSampleTimeStamp(secondAgo);
+      left.setSentTimeStamp(now);
+      lateral->nextContainer(left);
+      float const steeringLeft = steering;
+      TS_ASSERT_LESS_THAN(0.0f, steeringLeft);
+
+      // An aim point that was sent a second ago is stale and not steered on.
+      odcore::data::Container right(
+          opendlv::logic::action::AimPoint(-0.2f, 0.0f, 6.0f));
+      right.setSampleTimeStamp(secondAgo);
+      right.setSentTimeStamp(secondAgo);
+      lateral->nextContainer(right);
+      TS_ASSERT_EQUALS(steering, steeringLeft);
+    }
+
+    void testDelayCompensationCoversThePipelineFromTheOrigin()
+    {
+      // The same aim point, sent just now, once with a fresh origin and once
+      // with an origin from upstream stages that took 0.3 s. The car keeps
+      // driving for those 0.3 s, so the second aim point is predicted to be
+      // further to the side and is steered on harder.
+      auto steeringOn = [](odcore::data::TimeStamp const &a_origin) {
+        opendlv::logic::cfsd18::common::InProcessBus bus(
+            opendlv::logic::cfsd18::common::Delivery::Direct,
+            opendlv::logic::cfsd18::common::Mirroring::None);
+        odcore::data::TimeStamp const now(100, 0);
+        bus.clock().simulate(now);
+        float steering = 0.0f;
+        bus.subscribe([&steering](odcore::data::Container &a_container) {
+            if (a_container.getDataType()
+                == opendlv::proxy::GroundSteeringRequest::ID()) {
+              steering = a_container.getData<
+                opendlv::proxy::GroundSteeringRequest>().getGroundSteering();
+            }
+          });
+        auto lateral = opendlv::logic::cfsd18::common::createMicroservice<
+          opendlv::logic::cfsd18::action::Lateral>(bus);
+        odcore::data::Container groundSpeed(
+            opendlv::proxy::GroundSpeedReading(5.0f));
+        lateral->nextContainer(groundSpeed);
+
+        odcore::data::Container aimPoint(
+            opendlv::logic::action::AimPoint(0.2f, 0.0f, 6.0f));
+        aimPoint.setSampleTimeStamp(a_origin);
+        aimPoint.setSentTimeStamp(now);
+        lateral->nextContainer(aimPoint);
+        return steering;
+      };
+      float const fresh = steeringOn(odcore::data::TimeStamp(100, 0));
+      float const late = steeringOn(odcore::data::TimeStamp(99, 700000));
+      TS_ASSERT_LESS_THAN(0.0f, fresh);
+      TS_ASSERT_LESS_THAN(fresh + 0.01f, late);
+    }
 };
 
 #endif
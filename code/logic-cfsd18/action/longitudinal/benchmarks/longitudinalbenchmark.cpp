@@ -0,0 +1,122 @@
+/**
+* Copyright (C) 2017 Chalmers Revere
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+* USA.
+*/
+
+#include <vector>
+
+#include <odvdcfsd18/GeneratedHeaders_ODVDcfsd18.h>
+
+#include "benchmark.hpp"
+#include "inprocessbus.hpp"
+#include "longitudinal.hpp"
+#include "previewcontroller.hpp"
+#include "speedcontroller.hpp"
+#include "tractionlimiter.hpp"
+
+namespace {
+
+using opendlv::logic::cfsd18::common::BenchmarkState;
+using opendlv::logic::cfsd18::common::InProcessBus;
+using opendlv::logic::cfsd18::common::doNotOptimize;
+
+void stepSpeedController(BenchmarkState &a_state)
+{
+  opendlv::logic::cfsd18::action::SpeedController controller(1.0f, 0.2f, 10.0f,
+      5.0f, 10.0f);
+  float groundSpeed = 5.0f;
+  while (a_state.keepRunning()) {
+    float const acceleration = controller.step(10.0f, 0.0f, groundSpeed, 0.01f);
+    doNotOptimize(acceleration);
+    groundSpeed = (groundSpeed < 15.0f) ? groundSpeed + 0.01f : 5.0f;
+  }
+}
+
+void previewAcceleration(BenchmarkState &a_state)
+{
+  opendlv::logic::cfsd18::action::PreviewController controller(15.0f, 0.2f,
+      10.0f, 25.0f);
+  while (a_state.keepRunning()) {
+    float const targetSpeed = controller.targetSpeed(0.3f, 15.0f);
+    float const acceleration = controller.acceleration(targetSpeed, 15.0f,
+        12.0f);
+    doNotOptimize(acceleration);
+  }
+}
+
+void limitTraction(BenchmarkState &a_state)
+{
+  opendlv::logic::cfsd18::action::TractionLimiter limiter(1.0f, 0.1f, 5.0f);
+  float wheelSpeed = 5.0f;
+  while (a_state.keepRunning()) {
+    limiter.update(wheelSpeed, 0.01f);
+    float const acceleration = limiter.limit(8.0f);
+    doNotOptimize(acceleration);
+    wheelSpeed = (wheelSpeed < 15.0f) ? wheelSpeed + 0.01f : 5.0f;
+  }
+}
+
+/**
+ * Every aim point triggers a control step and an acceleration request.
+ */
+void controlAimPoints(BenchmarkState &a_state,
+    std::vector<odcore::data::Container> &a_aimPoints)
+{
+  InProcessBus bus(opendlv::logic::cfsd18::common::Delivery::Direct,
+      opendlv::logic::cfsd18::common::Mirroring::None);
+  auto longitudinal = opendlv::logic::cfsd18::common::createMicroservice<
+    opendlv::logic::cfsd18::action::Longitudinal>(bus);
+  opendlv::logic::cognition::GroundSpeedLimit groundSpeedLimit(10.0f);
+  odcore::data::Container speedLimit(groundSpeedLimit);
+  longitudinal->nextContainer(speedLimit);
+
+  uint64_t i = 0;
+  while (a_state.keepRunning()) {
+    longitudinal->nextContainer(a_aimPoints[i++ % a_aimPoints.size()]);
+  }
+  a_state.setItemsProcessed(a_state.iterations());
+}
+
+void controlSyntheticAimPoints(BenchmarkState &a_state)
+{
+  opendlv::logic::action::AimPoint aimPoint(0.1f, 0.0f, 6.0f);
+  std::vector<odcore::data::Container> containers(1,
+      odcore::data::Container(aimPoint));
+  controlAimPoints(a_state, containers);
+}
+
+void controlRecordedAimPoints(BenchmarkState &a_state)
+{
+  std::vector<odcore::data::Container> containers =
+    opendlv::logic::cfsd18::common::Benchmarks::instance().recorded(
+        opendlv::logic::action::AimPoint::ID());
+  if (containers.empty()) {
+    a_state.skip("No recorded aim points.");
+    return;
+  }
+  controlAimPoints(a_state, containers);
+}
+
+CFSD18_BENCHMARK(stepSpeedController);
+CFSD18_BENCHMARK(previewAcceleration);
+CFSD18_BENCHMARK(limitTraction);
+CFSD18_BENCHMARK(controlSyntheticAimPoints);
+CFSD18_BENCHMARK(controlRecordedAimPoints);
+
+}
+
+CFSD18_BENCHMARK_MAIN()
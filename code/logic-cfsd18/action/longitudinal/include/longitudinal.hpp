@@ -20,12 +20,23 @@
 #ifndef OPENDLV_LOGIC_CFSD18_ACTION_LONGITUDINAL_HPP
 #define OPENDLV_LOGIC_CFSD18_ACTION_LONGITUDINAL_HPP
 
+#include <opendavinci/odcore/base/KeyValueConfiguration.h>
 #include <opendavinci/odcore/base/module/DataTriggeredConferenceClientModule.h>
 #include <opendavinci/odcore/data/Container.h>
+#include <opendavinci/odcore/data/TimeStamp.h>
 
 //#include <odvdopendlvstandardmessageset/GeneratedHeaders_ODVDOpenDLVStandardMessageSet.h>
 #include <odvdcfsd18/GeneratedHeaders_ODVDcfsd18.h>
 
+#include "busport.hpp"
+#include "dispatcher.hpp"
+#include "fixedrateloop.hpp"
+#include "mailbox.hpp"
+
+#include "previewcontroller.hpp"
+#include "speedcontroller.hpp"
+#include "tractionlimiter.hpp"
+
 namespace opendlv {
 namespace logic {
 namespace cfsd18 {
@@ -38,10 +49,45 @@ class Longitudinal : public odcore::base::module::DataTriggeredConferenceClientM
   Longitudinal &operator=(Longitudinal const &) = delete;
   virtual ~Longitudinal();
   virtual void nextContainer(odcore::data::Container &);
+  void attachBus(common::InProcessBus &);
+  void setUp(odcore::base::KeyValueConfiguration const &);
 
  private:
   void setUp();
   void tearDown();
+  void process(odcore::data::Container &);
+  void step();
+  void control(double);
+  void sendRequest(float);
+  void send(odcore::data::Container);
+  void receive(odcore::data::Container &);
+  void onGroundSpeedLimit(opendlv::logic::cognition::GroundSpeedLimit const &,
+      odcore::data::Container &);
+  void onGroundSpeedReading(opendlv::proxy::GroundSpeedReading const &,
+      odcore::data::Container &);
+  void onPreviewPoint(opendlv::logic::action::PreviewPoint const &,
+      odcore::data::Container &);
+  void onAimPoint(odcore::data::Container &);
+
+  common::BusPort m_busPort;
+  common::Dispatcher<Longitudinal> m_dispatcher;
+  SpeedController m_speedController;
+  TractionLimiter m_tractionLimiter;
+  PreviewController m_previewController;
+  float m_speedLimit;
+  float m_referenceAcceleration;
+  float m_previewSpeed;
+  float m_previewDistance;
+  double m_speedLimitTime;
+  double m_previewTime;
+  double m_groundSpeedTime;
+  double m_controlTime;
+  bool m_isAccelerating;
+  odcore::data::TimeStamp m_origin;
+  common::Mailbox<odcore::data::Container> m_speedLimitInput;
+  common::Mailbox<odcore::data::Container> m_groundSpeedInput;
+  common::Mailbox<odcore::data::Container> m_previewPointInput;
+  common::FixedRateLoop m_controlLoop;
 };
 
 }
@@ -0,0 +1,63 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_ACTION_PREVIEWCONTROLLER_HPP
+#define OPENDLV_LOGIC_CFSD18_ACTION_PREVIEWCONTROLLER_HPP
+
+#include <cstdint>
+
+#include "gainschedule.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace action {
+
+/**
+ * Speed preview from the path ahead. The target speed at a preview point
+ * follows from the curvature of the arc through it and the lateral
+ * acceleration limit, and the constant acceleration that reaches it at the
+ * preview point is scaled by a gain tabulated over ground speed. The gain
+ * makes up for the distance covered while the actuators respond, and is
+ * computed once for the speed grid so that a control step is only a lookup.
+ */
+class PreviewController {
+ public:
+  static uint32_t const SPEED_STEPS = 32;
+
+  PreviewController(float, float, float, float);
+  PreviewController(PreviewController const &) = default;
+  PreviewController &operator=(PreviewController const &) = default;
+  virtual ~PreviewController();
+
+  float targetSpeed(float, float) const;
+  float acceleration(float, float, float) const;
+
+ private:
+  float m_maxLateralAcceleration;
+  float m_maxSpeed;
+  common::GainSchedule<SPEED_STEPS> m_gains;
+};
+
+}
+}
+}
+}
+
+#endif
@@ -0,0 +1,58 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_ACTION_SPEEDCONTROLLER_HPP
+#define OPENDLV_LOGIC_CFSD18_ACTION_SPEEDCONTROLLER_HPP
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace action {
+
+/**
+ * Speed controller with feedforward of the reference acceleration and a PI
+ * term on the speed error. The output is saturated to the acceleration and
+ * deceleration limits, and the integrator is kept from winding up by feeding
+ * back the saturation error.
+ */
+class SpeedController {
+ public:
+  SpeedController(float, float, float, float, float);
+  SpeedController(SpeedController const &) = default;
+  SpeedController &operator=(SpeedController const &) = default;
+  virtual ~SpeedController();
+
+  float step(float, float, float, float);
+  void reset();
+
+ private:
+  float m_proportionalGain;
+  float m_integralGain;
+  float m_antiWindupGain;
+  float m_maxAcceleration;
+  float m_maxDeceleration;
+  float m_integral;
+};
+
+}
+}
+}
+}
+
+#endif
@@ -0,0 +1,60 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_ACTION_TRACTIONLIMITER_HPP
+#define OPENDLV_LOGIC_CFSD18_ACTION_TRACTIONLIMITER_HPP
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace action {
+
+/**
+ * Slip-ratio traction limiter. The ground speed reading comes from the
+ * wheels, so a vehicle reference speed is estimated by following it with the
+ * rate of change bounded by what the tyres can transfer, mu g. The slip ratio
+ * between wheel and reference speed then scales down acceleration (wheel
+ * spin) and deceleration (wheel lock) requests beyond the target slip.
+ */
+class TractionLimiter {
+ public:
+  TractionLimiter(float, float, float);
+  TractionLimiter(TractionLimiter const &) = default;
+  TractionLimiter &operator=(TractionLimiter const &) = default;
+  virtual ~TractionLimiter();
+
+  void update(float, float);
+  float limit(float) const;
+  float referenceSpeed() const;
+  float slipRatio() const;
+
+ private:
+  float m_friction;
+  float m_targetSlip;
+  float m_slipGain;
+  float m_referenceSpeed;
+  float m_slipRatio;
+};
+
+}
+}
+}
+}
+
+#endif
@@ -17,6 +17,7 @@
 * USA.
 */
 
+#include <algorithm>
 #include <iostream>
 
 #include <opendavinci/odcore/data/TimeStamp.h>
@@ -24,57 +25,320 @@
 #include <opendavinci/odcore/wrapper/Eigen.h>
 
 #include "longitudinal.hpp"
+#include "trace.hpp"
 
 namespace opendlv {
 namespace logic {
 namespace cfsd18 {
 namespace action {
 
+namespace {
+
+double toSeconds(odcore::data::TimeStamp const &a_timeStamp)
+{
+  return static_cast<double>(a_timeStamp.toMicroseconds()) / 1000000.0;
+}
+
+}
+
 Longitudinal::Longitudinal(int32_t const &a_argc, char **a_argv) :
-  DataTriggeredConferenceClientModule(a_argc, a_argv, "logic-cfsd18-action-longitudinal")
+  DataTriggeredConferenceClientModule(a_argc, a_argv, "logic-cfsd18-action-longitudinal"),
+  m_busPort([this](odcore::data::Container &a_container) { receive(a_container); },
+      [this](odcore::data::Container &a_container) { getConference().send(a_container); }),
+  m_dispatcher(),
+  m_speedController(1.0f, 0.2f, 10.0f, 5.0f, 10.0f),
+  m_tractionLimiter(1.0f, 0.1f, 5.0f),
+  m_previewController(15.0f, 0.2f, 10.0f, 25.0f),
+  m_speedLimit(0.0f),
+  m_referenceAcceleration(0.0f),
+  m_previewSpeed(0.0f),
+  m_previewDistance(0.0f),
+  m_speedLimitTime(0.0),
+  m_previewTime(0.0),
+  m_groundSpeedTime(0.0),
+  m_controlTime(0.0),
+  m_isAccelerating(true),
+  m_origin(),
+  m_speedLimitInput(),
+  m_groundSpeedInput(),
+  m_previewPointInput(),
+  m_controlLoop()
 {
+  m_dispatcher
+    .add<opendlv::logic::cognition::GroundSpeedLimit, &Longitudinal::onGroundSpeedLimit>()
+    .add<opendlv::proxy::GroundSpeedReading, &Longitudinal::onGroundSpeedReading>()
+    .add<opendlv::logic::action::PreviewPoint, &Longitudinal::onPreviewPoint>()
+    .add<opendlv::logic::action::AimPoint, &Longitudinal::onAimPoint>();
 }
 
 Longitudinal::~Longitudinal()
 {
 }
 
-
+void Longitudinal::attachBus(common::InProcessBus &a_bus)
+{
+  m_busPort.attach(a_bus);
+}
 
 void Longitudinal::nextContainer(odcore::data::Container &a_container)
 {
+  m_busPort.receive(a_container);
+}
+
+/**
+ * In the time-triggered mode, incoming data is only left in the mailboxes and
+ * the control loop does the work at its own pace.
+ */
+void Longitudinal::receive(odcore::data::Container &a_container)
+{
+  if (!m_controlLoop.isRunning()) {
+    process(a_container);
+    return;
+  }
+
   if (a_container.getDataType() == opendlv::logic::cognition::GroundSpeedLimit::ID()) {
-    // auto kinematicState = a_container.getData<opendlv::coord::KinematicState>();
+    m_speedLimitInput.post(a_container);
+  }
+  if (a_container.getDataType() == opendlv::proxy::GroundSpeedReading::ID()) {
+    m_groundSpeedInput.post(a_container);
   }
   if (a_container.getDataType() == opendlv::logic::action::PreviewPoint::ID()) {
-    // auto kinematicState = a_container.getData<opendlv::coord::KinematicState>();
+    m_previewPointInput.post(a_container);
+  }
+}
+
+void Longitudinal::process(odcore::data::Container &a_container)
+{
+  m_dispatcher.dispatch(*this, a_container);
+}
+
+/**
+ * The feedforward is the slope of the speed profile between updates.
+ */
+void Longitudinal::onGroundSpeedLimit(
+    opendlv::logic::cognition::GroundSpeedLimit const &a_groundSpeedLimit,
+    odcore::data::Container &a_container)
+{
+  double const time = toSeconds(a_container.getReceivedTimeStamp());
+  float const speedLimit = a_groundSpeedLimit.getSpeedLimit();
+  float const timeStep = static_cast<float>(time - m_speedLimitTime);
+  if (m_speedLimitTime > 0.0 && timeStep > 0.0f) {
+    m_referenceAcceleration = (speedLimit - m_speedLimit) / timeStep;
+  }
+  m_speedLimit = speedLimit;
+  m_speedLimitTime = time;
+  m_origin = common::originOf(a_container);
+}
+
+void Longitudinal::onGroundSpeedReading(
+    opendlv::proxy::GroundSpeedReading const &a_groundSpeedReading,
+    odcore::data::Container &a_container)
+{
+  double const time = toSeconds(a_container.getReceivedTimeStamp());
+  float const timeStep = (m_groundSpeedTime > 0.0)
+    ? static_cast<float>(time - m_groundSpeedTime) : 0.0f;
+  m_tractionLimiter.update(a_groundSpeedReading.getGroundSpeed(), timeStep);
+  m_groundSpeedTime = time;
+}
+
+void Longitudinal::onPreviewPoint(
+    opendlv::logic::action::PreviewPoint const &a_previewPoint,
+    odcore::data::Container &a_container)
+{
+  m_previewSpeed = m_previewController.targetSpeed(
+      a_previewPoint.getAzimuthAngle(), a_previewPoint.getDistance());
+  m_previewDistance = a_previewPoint.getDistance();
+  m_previewTime = toSeconds(a_container.getReceivedTimeStamp());
+}
+
+/**
+ * Aim points only trigger the control step, so they are not deserialised.
+ */
+void Longitudinal::onAimPoint(odcore::data::Container &a_container)
+{
+  m_origin = common::originOf(a_container);
+  control(toSeconds(a_container.getReceivedTimeStamp()));
+}
+
+/**
+ * One iteration of the time-triggered control loop, where the loop rather
+ * than the aim points sets the control rate.
+ */
+void Longitudinal::step()
+{
+  odcore::data::Container container;
+  if (m_speedLimitInput.take(container)) {
+    process(container);
   }
-  if (a_container.getDataType() == opendlv::logic::action::AimPoint::ID()) {
-    // auto kinematicState = a_container.getData<opendlv::coord::KinematicState>();
+  if (m_groundSpeedInput.take(container)) {
+    process(container);
+  }
+  if (m_previewPointInput.take(container)) {
+    process(container);
+  }
+  control(toSeconds(m_busPort.now()));
+}
 
-    opendlv::proxy::GroundAccelerationRequest o1;
-    odcore::data::Container c1(o1);
-    getConference().send(c1);
+/**
+ * While a recent preview point is known, the acceleration that reaches its
+ * target speed replaces the slope of the speed limit as feedforward. The
+ * target speed never exceeds the speed limit, which on a straight is below
+ * the highest speed of the preview. When it asks for braking, it also bounds
+ * the command, so that braking for a corner starts before the speed limit
+ * drops.
+ */
+void Longitudinal::control(double a_time)
+{
+  double const previewTimeout = 0.5;
+
+  float const timeStep = (m_controlTime > 0.0)
+    ? static_cast<float>(a_time - m_controlTime) : 0.0f;
+  m_controlTime = a_time;
+
+  float const groundSpeed = m_tractionLimiter.referenceSpeed();
+  bool const hasPreview = m_previewTime > 0.0
+    && a_time - m_previewTime < previewTimeout;
+  float const previewAcceleration = hasPreview
+    ? m_previewController.acceleration(std::min(m_previewSpeed, m_speedLimit),
+        m_previewDistance, groundSpeed) : 0.0f;
+
+  float acceleration = m_speedController.step(m_speedLimit,
+      hasPreview ? previewAcceleration : m_referenceAcceleration, groundSpeed,
+      timeStep);
+  if (hasPreview && previewAcceleration < 0.0f) {
+    acceleration = std::min(acceleration, previewAcceleration);
+  }
+  sendRequest(m_tractionLimiter.limit(acceleration));
+}
+
+/**
+ * Sends either an acceleration or a deceleration request. When the sign of
+ * the request changes, the request that is no longer active is released with
+ * a final zero.
+ */
+void Longitudinal::sendRequest(float a_acceleration)
+{
+  bool const isAccelerating = a_acceleration >= 0.0f;
+  if (isAccelerating != m_isAccelerating) {
+    if (m_isAccelerating) {
+      opendlv::proxy::GroundAccelerationRequest o1(0.0f);
+      send(odcore::data::Container(o1));
+    } else {
+      opendlv::proxy::GroundDecelerationRequest o2(0.0f);
+      send(odcore::data::Container(o2));
+    }
+    m_isAccelerating = isAccelerating;
+  }
 
-    opendlv::proxy::GroundDecelerationRequest o2;
-    odcore::data::Container c2(o2);
-    getConference().send(c2);
+  if (isAccelerating) {
+    opendlv::proxy::GroundAccelerationRequest o1(a_acceleration);
+    send(odcore::data::Container(o1));
+  } else {
+    opendlv::proxy::GroundDecelerationRequest o2(-a_acceleration);
+    send(odcore::data::Container(o2));
   }
 }
 
+/**
+ * Requests inherit the origin of the latest aim point or speed limit, which
+ * the planner sends together.
+ */
+void Longitudinal::send(odcore::data::Container a_container)
+{
+  a_container.setSampleTimeStamp(m_origin);
+  m_busPort.send(a_container);
+}
+
 void Longitudinal::setUp()
 {
-  // std::string const exampleConfig = 
-  //   getKeyValueConfiguration().getValue<std::string>(
-  //     "logic-cfsd18-action-longitudinal.example-config");
+  setUp(getKeyValueConfiguration());
+}
+
+void Longitudinal::setUp(
+    odcore::base::KeyValueConfiguration const &a_configuration)
+{
+  float const statisticsPeriod =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-action-longitudinal.statistics-period");
+  m_busPort.publishStatistics(getName(), statisticsPeriod);
 
-  // if (isVerbose()) {
-  //   std::cout << "Example config is " << exampleConfig << std::endl;
-  // }
+  float const proportionalGain =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-action-longitudinal.proportional-gain");
+  float const integralGain =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-action-longitudinal.integral-gain");
+  float const antiWindupGain =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-action-longitudinal.anti-windup-gain");
+  float const maxAcceleration =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-action-longitudinal.max-acceleration");
+  float const maxDeceleration =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-action-longitudinal.max-deceleration");
+  m_speedController = SpeedController(proportionalGain, integralGain,
+      antiWindupGain, maxAcceleration, maxDeceleration);
+
+  float const friction =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-action-longitudinal.friction");
+  float const targetSlip =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-action-longitudinal.target-slip");
+  float const slipGain =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-action-longitudinal.slip-gain");
+  m_tractionLimiter = TractionLimiter(friction, targetSlip, slipGain);
+
+  float const previewDistance =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-action-longitudinal.preview-distance");
+  float const actuatorLag =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-action-longitudinal.actuator-lag");
+  float const maxLateralAcceleration =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-action-longitudinal.max-lateral-acceleration");
+  float const maxSpeed =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-action-longitudinal.max-speed");
+  m_previewController = PreviewController(previewDistance, actuatorLag,
+      maxLateralAcceleration, maxSpeed);
+
+  if (isVerbose()) {
+    std::cout << "Speed control with Kp " << proportionalGain << ", Ki "
+      << integralGain << ", acceleration within [" << -maxDeceleration
+      << ", " << maxAcceleration << "] m/s^2 and target slip " << targetSlip
+      << "." << std::endl;
+  }
+
+  bool const isTimeTriggered = a_configuration.getValue<int32_t>(
+      "logic-cfsd18-action-longitudinal.time-triggered") == 1;
+  if (isTimeTriggered) {
+    float const frequency = a_configuration.getValue<float>(
+        "logic-cfsd18-action-longitudinal.control-frequency");
+    m_controlLoop.start(frequency, [this]() { step(); });
+    if (isVerbose()) {
+      std::cout << "Running time-triggered at " << frequency << " Hz."
+        << std::endl;
+    }
+  }
 }
 
 void Longitudinal::tearDown()
 {
+  if (m_controlLoop.isRunning()) {
+    m_controlLoop.stop();
+    if (isVerbose()) {
+      std::cout << "Control loop: " << m_controlLoop.statistics() << "."
+        << std::endl;
+    }
+  }
+  if (isVerbose()) {
+    std::cout << "Stage trace: " << m_busPort.traceReport() << "."
+      << std::endl;
+  }
 }
 
 }
@@ -0,0 +1,85 @@
+/**
+* Copyright (C) 2017 Chalmers Revere
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+* USA.
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include "previewcontroller.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace action {
+
+/**
+ * The gain for each speed v is d / (d - v tau) for the nominal preview
+ * distance d [m] and actuator lag tau [s], with the remaining distance never
+ * taken as less than half of d.
+ */
+PreviewController::PreviewController(float a_previewDistance,
+    float a_actuatorLag, float a_maxLateralAcceleration, float a_maxSpeed) :
+  m_maxLateralAcceleration(a_maxLateralAcceleration),
+  m_maxSpeed(a_maxSpeed),
+  m_gains{a_maxSpeed / static_cast<float>(SPEED_STEPS - 1), {}}
+{
+  for (uint32_t i = 0; i < SPEED_STEPS; i++) {
+    float const speed = m_gains.speedStep * static_cast<float>(i);
+    float const remainingDistance = std::max(
+        a_previewDistance - speed * a_actuatorLag, 0.5f * a_previewDistance);
+    m_gains.gains[i] = a_previewDistance / remainingDistance;
+  }
+}
+
+PreviewController::~PreviewController()
+{
+}
+
+/**
+ * Highest speed [m/s] at a preview point given by its azimuth angle [rad] and
+ * distance [m]. The arc from the car through the point has the curvature
+ * 2 sin(azimuth) / distance.
+ */
+float PreviewController::targetSpeed(float a_azimuthAngle,
+    float a_distance) const
+{
+  float const curvature = std::abs(2.0f * std::sin(a_azimuthAngle)
+      / std::max(a_distance, 0.1f));
+  if (curvature * m_maxSpeed * m_maxSpeed < m_maxLateralAcceleration) {
+    return m_maxSpeed;
+  }
+  return std::sqrt(m_maxLateralAcceleration / curvature);
+}
+
+/**
+ * Acceleration [m/s^2] that changes the current ground speed [m/s] into the
+ * target speed [m/s] over the preview distance [m].
+ */
+float PreviewController::acceleration(float a_targetSpeed, float a_distance,
+    float a_groundSpeed) const
+{
+  float const requiredAcceleration =
+    (a_targetSpeed * a_targetSpeed - a_groundSpeed * a_groundSpeed)
+    / (2.0f * std::max(a_distance, 0.1f));
+  return m_gains.at(a_groundSpeed) * requiredAcceleration;
+}
+
+}
+}
+}
+}
@@ -0,0 +1,72 @@
+/**
+* Copyright (C) 2017 Chalmers Revere
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+* USA.
+*/
+
+#include <algorithm>
+
+#include "speedcontroller.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace action {
+
+SpeedController::SpeedController(float a_proportionalGain,
+    float a_integralGain, float a_antiWindupGain, float a_maxAcceleration,
+    float a_maxDeceleration) :
+  m_proportionalGain(a_proportionalGain),
+  m_integralGain(a_integralGain),
+  m_antiWindupGain(a_antiWindupGain),
+  m_maxAcceleration(a_maxAcceleration),
+  m_maxDeceleration(a_maxDeceleration),
+  m_integral(0.0f)
+{
+}
+
+SpeedController::~SpeedController()
+{
+}
+
+/**
+ * Returns the requested acceleration [m/s^2], negative when braking, given
+ * the reference speed [m/s] and acceleration [m/s^2], the current speed
+ * [m/s] and the time step [s].
+ */
+float SpeedController::step(float a_referenceSpeed,
+    float a_referenceAcceleration, float a_speed, float a_timeStep)
+{
+  float const error = a_referenceSpeed - a_speed;
+  float const unsaturated = a_referenceAcceleration
+    + m_proportionalGain * error + m_integralGain * m_integral;
+  float const saturated = std::min(std::max(unsaturated, -m_maxDeceleration),
+      m_maxAcceleration);
+
+  m_integral += a_timeStep
+    * (error + m_antiWindupGain * (saturated - unsaturated));
+  return saturated;
+}
+
+void SpeedController::reset()
+{
+  m_integral = 0.0f;
+}
+
+}
+}
+}
+}
@@ -0,0 +1,82 @@
+/**
+* Copyright (C) 2017 Chalmers Revere
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+* USA.
+*/
+
+#include <algorithm>
+
+#include "tractionlimiter.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace action {
+
+TractionLimiter::TractionLimiter(float a_friction, float a_targetSlip,
+    float a_slipGain) :
+  m_friction(a_friction),
+  m_targetSlip(a_targetSlip),
+  m_slipGain(a_slipGain),
+  m_referenceSpeed(0.0f),
+  m_slipRatio(0.0f)
+{
+}
+
+TractionLimiter::~TractionLimiter()
+{
+}
+
+/**
+ * Updates the reference speed and slip ratio from a wheel speed [m/s] that
+ * was measured the given time step [s] after the previous one.
+ */
+void TractionLimiter::update(float a_wheelSpeed, float a_timeStep)
+{
+  float const minSpeed = 1.0f;
+  float const maxChange = m_friction * 9.81f * a_timeStep;
+  m_referenceSpeed += std::min(std::max(a_wheelSpeed - m_referenceSpeed,
+        -maxChange), maxChange);
+  m_slipRatio = (a_wheelSpeed - m_referenceSpeed)
+    / std::max(m_referenceSpeed, minSpeed);
+}
+
+/**
+ * Scales the requested acceleration [m/s^2] down linearly with the slip in
+ * excess of the target, in the direction of the request.
+ */
+float TractionLimiter::limit(float a_acceleration) const
+{
+  float const slip = (a_acceleration < 0.0f) ? -m_slipRatio : m_slipRatio;
+  float const excess = std::max(slip - m_targetSlip, 0.0f);
+  float const scale = std::max(1.0f - m_slipGain * excess, 0.0f);
+  return a_acceleration * scale;
+}
+
+float TractionLimiter::referenceSpeed() const
+{
+  return m_referenceSpeed;
+}
+
+float TractionLimiter::slipRatio() const
+{
+  return m_slipRatio;
+}
+
+}
+}
+}
+}
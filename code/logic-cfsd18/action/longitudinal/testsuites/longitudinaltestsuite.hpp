@@ -19,9 +19,17 @@
 #ifndef OPENDLV_LOGIC_CFSD18_ACTION_LONGITUDINAL_TESTSUITE_HPP
 #define OPENDLV_LOGIC_CFSD18_ACTION_LONGITUDINAL_TESTSUITE_HPP
 
+#include <cmath>
+
 #include "cxxtest/TestSuite.h"
 
+#include "benchmark.hpp"
+#include "inprocessbus.hpp"
+
 #include "../include/longitudinal.hpp"
+#include "../include/previewcontroller.hpp"
+#include "../include/speedcontroller.hpp"
+#include "../include/tractionlimiter.hpp"
 
 class LongitudinalTest : public CxxTest::TestSuite {
   public:
@@ -37,6 +45,103 @@ class LongitudinalTest : public CxxTest::TestSuite {
     {
       TS_ASSERT(true);
     }
+
+    void testSpeedControllerFeedforwardAndSaturation()
+    {
+      opendlv::logic::cfsd18::action::SpeedController controller(1.0f, 0.5f,
+          1.0f, 5.0f, 10.0f);
+      TS_ASSERT_DELTA(controller.step(10.0f, 2.0f, 10.0f, 0.02f), 2.0f, 1e-6f);
+      TS_ASSERT_DELTA(controller.step(30.0f, 0.0f, 10.0f, 0.02f), 5.0f, 1e-6f);
+      TS_ASSERT_DELTA(controller.step(0.0f, 0.0f, 30.0f, 0.02f), -10.0f, 1e-6f);
+    }
+
+    void testSpeedControllerDoesNotWindUp()
+    {
+      opendlv::logic::cfsd18::action::SpeedController controller(0.5f, 1.0f,
+          10.0f, 5.0f, 10.0f);
+      for (uint32_t i = 0; i < 1000; i++) {
+        controller.step(30.0f, 0.0f, 10.0f, 0.02f);
+      }
+      // Once the reference is reached the output must leave saturation
+      // right away instead of unwinding a large integral.
+      TS_ASSERT_LESS_THAN(controller.step(10.0f, 0.0f, 10.0f, 0.02f), 5.0f);
+    }
+
+    void testTractionLimiterReducesRequestsWhenSlipping()
+    {
+      opendlv::logic::cfsd18::action::TractionLimiter limiter(1.0f, 0.1f, 5.0f);
+      for (uint32_t i = 0; i < 100; i++) {
+        limiter.update(10.0f, 0.02f);
+      }
+      TS_ASSERT_DELTA(limiter.referenceSpeed(), 10.0f, 1e-4f);
+      TS_ASSERT_DELTA(limiter.limit(3.0f), 3.0f, 1e-6f);
+
+      // The wheels spin up faster than the tyres can accelerate the car.
+      limiter.update(14.0f, 0.02f);
+      TS_ASSERT_LESS_THAN(0.1f, limiter.slipRatio());
+      TS_ASSERT_LESS_THAN(limiter.limit(3.0f), 3.0f);
+      TS_ASSERT_DELTA(limiter.limit(-3.0f), -3.0f, 1e-6f);
+    }
+
+    void testPreviewControllerBrakesForCornerAhead()
+    {
+      opendlv::logic::cfsd18::action::PreviewController controller(15.0f,
+          0.2f, 10.0f, 25.0f);
+      TS_ASSERT_DELTA(controller.targetSpeed(0.0f, 15.0f), 25.0f, 1e-6f);
+
+      // A point 15 m ahead at 30 degrees lies on a 15 m radius arc.
+      float const targetSpeed = controller.targetSpeed(0.5236f, 15.0f);
+      TS_ASSERT_DELTA(targetSpeed, std::sqrt(150.0f), 1e-2f);
+
+      TS_ASSERT_DELTA(controller.acceleration(10.0f, 15.0f, 10.0f), 0.0f,
+          1e-6f);
+      float const slow = controller.acceleration(targetSpeed, 15.0f, 14.0f);
+      float const fast = controller.acceleration(targetSpeed, 15.0f, 20.0f);
+      TS_ASSERT_LESS_THAN(slow, 0.0f);
+      TS_ASSERT_LESS_THAN(fast, (150.0f - 400.0f) / 30.0f);
+    }
+
+    void testPreviewDoesNotExceedSpeedLimit()
+    {
+      // A straight ahead previews the highest speed, which must not override
+      // a lower speed limit, such as the one of a mission that stops.
+      opendlv::logic::cfsd18::common::InProcessBus bus(
+          opendlv::logic::cfsd18::common::Delivery::Direct,
+          opendlv::logic::cfsd18::common::Mirroring::None);
+      float acceleration = -1.0f;
+      bus.subscribe([&acceleration](odcore::data::Container &a_container) {
+          if (a_container.getDataType()
+              == opendlv::proxy::GroundAccelerationRequest::ID()) {
+            acceleration = a_container.getData<
+              opendlv::proxy::GroundAccelerationRequest>()
+              .getGroundAcceleration();
+          }
+        });
+      auto longitudinal = opendlv::logic::cfsd18::common::createMicroservice<
+        opendlv::logic::cfsd18::action::Longitudinal>(bus);
+
+      // The wheel speeds settle the reference speed at the speed limit.
+      odcore::data::Container groundSpeed(
+          opendlv::proxy::GroundSpeedReading(5.0f));
+      for (int32_t i = 1; i <= 10; i++) {
+        groundSpeed.setReceivedTimeStamp(
+            odcore::data::TimeStamp(100, i * 100000));
+        longitudinal->nextContainer(groundSpeed);
+      }
+      odcore::data::TimeStamp const now(101, 0);
+      odcore::data::Container speedLimit(
+          opendlv::logic::cognition::GroundSpeedLimit(5.0f));
+      odcore::data::Container previewPoint(
+          opendlv::logic::action::PreviewPoint(0.0f, 0.0f, 15.0f));
+      odcore::data::Container aimPoint(
+          opendlv::logic::action::AimPoint(0.0f, 0.0f, 6.0f));
+      for (auto container : {&speedLimit, &previewPoint, &aimPoint}) {
+        container->setReceivedTimeStamp(now);
+        longitudinal->nextContainer(*container);
+      }
+      TS_ASSERT_LESS_THAN_EQUALS(0.0f, acceleration);
+      TS_ASSERT_LESS_THAN(acceleration, 0.1f);
+    }
 };
 
 #endif
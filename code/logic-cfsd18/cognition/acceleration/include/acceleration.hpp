@@ -20,12 +20,17 @@
 #ifndef OPENDLV_LOGIC_CFSD18_COGNITION_ACCELERATION_HPP
 #define OPENDLV_LOGIC_CFSD18_COGNITION_ACCELERATION_HPP
 
+#include <opendavinci/odcore/base/KeyValueConfiguration.h>
 #include <opendavinci/odcore/base/module/DataTriggeredConferenceClientModule.h>
 #include <opendavinci/odcore/data/Container.h>
 
 //#include <odvdopendlvstandardmessageset/GeneratedHeaders_ODVDOpenDLVStandardMessageSet.h>
 #include <odvdcfsd18/GeneratedHeaders_ODVDcfsd18.h>
 
+#include "busport.hpp"
+#include "planner.hpp"
+#include "accelerationmission.hpp"
+
 namespace opendlv {
 namespace logic {
 namespace cfsd18 {
@@ -38,10 +43,16 @@ class Acceleration : public odcore::base::module::DataTriggeredConferenceClientM
   Acceleration &operator=(Acceleration const &) = delete;
   virtual ~Acceleration();
   virtual void nextContainer(odcore::data::Container &);
+  void attachBus(common::InProcessBus &);
+  void setUp(odcore::base::KeyValueConfiguration const &);
 
  private:
   void setUp();
   void tearDown();
+  void receive(odcore::data::Container &);
+
+  common::BusPort m_busPort;
+  common::Planner<AccelerationMission> m_planner;
 };
 
 }
@@ -0,0 +1,81 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_COGNITION_ACCELERATIONMISSION_HPP
+#define OPENDLV_LOGIC_CFSD18_COGNITION_ACCELERATIONMISSION_HPP
+
+#include "missionsupervisor.hpp"
+#include "path.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace cognition {
+
+/**
+ * Mission policy for the acceleration event: the path is straight, so the
+ * speed is only limited by the configured top speed.
+ */
+class AccelerationMission {
+ public:
+  AccelerationMission(float a_aimDistance, float a_previewDistance,
+      float a_maxSpeed) :
+    m_aimDistance(a_aimDistance),
+    m_previewDistance(a_previewDistance),
+    m_maxSpeed(a_maxSpeed)
+  {
+  }
+
+  static bool serves(common::MissionId a_missionId)
+  {
+    return a_missionId == common::MissionId::Acceleration;
+  }
+
+  static bool isPreviewExtrapolated()
+  {
+    return false;
+  }
+
+  float aimDistance(common::Path const &, float) const
+  {
+    return m_aimDistance;
+  }
+
+  float previewDistance(common::Path const &, float) const
+  {
+    return m_previewDistance;
+  }
+
+  float speedLimit(common::Path const &, float) const
+  {
+    return m_maxSpeed;
+  }
+
+ private:
+  float m_aimDistance;
+  float m_previewDistance;
+  float m_maxSpeed;
+};
+
+}
+}
+}
+}
+
+#endif
@@ -31,7 +31,10 @@ namespace cfsd18 {
 namespace cognition {
 
 Acceleration::Acceleration(int32_t const &a_argc, char **a_argv) :
-  DataTriggeredConferenceClientModule(a_argc, a_argv, "logic-cfsd18-cognition-acceleration")
+  DataTriggeredConferenceClientModule(a_argc, a_argv, "logic-cfsd18-cognition-acceleration"),
+  m_busPort([this](odcore::data::Container &a_container) { receive(a_container); },
+      [this](odcore::data::Container &a_container) { getConference().send(a_container); }),
+  m_planner(AccelerationMission(10.0f, 20.0f, 30.0f))
 {
 }
 
@@ -39,49 +42,59 @@ Acceleration::~Acceleration()
 {
 }
 
-
+void Acceleration::attachBus(common::InProcessBus &a_bus)
+{
+  m_busPort.attach(a_bus);
+}
 
 void Acceleration::nextContainer(odcore::data::Container &a_container)
 {
-  if (a_container.getDataType() == opendlv::logic::perception::Surface::ID()) {
-    // auto kinematicState = a_container.getData<opendlv::coord::KinematicState>();
-
-    opendlv::logic::action::AimPoint o1;
-    odcore::data::Container c1(o1);
-    getConference().send(c1);
-
-    opendlv::logic::action::PreviewPoint o2;
-    odcore::data::Container c2(o2);
-    getConference().send(c2);
+  m_busPort.receive(a_container);
+}
 
-    opendlv::logic::cognition::GroundSpeedLimit o3;
-    odcore::data::Container c3(o3);
-    getConference().send(c3);
-  }
-  if (a_container.getDataType() == opendlv::system::SignalStatusMessage::ID()) {
-    // auto kinematicState = a_container.getData<opendlv::coord::KinematicState>();
-  }
-  if (a_container.getDataType() == opendlv::system::SystemOperationState::ID()) {
-    // auto kinematicState = a_container.getData<opendlv::coord::KinematicState>();
-  }
-  if (a_container.getDataType() == opendlv::system::NetworkStatusMessage::ID()) {
-    // auto kinematicState = a_container.getData<opendlv::coord::KinematicState>();
-  }
+void Acceleration::receive(odcore::data::Container &a_container)
+{
+  m_planner.nextContainer(a_container,
+      [this](odcore::data::Container &a_output) { m_busPort.send(a_output); });
 }
 
 void Acceleration::setUp()
 {
-  // std::string const exampleConfig = 
-  //   getKeyValueConfiguration().getValue<std::string>(
-  //     "logic-cfsd18-cognition-acceleration.example-config");
+  setUp(getKeyValueConfiguration());
+}
 
-  // if (isVerbose()) {
-  //   std::cout << "Example config is " << exampleConfig << std::endl;
-  // }
+void Acceleration::setUp(
+    odcore::base::KeyValueConfiguration const &a_configuration)
+{
+  float const statisticsPeriod =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-cognition-acceleration.statistics-period");
+  m_busPort.publishStatistics(getName(), statisticsPeriod);
+
+  float const aimDistance =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-cognition-acceleration.aim-distance");
+  float const previewDistance =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-cognition-acceleration.preview-distance");
+  float const maxSpeed =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-cognition-acceleration.max-speed");
+  m_planner.setMission(AccelerationMission(aimDistance, previewDistance, maxSpeed));
+
+  if (isVerbose()) {
+    std::cout << "Planning with aim distance " << aimDistance
+      << " m, preview distance " << previewDistance
+      << " m and max speed " << maxSpeed << " m/s." << std::endl;
+  }
 }
 
 void Acceleration::tearDown()
 {
+  if (isVerbose()) {
+    std::cout << "Stage trace: " << m_busPort.traceReport() << "."
+      << std::endl;
+  }
 }
 
 }
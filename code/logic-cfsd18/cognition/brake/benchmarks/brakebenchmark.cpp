@@ -0,0 +1,54 @@
+/**
+* Copyright (C) 2017 Chalmers Revere
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+* USA.
+*/
+
+#include <vector>
+
+#include <odvdcfsd18/GeneratedHeaders_ODVDcfsd18.h>
+
+#include "brake.hpp"
+#include "benchmark.hpp"
+#include "missionsupervisor.hpp"
+#include "plannerbenchmark.hpp"
+
+namespace {
+
+using opendlv::logic::cfsd18::common::BenchmarkState;
+using opendlv::logic::cfsd18::common::MissionId;
+
+void planSyntheticSurfaces(BenchmarkState &a_state)
+{
+  std::vector<odcore::data::Container> surfaces =
+    opendlv::logic::cfsd18::common::arcSurfaces(0.0f);
+  opendlv::logic::cfsd18::common::planSurfaces<
+    opendlv::logic::cfsd18::cognition::Brake>(a_state, MissionId::BrakeTest,
+        surfaces);
+}
+
+void planRecordedSurfaces(BenchmarkState &a_state)
+{
+  opendlv::logic::cfsd18::common::planRecordedSurfaces<
+    opendlv::logic::cfsd18::cognition::Brake>(a_state, MissionId::BrakeTest);
+}
+
+CFSD18_BENCHMARK(planSyntheticSurfaces);
+CFSD18_BENCHMARK(planRecordedSurfaces);
+
+}
+
+CFSD18_BENCHMARK_MAIN()
@@ -20,12 +20,18 @@
 #ifndef OPENDLV_LOGIC_CFSD18_COGNITION_BRAKE_HPP
 #define OPENDLV_LOGIC_CFSD18_COGNITION_BRAKE_HPP
 
+#include <opendavinci/odcore/base/KeyValueConfiguration.h>
 #include <opendavinci/odcore/base/module/DataTriggeredConferenceClientModule.h>
 #include <opendavinci/odcore/data/Container.h>
 
 //#include <odvdopendlvstandardmessageset/GeneratedHeaders_ODVDOpenDLVStandardMessageSet.h>
 #include <odvdcfsd18/GeneratedHeaders_ODVDcfsd18.h>
 
+#include "busport.hpp"
+
+#include "brakemission.hpp"
+#include "planner.hpp"
+
 namespace opendlv {
 namespace logic {
 namespace cfsd18 {
@@ -38,10 +44,16 @@ class Brake : public odcore::base::module::DataTriggeredConferenceClientModule {
   Brake &operator=(Brake const &) = delete;
   virtual ~Brake();
   virtual void nextContainer(odcore::data::Container &);
+  void attachBus(common::InProcessBus &);
+  void setUp(odcore::base::KeyValueConfiguration const &);
 
  private:
   void setUp();
   void tearDown();
+  void receive(odcore::data::Container &);
+
+  common::BusPort m_busPort;
+  common::Planner<BrakeMission> m_planner;
 };
 
 }
@@ -0,0 +1,82 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_COGNITION_BRAKEMISSION_HPP
+#define OPENDLV_LOGIC_CFSD18_COGNITION_BRAKEMISSION_HPP
+
+#include "missionsupervisor.hpp"
+#include "path.hpp"
+#include "stoppingprofile.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace cognition {
+
+/**
+ * Mission policy for the brake test. The stop zone is the end of the path,
+ * the speed limit follows the closed-form stopping profile for the remaining
+ * distance, and the preview point is where the car would come to rest if the
+ * profile was started now. That point is extrapolated past the end of the
+ * path, so that an overshoot of the stop zone shows.
+ */
+class BrakeMission {
+ public:
+  BrakeMission(StoppingProfile const &a_stoppingProfile, float a_stopMargin) :
+    m_stoppingProfile(a_stoppingProfile),
+    m_stopMargin(a_stopMargin)
+  {
+  }
+
+  static bool serves(common::MissionId a_missionId)
+  {
+    return a_missionId == common::MissionId::BrakeTest;
+  }
+
+  static bool isPreviewExtrapolated()
+  {
+    return true;
+  }
+
+  float aimDistance(common::Path const &a_path, float) const
+  {
+    return a_path.length();
+  }
+
+  float previewDistance(common::Path const &, float a_groundSpeed) const
+  {
+    return m_stoppingProfile.stoppingDistance(a_groundSpeed);
+  }
+
+  float speedLimit(common::Path const &a_path, float) const
+  {
+    return m_stoppingProfile.speedLimit(a_path.length() - m_stopMargin);
+  }
+
+ private:
+  StoppingProfile m_stoppingProfile;
+  float m_stopMargin;
+};
+
+}
+}
+}
+}
+
+#endif
@@ -31,7 +31,10 @@ namespace cfsd18 {
 namespace cognition {
 
 Brake::Brake(int32_t const &a_argc, char **a_argv) :
-  DataTriggeredConferenceClientModule(a_argc, a_argv, "logic-cfsd18-cognition-brake")
+  DataTriggeredConferenceClientModule(a_argc, a_argv, "logic-cfsd18-cognition-brake"),
+  m_busPort([this](odcore::data::Container &a_container) { receive(a_container); },
+      [this](odcore::data::Container &a_container) { getConference().send(a_container); }),
+  m_planner(BrakeMission(StoppingProfile(10.0f, 50.0f), 1.0f))
 {
 }
 
@@ -39,49 +42,60 @@ Brake::~Brake()
 {
 }
 
-
+void Brake::attachBus(common::InProcessBus &a_bus)
+{
+  m_busPort.attach(a_bus);
+}
 
 void Brake::nextContainer(odcore::data::Container &a_container)
 {
-  if (a_container.getDataType() == opendlv::logic::perception::Surface::ID()) {
-    // auto kinematicState = a_container.getData<opendlv::coord::KinematicState>();
-
-    opendlv::logic::action::AimPoint o1;
-    odcore::data::Container c1(o1);
-    getConference().send(c1);
-
-    opendlv::logic::action::PreviewPoint o2;
-    odcore::data::Container c2(o2);
-    getConference().send(c2);
+  m_busPort.receive(a_container);
+}
 
-    opendlv::logic::cognition::GroundSpeedLimit o3;
-    odcore::data::Container c3(o3);
-    getConference().send(c3);
-  }
-  if (a_container.getDataType() == opendlv::system::SignalStatusMessage::ID()) {
-    // auto kinematicState = a_container.getData<opendlv::coord::KinematicState>();
-  }
-  if (a_container.getDataType() == opendlv::system::SystemOperationState::ID()) {
-    // auto kinematicState = a_container.getData<opendlv::coord::KinematicState>();
-  }
-  if (a_container.getDataType() == opendlv::system::NetworkStatusMessage::ID()) {
-    // auto kinematicState = a_container.getData<opendlv::coord::KinematicState>();
-  }
+void Brake::receive(odcore::data::Container &a_container)
+{
+  m_planner.nextContainer(a_container,
+      [this](odcore::data::Container &a_output) { m_busPort.send(a_output); });
 }
 
 void Brake::setUp()
 {
-  // std::string const exampleConfig = 
-  //   getKeyValueConfiguration().getValue<std::string>(
-  //     "logic-cfsd18-cognition-brake.example-config");
+  setUp(getKeyValueConfiguration());
+}
 
-  // if (isVerbose()) {
-  //   std::cout << "Example config is " << exampleConfig << std::endl;
-  // }
+void Brake::setUp(
+    odcore::base::KeyValueConfiguration const &a_configuration)
+{
+  float const statisticsPeriod =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-cognition-brake.statistics-period");
+  m_busPort.publishStatistics(getName(), statisticsPeriod);
+
+  float const maxDeceleration =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-cognition-brake.max-deceleration");
+  float const maxJerk =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-cognition-brake.max-jerk");
+  float const stopMargin =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-cognition-brake.stop-margin");
+  m_planner.setMission(BrakeMission(
+        StoppingProfile(maxDeceleration, maxJerk), stopMargin));
+
+  if (isVerbose()) {
+    std::cout << "Braking with max deceleration " << maxDeceleration
+      << " m/s^2, max jerk " << maxJerk << " m/s^3 and stop margin "
+      << stopMargin << " m." << std::endl;
+  }
 }
 
 void Brake::tearDown()
 {
+  if (isVerbose()) {
+    std::cout << "Stage trace: " << m_busPort.traceReport() << "."
+      << std::endl;
+  }
 }
 
 }
@@ -0,0 +1,82 @@
+/**
+* Copyright (C) 2017 Chalmers Revere
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+* USA.
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include "stoppingprofile.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace cognition {
+
+StoppingProfile::StoppingProfile(float a_maxDeceleration, float a_maxJerk) :
+  m_maxDeceleration(a_maxDeceleration),
+  m_maxJerk(a_maxJerk)
+{
+}
+
+StoppingProfile::~StoppingProfile()
+{
+}
+
+/**
+ * Distance needed to stop from the given speed. Below the speed that is lost
+ * during the jerk ramp, v_r = a^2 / (2 j), the maximum deceleration is never
+ * reached and the car stops within the ramp itself.
+ */
+float StoppingProfile::stoppingDistance(float a_speed) const
+{
+  float const a = m_maxDeceleration;
+  float const j = m_maxJerk;
+  float const v = std::max(a_speed, 0.0f);
+  float const rampSpeed = a * a / (2.0f * j);
+
+  if (v < rampSpeed) {
+    return 2.0f / 3.0f * v * std::sqrt(2.0f * v / j);
+  }
+
+  float const v1 = v - rampSpeed;
+  return v1 * v1 / (2.0f * a) + v1 * a / j + a * a * a / (3.0f * j * j);
+}
+
+/**
+ * Highest speed from which the car can still stop within the given distance,
+ * i.e. the inverse of stoppingDistance.
+ */
+float StoppingProfile::speedLimit(float a_distance) const
+{
+  float const a = m_maxDeceleration;
+  float const j = m_maxJerk;
+  float const d = std::max(a_distance, 0.0f);
+  float const rampDistance = a * a * a / (3.0f * j * j);
+
+  if (d < rampDistance) {
+    return std::cbrt(9.0f * d * d * j / 8.0f);
+  }
+
+  return a * std::sqrt(a * a / (3.0f * j * j) + 2.0f * d / a)
+    - a * a / (2.0f * j);
+}
+
+}
+}
+}
+}
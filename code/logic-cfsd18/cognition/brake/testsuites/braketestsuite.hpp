@@ -19,9 +19,13 @@
 #ifndef OPENDLV_LOGIC_CFSD18_COGNITION_BRAKE_TESTSUITE_HPP
 #define OPENDLV_LOGIC_CFSD18_COGNITION_BRAKE_TESTSUITE_HPP
 
+#include <vector>
+
 #include "cxxtest/TestSuite.h"
 
 #include "../include/brake.hpp"
+#include "../include/brakemission.hpp"
+#include "../include/stoppingprofile.hpp"
 
 class BrakeTest : public CxxTest::TestSuite {
   public:
@@ -37,6 +41,134 @@ class BrakeTest : public CxxTest::TestSuite {
     {
       TS_ASSERT(true);
     }
+
+    void testStoppingDistanceIsInverseOfSpeedLimit()
+    {
+      opendlv::logic::cfsd18::cognition::StoppingProfile profile(10.0f, 50.0f);
+      for (float speed = 0.5f; speed < 40.0f; speed += 0.5f) {
+        float const distance = profile.stoppingDistance(speed);
+        TS_ASSERT_DELTA(profile.speedLimit(distance), speed, 1e-3f * speed);
+      }
+    }
+
+    void testStoppingDistanceApproachesConstantDeceleration()
+    {
+      opendlv::logic::cfsd18::cognition::StoppingProfile profile(10.0f, 1e6f);
+      TS_ASSERT_DELTA(profile.stoppingDistance(20.0f), 20.0f, 1e-2f);
+      TS_ASSERT_DELTA(profile.speedLimit(20.0f), 20.0f, 1e-2f);
+    }
+
+    void testStandstill()
+    {
+      opendlv::logic::cfsd18::cognition::StoppingProfile profile(10.0f, 50.0f);
+      TS_ASSERT_DELTA(profile.stoppingDistance(0.0f), 0.0f, 1e-6f);
+      TS_ASSERT_DELTA(profile.speedLimit(-1.0f), 0.0f, 1e-6f);
+    }
+
+    void testPlannerStopsAtEndOfPath()
+    {
+      opendlv::logic::cfsd18::cognition::StoppingProfile profile(10.0f, 50.0f);
+      opendlv::logic::cfsd18::common::Planner<
+        opendlv::logic::cfsd18::cognition::BrakeMission> planner(
+            opendlv::logic::cfsd18::cognition::BrakeMission(profile, 0.0f));
+
+      std::vector<odcore::data::Container> sent;
+      auto send = [&sent](odcore::data::Container &a_container) {
+        sent.push_back(a_container);
+      };
+
+      opendlv::system::SystemOperationState systemOperationState(
+          static_cast<int32_t>(
+            opendlv::logic::cfsd18::common::MissionId::BrakeTest), "");
+      odcore::data::Container systemOperationStateContainer(
+          systemOperationState);
+      planner.nextContainer(systemOperationStateContainer, send);
+      TS_ASSERT(planner.isActive());
+
+      for (uint32_t i = 0; i < 4; i++) {
+        float const x = 5.0f * static_cast<float>(i);
+        opendlv::logic::perception::Surface surface(i, x, 1.5f, x, -1.5f,
+            x + 5.0f, 1.5f, x + 5.0f, -1.5f);
+        odcore::data::Container container(surface);
+        planner.nextContainer(container, send);
+      }
+
+      TS_ASSERT_EQUALS(sent.size(), 12u);
+      TS_ASSERT_DELTA(planner.path().length(), 20.0f, 1e-4f);
+      auto speedLimit = sent.back().getData<
+        opendlv::logic::cognition::GroundSpeedLimit>();
+      TS_ASSERT_DELTA(speedLimit.getSpeedLimit(), profile.speedLimit(20.0f),
+          1e-4f);
+    }
+
+    void testPlannerShowsAnOvershootOfTheStopZone()
+    {
+      // At 25 m/s the car needs more than the 20 m left to the stop zone, and
+      // the predicted stop is past it rather than at its end.
+      opendlv::logic::cfsd18::cognition::StoppingProfile profile(10.0f, 50.0f);
+      opendlv::logic::cfsd18::common::Planner<
+        opendlv::logic::cfsd18::cognition::BrakeMission> planner(
+            opendlv::logic::cfsd18::cognition::BrakeMission(profile, 0.0f));
+
+      std::vector<odcore::data::Container> sent;
+      auto send = [&sent](odcore::data::Container &a_container) {
+        sent.push_back(a_container);
+      };
+
+      opendlv::system::SystemOperationState systemOperationState(
+          static_cast<int32_t>(
+            opendlv::logic::cfsd18::common::MissionId::BrakeTest), "");
+      odcore::data::Container systemOperationStateContainer(
+          systemOperationState);
+      planner.nextContainer(systemOperationStateContainer, send);
+      odcore::data::Container groundSpeed(
+          opendlv::proxy::GroundSpeedReading(25.0f));
+      planner.nextContainer(groundSpeed, send);
+
+      for (uint32_t i = 0; i < 4; i++) {
+        float const x = 5.0f * static_cast<float>(i);
+        opendlv::logic::perception::Surface surface(i, x, 1.5f, x, -1.5f,
+            x + 5.0f, 1.5f, x + 5.0f, -1.5f);
+        odcore::data::Container container(surface);
+        planner.nextContainer(container, send);
+      }
+
+      TS_ASSERT_DELTA(planner.path().length(), 20.0f, 1e-4f);
+      float const stoppingDistance = profile.stoppingDistance(25.0f);
+      TS_ASSERT_LESS_THAN(25.0f, stoppingDistance);
+      TS_ASSERT_EQUALS(sent.size(), 12u);
+      auto previewPoint = sent[sent.size() - 2].getData<
+        opendlv::logic::action::PreviewPoint>();
+      TS_ASSERT_DELTA(previewPoint.getDistance(), stoppingDistance, 1e-3f);
+      TS_ASSERT_DELTA(previewPoint.getAzimuthAngle(), 0.0f, 1e-5f);
+    }
+
+    void testPlannerIdlesInOtherMissions()
+    {
+      opendlv::logic::cfsd18::cognition::StoppingProfile profile(10.0f, 50.0f);
+      opendlv::logic::cfsd18::common::Planner<
+        opendlv::logic::cfsd18::cognition::BrakeMission> planner(
+            opendlv::logic::cfsd18::cognition::BrakeMission(profile, 0.0f));
+
+      uint32_t sentCount = 0;
+      auto send = [&sentCount](odcore::data::Container &) {
+        sentCount++;
+      };
+
+      opendlv::system::SystemOperationState systemOperationState(
+          static_cast<int32_t>(
+            opendlv::logic::cfsd18::common::MissionId::Trackdrive), "");
+      odcore::data::Container systemOperationStateContainer(
+          systemOperationState);
+      planner.nextContainer(systemOperationStateContainer, send);
+      TS_ASSERT(!planner.isActive());
+
+      opendlv::logic::perception::Surface surface(0, 0.0f, 1.5f, 0.0f, -1.5f,
+          5.0f, 1.5f, 5.0f, -1.5f);
+      odcore::data::Container surfaceContainer(surface);
+      planner.nextContainer(surfaceContainer, send);
+      TS_ASSERT_EQUALS(sentCount, 0u);
+    }
 };
 
 #endif
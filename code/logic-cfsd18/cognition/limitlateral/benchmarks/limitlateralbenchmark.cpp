@@ -0,0 +1,93 @@
+/**
+* Copyright (C) 2017 Chalmers Revere
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+* USA.
+*/
+
+#include <vector>
+
+#include <odvdcfsd18/GeneratedHeaders_ODVDcfsd18.h>
+
+#include "benchmark.hpp"
+#include "inprocessbus.hpp"
+#include "limitlateral.hpp"
+#include "steeringlimittable.hpp"
+
+namespace {
+
+using opendlv::logic::cfsd18::common::BenchmarkState;
+using opendlv::logic::cfsd18::common::InProcessBus;
+
+void lookUpSteeringLimit(BenchmarkState &a_state)
+{
+  opendlv::logic::cfsd18::cognition::SteeringLimitTable table(1.53f, 0.0f,
+      0.4f, 30.0f, 0.3f, 1.5f);
+  float groundSpeed = 0.0f;
+  while (a_state.keepRunning()) {
+    float const steeringLimit = table.at(groundSpeed, 1.0f);
+    opendlv::logic::cfsd18::common::doNotOptimize(steeringLimit);
+    groundSpeed = (groundSpeed < 30.0f) ? groundSpeed + 0.01f : 0.0f;
+  }
+}
+
+void limitGroundSpeeds(BenchmarkState &a_state)
+{
+  InProcessBus bus(opendlv::logic::cfsd18::common::Delivery::Direct,
+      opendlv::logic::cfsd18::common::Mirroring::None);
+  auto limitLateral = opendlv::logic::cfsd18::common::createMicroservice<
+    opendlv::logic::cfsd18::cognition::LimitLateral>(bus);
+  std::vector<odcore::data::Container> containers;
+  for (uint32_t i = 0; i < 64; i++) {
+    opendlv::proxy::GroundSpeedReading groundSpeedReading(
+        0.5f * static_cast<float>(i));
+    containers.push_back(odcore::data::Container(groundSpeedReading));
+  }
+
+  uint64_t i = 0;
+  while (a_state.keepRunning()) {
+    limitLateral->nextContainer(containers[i++ % containers.size()]);
+  }
+  a_state.setItemsProcessed(a_state.iterations());
+}
+
+void limitRecordedGroundSpeeds(BenchmarkState &a_state)
+{
+  std::vector<odcore::data::Container> containers =
+    opendlv::logic::cfsd18::common::Benchmarks::instance().recorded(
+        opendlv::proxy::GroundSpeedReading::ID());
+  if (containers.empty()) {
+    a_state.skip("No recorded ground speed readings.");
+    return;
+  }
+  InProcessBus bus(opendlv::logic::cfsd18::common::Delivery::Direct,
+      opendlv::logic::cfsd18::common::Mirroring::None);
+  auto limitLateral = opendlv::logic::cfsd18::common::createMicroservice<
+    opendlv::logic::cfsd18::cognition::LimitLateral>(bus);
+
+  uint64_t i = 0;
+  while (a_state.keepRunning()) {
+    limitLateral->nextContainer(containers[i++ % containers.size()]);
+  }
+  a_state.setItemsProcessed(a_state.iterations());
+}
+
+CFSD18_BENCHMARK(lookUpSteeringLimit);
+CFSD18_BENCHMARK(limitGroundSpeeds);
+CFSD18_BENCHMARK(limitRecordedGroundSpeeds);
+
+}
+
+CFSD18_BENCHMARK_MAIN()
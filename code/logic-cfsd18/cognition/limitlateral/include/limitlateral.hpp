@@ -20,12 +20,19 @@
 #ifndef OPENDLV_LOGIC_CFSD18_COGNITION_LIMITLATERAL_HPP
 #define OPENDLV_LOGIC_CFSD18_COGNITION_LIMITLATERAL_HPP
 
+#include <opendavinci/odcore/base/KeyValueConfiguration.h>
 #include <opendavinci/odcore/base/module/DataTriggeredConferenceClientModule.h>
 #include <opendavinci/odcore/data/Container.h>
 
 //#include <odvdopendlvstandardmessageset/GeneratedHeaders_ODVDOpenDLVStandardMessageSet.h>
 #include <odvdcfsd18/GeneratedHeaders_ODVDcfsd18.h>
 
+#include "busport.hpp"
+#include "dispatcher.hpp"
+
+#include "publishfilter.hpp"
+#include "steeringlimittable.hpp"
+
 namespace opendlv {
 namespace logic {
 namespace cfsd18 {
@@ -38,10 +45,21 @@ class LimitLateral : public odcore::base::module::DataTriggeredConferenceClientM
   LimitLateral &operator=(LimitLateral const &) = delete;
   virtual ~LimitLateral();
   virtual void nextContainer(odcore::data::Container &);
+  void attachBus(common::InProcessBus &);
+  void setUp(odcore::base::KeyValueConfiguration const &);
 
  private:
   void setUp();
   void tearDown();
+  void receive(odcore::data::Container &);
+  void onGroundSpeedReading(opendlv::proxy::GroundSpeedReading const &,
+      odcore::data::Container &);
+
+  common::BusPort m_busPort;
+  common::Dispatcher<LimitLateral> m_dispatcher;
+  SteeringLimitTable m_steeringLimitTable;
+  PublishFilter m_publishFilter;
+  float m_friction;
 };
 
 }
@@ -0,0 +1,58 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_COGNITION_PUBLISHFILTER_HPP
+#define OPENDLV_LOGIC_CFSD18_COGNITION_PUBLISHFILTER_HPP
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace cognition {
+
+/**
+ * Decides when a slowly changing value needs to be sent again. A new value is
+ * published when it has moved more than the threshold away from the last
+ * published one and the minimum interval has passed, and in any case once the
+ * maximum interval has passed. Tightening changes, where the new value is
+ * lower, are not held back by the minimum interval.
+ */
+class PublishFilter {
+ public:
+  PublishFilter(float, double, double);
+  PublishFilter(PublishFilter const &) = default;
+  PublishFilter &operator=(PublishFilter const &) = default;
+  virtual ~PublishFilter();
+
+  bool update(float, double);
+
+ private:
+  float m_threshold;
+  double m_minInterval;
+  double m_maxInterval;
+  bool m_hasPublished;
+  float m_lastValue;
+  double m_lastTime;
+};
+
+}
+}
+}
+}
+
+#endif
@@ -0,0 +1,65 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_COGNITION_STEERINGLIMITTABLE_HPP
+#define OPENDLV_LOGIC_CFSD18_COGNITION_STEERINGLIMITTABLE_HPP
+
+#include <array>
+#include <cstdint>
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace cognition {
+
+/**
+ * Steering limit tabulated over ground speed and friction coefficient. The
+ * table is filled once from the steady-state cornering model
+ *
+ *   delta_max = L mu g / v^2 + K mu g,
+ *
+ * with wheel base L and understeer gradient K, clamped to the steering
+ * actuator range. At runtime the limit is bilinearly interpolated, which is
+ * a handful of operations per speed reading.
+ */
+class SteeringLimitTable {
+ public:
+  static uint32_t const SPEED_STEPS = 32;
+  static uint32_t const FRICTION_STEPS = 8;
+
+  SteeringLimitTable(float, float, float, float, float, float);
+  SteeringLimitTable(SteeringLimitTable const &) = default;
+  SteeringLimitTable &operator=(SteeringLimitTable const &) = default;
+  virtual ~SteeringLimitTable();
+
+  float at(float, float) const;
+
+ private:
+  float m_speedStep;
+  float m_minFriction;
+  float m_frictionStep;
+  std::array<float, SPEED_STEPS * FRICTION_STEPS> m_limits;
+};
+
+}
+}
+}
+}
+
+#endif
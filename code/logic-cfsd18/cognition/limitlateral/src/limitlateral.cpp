@@ -24,6 +24,7 @@
 #include <opendavinci/odcore/wrapper/Eigen.h>
 
 #include "limitlateral.hpp"
+#include "trace.hpp"
 
 namespace opendlv {
 namespace logic {
@@ -31,40 +32,115 @@ namespace cfsd18 {
 namespace cognition {
 
 LimitLateral::LimitLateral(int32_t const &a_argc, char **a_argv) :
-  DataTriggeredConferenceClientModule(a_argc, a_argv, "logic-cfsd18-cognition-limitlateral")
+  DataTriggeredConferenceClientModule(a_argc, a_argv, "logic-cfsd18-cognition-limitlateral"),
+  m_busPort([this](odcore::data::Container &a_container) { receive(a_container); },
+      [this](odcore::data::Container &a_container) { getConference().send(a_container); }),
+  m_dispatcher(),
+  m_steeringLimitTable(1.53f, 0.0f, 0.4f, 30.0f, 0.3f, 1.5f),
+  m_publishFilter(0.005f, 0.02, 0.5),
+  m_friction(1.0f)
 {
+  m_dispatcher
+    .add<opendlv::proxy::GroundSpeedReading, &LimitLateral::onGroundSpeedReading>();
 }
 
 LimitLateral::~LimitLateral()
 {
 }
 
-
+void LimitLateral::attachBus(common::InProcessBus &a_bus)
+{
+  m_busPort.attach(a_bus);
+}
 
 void LimitLateral::nextContainer(odcore::data::Container &a_container)
 {
-  if (a_container.getDataType() == opendlv::proxy::GroundSpeedReading::ID()) {
-    // auto kinematicState = a_container.getData<opendlv::coord::KinematicState>();
+  m_busPort.receive(a_container);
+}
+
+void LimitLateral::receive(odcore::data::Container &a_container)
+{
+  m_dispatcher.dispatch(*this, a_container);
+}
+
+void LimitLateral::onGroundSpeedReading(
+    opendlv::proxy::GroundSpeedReading const &a_groundSpeedReading,
+    odcore::data::Container &a_container)
+{
+  float const steeringLimit = m_steeringLimitTable.at(
+      a_groundSpeedReading.getGroundSpeed(), m_friction);
 
-    opendlv::logic::cognition::GroundSteeringLimit o1;
+  double const time = static_cast<double>(
+      a_container.getReceivedTimeStamp().toMicroseconds()) / 1000000.0;
+  if (m_publishFilter.update(steeringLimit, time)) {
+    opendlv::logic::cognition::GroundSteeringLimit o1(steeringLimit);
     odcore::data::Container c1(o1);
-    getConference().send(c1);
+    common::propagateOrigin(a_container, c1);
+    m_busPort.send(c1);
   }
 }
 
 void LimitLateral::setUp()
 {
-  // std::string const exampleConfig = 
-  //   getKeyValueConfiguration().getValue<std::string>(
-  //     "logic-cfsd18-cognition-limitlateral.example-config");
+  setUp(getKeyValueConfiguration());
+}
+
+void LimitLateral::setUp(
+    odcore::base::KeyValueConfiguration const &a_configuration)
+{
+  float const statisticsPeriod =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-cognition-limitlateral.statistics-period");
+  m_busPort.publishStatistics(getName(), statisticsPeriod);
 
-  // if (isVerbose()) {
-  //   std::cout << "Example config is " << exampleConfig << std::endl;
-  // }
+  float const wheelBase =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-cognition-limitlateral.wheel-base");
+  float const understeerGradient =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-cognition-limitlateral.understeer-gradient");
+  float const maxSteering =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-cognition-limitlateral.max-steering");
+  float const maxSpeed =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-cognition-limitlateral.max-speed");
+  float const minFriction =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-cognition-limitlateral.min-friction");
+  float const maxFriction =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-cognition-limitlateral.max-friction");
+  m_steeringLimitTable = SteeringLimitTable(wheelBase, understeerGradient,
+      maxSteering, maxSpeed, minFriction, maxFriction);
+  m_friction = a_configuration.getValue<float>(
+      "logic-cfsd18-cognition-limitlateral.friction");
+
+  float const publishThreshold =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-cognition-limitlateral.publish-threshold");
+  double const minPublishInterval =
+    a_configuration.getValue<double>(
+      "logic-cfsd18-cognition-limitlateral.min-publish-interval");
+  double const maxPublishInterval =
+    a_configuration.getValue<double>(
+      "logic-cfsd18-cognition-limitlateral.max-publish-interval");
+  m_publishFilter = PublishFilter(publishThreshold, minPublishInterval,
+      maxPublishInterval);
+
+  if (isVerbose()) {
+    std::cout << "Steering limits tabulated up to " << maxSpeed
+      << " m/s for friction " << minFriction << " to " << maxFriction
+      << ", estimated friction is " << m_friction << "." << std::endl;
+  }
 }
 
 void LimitLateral::tearDown()
 {
+  if (isVerbose()) {
+    std::cout << "Stage trace: " << m_busPort.traceReport() << "."
+      << std::endl;
+  }
 }
 
 }
@@ -0,0 +1,69 @@
+/**
+* Copyright (C) 2017 Chalmers Revere
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+* USA.
+*/
+
+#include <cmath>
+
+#include "publishfilter.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace cognition {
+
+PublishFilter::PublishFilter(float a_threshold, double a_minInterval,
+    double a_maxInterval) :
+  m_threshold(a_threshold),
+  m_minInterval(a_minInterval),
+  m_maxInterval(a_maxInterval),
+  m_hasPublished(false),
+  m_lastValue(0.0f),
+  m_lastTime(0.0)
+{
+}
+
+PublishFilter::~PublishFilter()
+{
+}
+
+/**
+ * Returns true if the value at the given time [s] should be published, in
+ * which case it becomes the new reference.
+ */
+bool PublishFilter::update(float a_value, double a_time)
+{
+  double const elapsed = a_time - m_lastTime;
+  float const change = a_value - m_lastValue;
+  bool const isSignificant = std::fabs(change) > m_threshold;
+  bool const isTightening = change < -m_threshold;
+
+  bool const publish = !m_hasPublished
+    || elapsed >= m_maxInterval
+    || (isSignificant && (isTightening || elapsed >= m_minInterval));
+  if (publish) {
+    m_hasPublished = true;
+    m_lastValue = a_value;
+    m_lastTime = a_time;
+  }
+  return publish;
+}
+
+}
+}
+}
+}
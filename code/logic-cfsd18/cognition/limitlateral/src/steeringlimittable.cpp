@@ -0,0 +1,88 @@
+/**
+* Copyright (C) 2017 Chalmers Revere
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+* USA.
+*/
+
+#include <algorithm>
+
+#include "steeringlimittable.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace cognition {
+
+uint32_t const SteeringLimitTable::SPEED_STEPS;
+uint32_t const SteeringLimitTable::FRICTION_STEPS;
+
+SteeringLimitTable::SteeringLimitTable(float a_wheelBase,
+    float a_understeerGradient, float a_maxSteering, float a_maxSpeed,
+    float a_minFriction, float a_maxFriction) :
+  m_speedStep(a_maxSpeed / static_cast<float>(SPEED_STEPS - 1)),
+  m_minFriction(a_minFriction),
+  m_frictionStep((a_maxFriction - a_minFriction)
+      / static_cast<float>(FRICTION_STEPS - 1)),
+  m_limits()
+{
+  float const g = 9.81f;
+  for (uint32_t i = 0; i < SPEED_STEPS; i++) {
+    float const speed = m_speedStep * static_cast<float>(i);
+    for (uint32_t j = 0; j < FRICTION_STEPS; j++) {
+      float const friction = m_minFriction
+        + m_frictionStep * static_cast<float>(j);
+      float const lateralAcceleration = friction * g;
+      float limit = a_maxSteering;
+      if (speed > 0.0f) {
+        limit = a_wheelBase * lateralAcceleration / (speed * speed)
+          + a_understeerGradient * lateralAcceleration;
+      }
+      m_limits[i * FRICTION_STEPS + j] = std::min(limit, a_maxSteering);
+    }
+  }
+}
+
+SteeringLimitTable::~SteeringLimitTable()
+{
+}
+
+/**
+ * Steering limit [rad] at the given ground speed [m/s] and friction
+ * coefficient, clamped to the table range.
+ */
+float SteeringLimitTable::at(float a_groundSpeed, float a_friction) const
+{
+  float const u = std::min(std::max(a_groundSpeed / m_speedStep, 0.0f),
+      static_cast<float>(SPEED_STEPS - 1));
+  float const v = std::min(std::max(
+        (a_friction - m_minFriction) / m_frictionStep, 0.0f),
+      static_cast<float>(FRICTION_STEPS - 1));
+  uint32_t const i = std::min(static_cast<uint32_t>(u), SPEED_STEPS - 2);
+  uint32_t const j = std::min(static_cast<uint32_t>(v), FRICTION_STEPS - 2);
+  float const s = u - static_cast<float>(i);
+  float const t = v - static_cast<float>(j);
+
+  float const *row = &m_limits[i * FRICTION_STEPS + j];
+  float const *nextRow = row + FRICTION_STEPS;
+  float const low = row[0] + t * (row[1] - row[0]);
+  float const high = nextRow[0] + t * (nextRow[1] - nextRow[0]);
+  return low + s * (high - low);
+}
+
+}
+}
+}
+}
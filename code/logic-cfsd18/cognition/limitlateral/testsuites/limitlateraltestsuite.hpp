@@ -22,6 +22,8 @@
 #include "cxxtest/TestSuite.h"
 
 #include "../include/limitlateral.hpp"
+#include "../include/publishfilter.hpp"
+#include "../include/steeringlimittable.hpp"
 
 class LimitLateralTest : public CxxTest::TestSuite {
   public:
@@ -37,6 +39,45 @@ class LimitLateralTest : public CxxTest::TestSuite {
     {
       TS_ASSERT(true);
     }
+
+    void testSteeringLimitMatchesModelAtGridPoints()
+    {
+      // 31 m/s over 31 intervals and 0.3 to 1.0 over 7 intervals puts grid
+      // points on whole speeds and tenths of friction.
+      opendlv::logic::cfsd18::cognition::SteeringLimitTable table(1.5f, 0.01f,
+          0.4f, 31.0f, 0.3f, 1.0f);
+      float const lateralAcceleration = 0.8f * 9.81f;
+      TS_ASSERT_DELTA(table.at(10.0f, 0.8f),
+          1.5f * lateralAcceleration / 100.0f + 0.01f * lateralAcceleration,
+          1e-5f);
+      TS_ASSERT_DELTA(table.at(0.0f, 0.8f), 0.4f, 1e-6f);
+    }
+
+    void testSteeringLimitInterpolatesMonotonically()
+    {
+      opendlv::logic::cfsd18::cognition::SteeringLimitTable table(1.5f, 0.0f,
+          0.4f, 31.0f, 0.3f, 1.0f);
+      float previous = table.at(5.0f, 0.8f);
+      for (float speed = 5.25f; speed < 31.0f; speed += 0.25f) {
+        float const limit = table.at(speed, 0.8f);
+        TS_ASSERT_LESS_THAN_EQUALS(limit, previous);
+        previous = limit;
+      }
+      TS_ASSERT_LESS_THAN(table.at(20.0f, 0.5f), table.at(20.0f, 0.9f));
+      TS_ASSERT_DELTA(table.at(50.0f, 2.0f), table.at(31.0f, 1.0f), 1e-6f);
+    }
+
+    void testPublishFilterHysteresisAndIntervals()
+    {
+      opendlv::logic::cfsd18::cognition::PublishFilter filter(0.01f, 0.1, 1.0);
+      TS_ASSERT(filter.update(0.30f, 0.0));
+      TS_ASSERT(!filter.update(0.305f, 0.2));
+      TS_ASSERT(!filter.update(0.35f, 0.05));
+      TS_ASSERT(filter.update(0.35f, 0.15));
+      TS_ASSERT(filter.update(0.30f, 0.16));
+      TS_ASSERT(!filter.update(0.30f, 0.9));
+      TS_ASSERT(filter.update(0.30f, 1.2));
+    }
 };
 
 #endif
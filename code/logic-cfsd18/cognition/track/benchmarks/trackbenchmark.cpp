@@ -0,0 +1,78 @@
+/**
+* Copyright (C) 2017 Chalmers Revere
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+* USA.
+*/
+
+#include <vector>
+
+#include <odvdcfsd18/GeneratedHeaders_ODVDcfsd18.h>
+
+#include "track.hpp"
+#include "benchmark.hpp"
+#include "missionsupervisor.hpp"
+#include "plannerbenchmark.hpp"
+#include "syntheticsensor.hpp"
+#include "synthetictrack.hpp"
+
+namespace {
+
+using opendlv::logic::cfsd18::common::BenchmarkState;
+using opendlv::logic::cfsd18::common::MissionId;
+
+void planSyntheticSurfaces(BenchmarkState &a_state)
+{
+  std::vector<odcore::data::Container> surfaces =
+    opendlv::logic::cfsd18::common::arcSurfaces(1.0f / 20.0f);
+  opendlv::logic::cfsd18::common::planSurfaces<
+    opendlv::logic::cfsd18::cognition::Track>(a_state, MissionId::Trackdrive,
+        surfaces);
+}
+
+/**
+ * The 20 surfaces ahead of the car along a lap of a synthetic trackdrive,
+ * sampled at 10 m/s and 10 Hz.
+ */
+void planTrackdriveSurfaces(BenchmarkState &a_state)
+{
+  auto const track =
+    opendlv::logic::cfsd18::common::SyntheticTrack::trackdrive(1000.0f, 1);
+  opendlv::logic::cfsd18::common::SyntheticSensor const sensor(1, 30.0f,
+      0.0f, 0.0f, 0.0f);
+  std::vector<odcore::data::Container> containers;
+  for (float distance : track.drive(10.0f, 10.0f, 1000.0f)) {
+    std::vector<odcore::data::Container> const surfaces =
+      sensor.surfaces(track, track.poseAt(distance), distance, 20);
+    containers.insert(containers.end(), surfaces.begin(), surfaces.end());
+  }
+  opendlv::logic::cfsd18::common::planSurfaces<
+    opendlv::logic::cfsd18::cognition::Track>(a_state, MissionId::Trackdrive,
+        containers);
+}
+
+void planRecordedSurfaces(BenchmarkState &a_state)
+{
+  opendlv::logic::cfsd18::common::planRecordedSurfaces<
+    opendlv::logic::cfsd18::cognition::Track>(a_state, MissionId::Trackdrive);
+}
+
+CFSD18_BENCHMARK(planSyntheticSurfaces);
+CFSD18_BENCHMARK(planTrackdriveSurfaces);
+CFSD18_BENCHMARK(planRecordedSurfaces);
+
+}
+
+CFSD18_BENCHMARK_MAIN()
@@ -20,12 +20,17 @@
 #ifndef OPENDLV_LOGIC_CFSD18_COGNITION_TRACK_HPP
 #define OPENDLV_LOGIC_CFSD18_COGNITION_TRACK_HPP
 
+#include <opendavinci/odcore/base/KeyValueConfiguration.h>
 #include <opendavinci/odcore/base/module/DataTriggeredConferenceClientModule.h>
 #include <opendavinci/odcore/data/Container.h>
 
 //#include <odvdopendlvstandardmessageset/GeneratedHeaders_ODVDOpenDLVStandardMessageSet.h>
 #include <odvdcfsd18/GeneratedHeaders_ODVDcfsd18.h>
 
+#include "busport.hpp"
+#include "planner.hpp"
+#include "trackmission.hpp"
+
 namespace opendlv {
 namespace logic {
 namespace cfsd18 {
@@ -38,10 +43,16 @@ class Track : public odcore::base::module::DataTriggeredConferenceClientModule {
   Track &operator=(Track const &) = delete;
   virtual ~Track();
   virtual void nextContainer(odcore::data::Container &);
+  void attachBus(common::InProcessBus &);
+  void setUp(odcore::base::KeyValueConfiguration const &);
 
  private:
   void setUp();
   void tearDown();
+  void receive(odcore::data::Container &);
+
+  common::BusPort m_busPort;
+  common::Planner<TrackMission> m_planner;
 };
 
 }
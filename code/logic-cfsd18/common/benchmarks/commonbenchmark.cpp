@@ -0,0 +1,136 @@
+/**
+* Copyright (C) 2017 Chalmers Revere
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+* USA.
+*/
+
+#include <cmath>
+#include <vector>
+
+#include <odvdcfsd18/GeneratedHeaders_ODVDcfsd18.h>
+
+#include "benchmark.hpp"
+#include "histogram.hpp"
+#include "path.hpp"
+#include "spscring.hpp"
+#include "syntheticsensor.hpp"
+#include "synthetictrack.hpp"
+
+namespace {
+
+using opendlv::logic::cfsd18::common::BenchmarkState;
+
+void decodeAimPoint(BenchmarkState &a_state)
+{
+  opendlv::logic::action::AimPoint aimPoint(0.1f, 0.0f, 6.0f);
+  odcore::data::Container container(aimPoint);
+  while (a_state.keepRunning()) {
+    auto decoded = container.getData<opendlv::logic::action::AimPoint>();
+    opendlv::logic::cfsd18::common::doNotOptimize(decoded);
+  }
+  a_state.setItemsProcessed(a_state.iterations());
+}
+
+void recordHistogram(BenchmarkState &a_state)
+{
+  opendlv::logic::cfsd18::common::Histogram histogram;
+  uint64_t value = 1;
+  while (a_state.keepRunning()) {
+    histogram.record(value);
+    value = value * 7 % 1000003;
+  }
+  a_state.setItemsProcessed(a_state.iterations());
+}
+
+void pushPopSpscRing(BenchmarkState &a_state)
+{
+  opendlv::logic::cfsd18::common::SpscRing<odcore::data::Container, 64> ring;
+  opendlv::logic::perception::Surface surface;
+  odcore::data::Container container(surface);
+  odcore::data::Container popped;
+  while (a_state.keepRunning()) {
+    ring.tryPush(container);
+    ring.tryPop(popped);
+  }
+  a_state.setItemsProcessed(a_state.iterations());
+}
+
+void pathSpeedLimit(BenchmarkState &a_state)
+{
+  float const radius = 20.0f;
+  opendlv::logic::cfsd18::common::Path path;
+  for (uint32_t i = 0; i < 40; i++) {
+    float const angle = static_cast<float>(i) * 0.1f;
+    path.append(radius * std::sin(angle), radius * (1.0f - std::cos(angle)));
+  }
+  while (a_state.keepRunning()) {
+    float const speedLimit = path.speedLimit(9.0f, 10.0f, 30.0f);
+    opendlv::logic::cfsd18::common::doNotOptimize(speedLimit);
+  }
+}
+
+/**
+ * Scans along a trackdrive of the given length in metres, with two cones
+ * every 4 m, to show how the synthesis scales with the number of cones.
+ */
+template<uint32_t Length>
+void synthesiseScan(BenchmarkState &a_state)
+{
+  auto const track =
+    opendlv::logic::cfsd18::common::SyntheticTrack::trackdrive(Length, 1);
+  opendlv::logic::cfsd18::common::SyntheticSensor sensor(1, 30.0f, 0.02f,
+      0.002f, 0.01f);
+  std::vector<float> const distances = track.drive(10.0f, 10.0f, Length);
+  uint64_t i = 0;
+  while (a_state.keepRunning()) {
+    auto const scan = sensor.scan(track,
+        track.poseAt(distances[i++ % distances.size()]));
+    opendlv::logic::cfsd18::common::doNotOptimize(scan);
+  }
+  a_state.setItemsProcessed(a_state.iterations());
+}
+
+template<uint32_t Length>
+void synthesiseObjects(BenchmarkState &a_state)
+{
+  auto const track =
+    opendlv::logic::cfsd18::common::SyntheticTrack::trackdrive(Length, 1);
+  opendlv::logic::cfsd18::common::SyntheticSensor sensor(1, 30.0f, 0.02f,
+      0.002f, 0.01f);
+  std::vector<float> const distances = track.drive(10.0f, 10.0f, Length);
+  uint64_t i = 0;
+  while (a_state.keepRunning()) {
+    auto const objects = sensor.objects(track,
+        track.poseAt(distances[i++ % distances.size()]));
+    opendlv::logic::cfsd18::common::doNotOptimize(objects);
+  }
+  a_state.setItemsProcessed(a_state.iterations());
+}
+
+CFSD18_BENCHMARK(decodeAimPoint);
+CFSD18_BENCHMARK(recordHistogram);
+CFSD18_BENCHMARK(pushPopSpscRing);
+CFSD18_BENCHMARK(pathSpeedLimit);
+CFSD18_BENCHMARK_TEMPLATE(synthesiseScan, 1000);
+CFSD18_BENCHMARK_TEMPLATE(synthesiseScan, 10000);
+CFSD18_BENCHMARK_TEMPLATE(synthesiseScan, 50000);
+CFSD18_BENCHMARK_TEMPLATE(synthesiseObjects, 1000);
+CFSD18_BENCHMARK_TEMPLATE(synthesiseObjects, 10000);
+CFSD18_BENCHMARK_TEMPLATE(synthesiseObjects, 50000);
+
+}
+
+CFSD18_BENCHMARK_MAIN()
@@ -0,0 +1,175 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_COMMON_ARENA_HPP
+#define OPENDLV_LOGIC_CFSD18_COMMON_ARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace common {
+
+/**
+ * Monotonic memory for the temporaries of one frame. Allocation bumps a
+ * pointer through the current block, freeing does nothing, and everything
+ * is released at once when the frame ends. A frame that does not fit gets
+ * another block, and at the next reset the blocks are replaced by one that
+ * holds them all, so once the arena has seen its largest frame it never
+ * allocates again. New blocks are written once, so that their pages are
+ * faulted in while warming up rather than in the middle of a frame. An
+ * arena is used by one thread at a time. Frames may nest, in which case
+ * only the end of the outermost one resets the arena.
+ */
+class Arena {
+ public:
+  explicit Arena(uint64_t = 65536);
+  Arena(Arena const &) = delete;
+  Arena &operator=(Arena const &) = delete;
+  virtual ~Arena();
+
+  void *allocate(uint64_t, uint64_t);
+  void reset();
+  void enter();
+  void leave();
+  uint32_t depth() const;
+  uint64_t capacity() const;
+  uint64_t used() const;
+  uint64_t blockAllocations() const;
+
+ private:
+  void addBlock(uint64_t);
+
+  std::vector<std::unique_ptr<char[]>> m_blocks;
+  std::vector<uint64_t> m_blockSizes;
+  char *m_next;
+  uint64_t m_remaining;
+  uint64_t m_capacity;
+  uint64_t m_used;
+  uint64_t m_blockAllocations;
+  uint32_t m_depth;
+};
+
+/**
+ * A frame of an arena that lasts as long as its scope.
+ */
+class ArenaFrame {
+ public:
+  explicit ArenaFrame(Arena &);
+  ArenaFrame(ArenaFrame const &) = delete;
+  ArenaFrame &operator=(ArenaFrame const &) = delete;
+  virtual ~ArenaFrame();
+
+ private:
+  Arena &m_arena;
+};
+
+/**
+ * Standard allocator that takes its memory from an arena, shaped like
+ * std::pmr::polymorphic_allocator over a std::pmr::monotonic_buffer_resource
+ * so that the containers can move to those with C++17. Containers that use
+ * it must not outlive the frame of the arena.
+ */
+template<typename T>
+class ArenaAllocator {
+ public:
+  typedef T value_type;
+
+  explicit ArenaAllocator(Arena &);
+  template<typename U>
+  ArenaAllocator(ArenaAllocator<U> const &);
+  ArenaAllocator(ArenaAllocator const &) = default;
+  ArenaAllocator &operator=(ArenaAllocator const &) = default;
+  virtual ~ArenaAllocator();
+
+  T *allocate(std::size_t);
+  void deallocate(T *, std::size_t);
+  Arena &arena() const;
+
+ private:
+  Arena *m_arena;
+};
+
+template<typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+template<typename K, typename V>
+using ArenaUnorderedMap = std::unordered_map<K, V, std::hash<K>,
+      std::equal_to<K>, ArenaAllocator<std::pair<K const, V>>>;
+
+template<typename T>
+ArenaAllocator<T>::ArenaAllocator(Arena &a_arena) :
+  m_arena(&a_arena)
+{
+}
+
+template<typename T>
+template<typename U>
+ArenaAllocator<T>::ArenaAllocator(ArenaAllocator<U> const &a_allocator) :
+  m_arena(&a_allocator.arena())
+{
+}
+
+template<typename T>
+ArenaAllocator<T>::~ArenaAllocator()
+{
+}
+
+template<typename T>
+T *ArenaAllocator<T>::allocate(std::size_t a_count)
+{
+  return static_cast<T *>(m_arena->allocate(a_count * sizeof(T), alignof(T)));
+}
+
+template<typename T>
+void ArenaAllocator<T>::deallocate(T *, std::size_t)
+{
+}
+
+template<typename T>
+Arena &ArenaAllocator<T>::arena() const
+{
+  return *m_arena;
+}
+
+template<typename T, typename U>
+bool operator==(ArenaAllocator<T> const &a_lhs, ArenaAllocator<U> const &a_rhs)
+{
+  return &a_lhs.arena() == &a_rhs.arena();
+}
+
+template<typename T, typename U>
+bool operator!=(ArenaAllocator<T> const &a_lhs, ArenaAllocator<U> const &a_rhs)
+{
+  return !(a_lhs == a_rhs);
+}
+
+}
+}
+}
+}
+
+#endif
@@ -0,0 +1,170 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_COMMON_BENCHMARK_HPP
+#define OPENDLV_LOGIC_CFSD18_COMMON_BENCHMARK_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <istream>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <opendavinci/odcore/data/Container.h>
+
+#include "inprocessbus.hpp"
+
+/**
+ * Registers a function taking a BenchmarkState, under its own name.
+ */
+#define CFSD18_BENCHMARK(function) \
+  bool const function##IsRegistered = \
+    opendlv::logic::cfsd18::common::Benchmarks::instance().add(#function, \
+        function)
+
+/**
+ * Registers a function template instantiated with an integer argument, as
+ * <function>/<argument>, to measure how a stage scales with its input.
+ */
+#define CFSD18_BENCHMARK_TEMPLATE(function, argument) \
+  bool const function##argument##IsRegistered = \
+    opendlv::logic::cfsd18::common::Benchmarks::instance().add( \
+        #function "/" #argument, function<argument>)
+
+#define CFSD18_BENCHMARK_MAIN() \
+  int32_t main(int32_t a_argc, char **a_argv) { \
+    return opendlv::logic::cfsd18::common::Benchmarks::instance().run( \
+        a_argc, a_argv); \
+  }
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace common {
+
+/**
+ * Passed to a benchmark, which repeats the measured code while keepRunning
+ * returns true. Only the time from the first call of keepRunning until it
+ * returns false is measured, so that setup is left out.
+ */
+class BenchmarkState {
+ public:
+  explicit BenchmarkState(uint64_t);
+  BenchmarkState(BenchmarkState const &) = default;
+  BenchmarkState &operator=(BenchmarkState const &) = default;
+  virtual ~BenchmarkState();
+
+  bool keepRunning();
+  uint64_t iterations() const;
+  void setItemsProcessed(uint64_t);
+  uint64_t itemsProcessed() const;
+  void skip(std::string const &);
+  std::string const &skipReason() const __attribute__((const));
+  double realTime() const;
+  double cpuTime() const;
+
+ private:
+  uint64_t m_iterations;
+  uint64_t m_remaining;
+  uint64_t m_itemsProcessed;
+  std::string m_skipReason;
+  std::chrono::steady_clock::time_point m_start;
+  std::clock_t m_cpuStart;
+  double m_realTime;
+  double m_cpuTime;
+};
+
+/**
+ * The benchmarks of an executable. Each one is run with an increasing number
+ * of iterations until it takes at least the minimum time, and the results
+ * are written as JSON in the format of Google Benchmark, so that they can be
+ * compared over time with the same tools. The flags are
+ * --benchmark_filter=<regex>, --benchmark_min_time=<s>,
+ * --benchmark_out=<file> and --benchmark_rec=<file>, a recording whose
+ * containers are available to the benchmarks as recorded inputs. With
+ * --benchmark_baseline=<file>, the real times are also compared with an
+ * earlier output, and a benchmark that got slower by more than
+ * --benchmark_threshold=<fraction> fails the run.
+ */
+class Benchmarks {
+ public:
+  typedef std::function<void(BenchmarkState &)> Function;
+
+  Benchmarks(Benchmarks const &) = delete;
+  Benchmarks &operator=(Benchmarks const &) = delete;
+  virtual ~Benchmarks();
+
+  static Benchmarks &instance();
+  bool add(std::string const &, Function);
+  int32_t run(int32_t const &, char **);
+  void write(std::ostream &, std::string const &, double) const;
+  std::vector<odcore::data::Container> recorded(int32_t) const;
+  static std::map<std::string, double> readTimes(std::istream &);
+  static std::vector<std::string> regressions(
+      std::map<std::string, double> const &,
+      std::map<std::string, double> const &, double);
+
+ private:
+  Benchmarks();
+  void measure(std::ostream &, std::string const &, Function, double) const;
+  int32_t compare(std::map<std::string, double> &, std::istream &, double,
+      double) const;
+  static std::string argument(int32_t const &, char **, std::string const &);
+
+  std::vector<std::pair<std::string, Function>> m_benchmarks;
+  std::vector<odcore::data::Container> m_recording;
+  std::string m_executable;
+};
+
+/**
+ * Keeps the compiler from optimising away a value computed in a benchmark.
+ */
+template<typename T>
+void doNotOptimize(T const &a_value)
+{
+  __asm__ __volatile__("" : : "g"(&a_value) : "memory");
+}
+
+/**
+ * Creates a microservice on a bus without mirroring, so that it can be
+ * benchmarked without a conference. The bus must outlive the microservice.
+ */
+template<typename T>
+std::unique_ptr<T> createMicroservice(InProcessBus &a_bus)
+{
+  static char name[] = "benchmark";
+  static char cid[] = "--cid=253";
+  static char *argv[] = {name, cid};
+  std::unique_ptr<T> microservice(new T(2, argv));
+  microservice->attachBus(a_bus);
+  return microservice;
+}
+
+}
+}
+}
+}
+
+#endif
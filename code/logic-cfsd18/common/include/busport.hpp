@@ -0,0 +1,99 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_COMMON_BUSPORT_HPP
+#define OPENDLV_LOGIC_CFSD18_COMMON_BUSPORT_HPP
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <opendavinci/odcore/data/Container.h>
+#include <opendavinci/odcore/data/TimeStamp.h>
+
+#include "inprocessbus.hpp"
+#include "instrumentation.hpp"
+#include "trace.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace common {
+
+/**
+ * A microservice's connection to an in-process bus. Without a bus, received
+ * containers go straight to the microservice and sent ones to the
+ * conference. With a bus, sent containers are published on it and mirrored
+ * to the conference for logging, and the mirrored copies are dropped when
+ * they come back from the conference. Containers from the bus and from the
+ * conference arrive in different threads, so delivery is serialised. The
+ * lock is recursive because a microservice sends while it is handling a
+ * container. What it sends then is only published once the handling is done
+ * and the lock released, so that no port holds its lock while another one
+ * handles a container, which would deadlock two ports publishing to each
+ * other from different threads. The time of the microservice is the clock of
+ * its bus, or the wall clock without one. The port also traces the time from when a
+ * container is delivered until the microservice sends what it caused, and,
+ * when built with instrumentation, keeps statistics of the handler time.
+ */
+class BusPort {
+ public:
+  typedef std::function<void(odcore::data::Container &)> Handler;
+
+  BusPort(Handler, Handler);
+  BusPort(BusPort const &) = delete;
+  BusPort &operator=(BusPort const &) = delete;
+  virtual ~BusPort();
+
+  void attach(InProcessBus &);
+  bool isAttached() const;
+  void receive(odcore::data::Container &);
+  void send(odcore::data::Container &);
+  odcore::data::TimeStamp now() const;
+  std::string traceReport() const;
+  void publishStatistics(std::string const &, float);
+
+ private:
+  void deliver(odcore::data::Container &);
+  void forward(odcore::data::Container &);
+  uint32_t queueDepth() const;
+
+  Handler m_receive;
+  Handler m_send;
+  InProcessBus *m_bus;
+  uint32_t m_id;
+  mutable std::recursive_mutex m_mutex;
+  std::thread::id m_deliveringThread;
+  std::mutex m_sendMutex;
+  std::vector<odcore::data::Container> m_outbox;
+  StageTrace m_stageTrace;
+#ifdef CFSD18_INSTRUMENTATION
+  HandlerStatistics m_statistics;
+#endif
+};
+
+}
+}
+}
+}
+
+#endif
@@ -0,0 +1,63 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_COMMON_CLOCK_HPP
+#define OPENDLV_LOGIC_CFSD18_COMMON_CLOCK_HPP
+
+#include <atomic>
+#include <cstdint>
+
+#include <opendavinci/odcore/data/TimeStamp.h>
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace common {
+
+/**
+ * The time of the data flowing between the microservices on one bus, used to
+ * stamp containers and to age them. It is the wall clock, unless a
+ * simulation or a replay has taken it over to step it faster than real time,
+ * so that the microservices still see the time steps of the car. Every bus
+ * has a clock of its own, so that microservices on different buses in the
+ * same process do not share their time.
+ */
+class Clock {
+ public:
+  Clock();
+  Clock(Clock const &) = delete;
+  Clock &operator=(Clock const &) = delete;
+  virtual ~Clock();
+
+  odcore::data::TimeStamp now() const;
+  void simulate(odcore::data::TimeStamp const &);
+  void release();
+  bool isSimulated() const;
+
+ private:
+  std::atomic<bool> m_isSimulated;
+  std::atomic<int64_t> m_simulatedMicroseconds;
+};
+
+}
+}
+}
+}
+
+#endif
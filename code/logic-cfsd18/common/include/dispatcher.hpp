@@ -0,0 +1,162 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_COMMON_DISPATCHER_HPP
+#define OPENDLV_LOGIC_CFSD18_COMMON_DISPATCHER_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <opendavinci/odcore/data/Container.h>
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace common {
+
+/**
+ * Maps container data types to member functions of the owner, so that a
+ * microservice finds the handler of a container with one lookup instead of
+ * comparing the data type against every message it knows. The handlers are
+ * template arguments, which turns each entry into a plain function pointer
+ * to a thunk that is resolved at compile time. The entries are kept in a flat
+ * array sorted by data type, since the message ids are only known at run
+ * time. A handler either takes the deserialised message and the container,
+ * or only the container if it may not need the message at all. Containers of
+ * types without a handler are never deserialised.
+ */
+template<typename Owner>
+class Dispatcher {
+ public:
+  Dispatcher();
+  Dispatcher(Dispatcher const &) = default;
+  Dispatcher &operator=(Dispatcher const &) = default;
+  virtual ~Dispatcher();
+
+  template<typename T, void (Owner::*Handler)(T const &, odcore::data::Container &)>
+  Dispatcher &add();
+  template<typename T, void (Owner::*Handler)(odcore::data::Container &)>
+  Dispatcher &add();
+  bool dispatch(Owner &, odcore::data::Container &) const;
+
+ private:
+  typedef void (*Thunk)(Owner &, odcore::data::Container &);
+
+  struct Entry {
+    int32_t dataType;
+    Thunk thunk;
+  };
+
+  template<typename T, void (Owner::*Handler)(T const &, odcore::data::Container &)>
+  static void deserialiseAndCall(Owner &, odcore::data::Container &);
+  template<void (Owner::*Handler)(odcore::data::Container &)>
+  static void call(Owner &, odcore::data::Container &);
+  void insert(int32_t, Thunk);
+
+  std::vector<Entry> m_entries;
+};
+
+template<typename Owner>
+Dispatcher<Owner>::Dispatcher() :
+  m_entries()
+{
+}
+
+template<typename Owner>
+Dispatcher<Owner>::~Dispatcher()
+{
+}
+
+template<typename Owner>
+template<typename T, void (Owner::*Handler)(T const &, odcore::data::Container &)>
+Dispatcher<Owner> &Dispatcher<Owner>::add()
+{
+  insert(T::ID(), &Dispatcher::deserialiseAndCall<T, Handler>);
+  return *this;
+}
+
+template<typename Owner>
+template<typename T, void (Owner::*Handler)(odcore::data::Container &)>
+Dispatcher<Owner> &Dispatcher<Owner>::add()
+{
+  insert(T::ID(), &Dispatcher::call<Handler>);
+  return *this;
+}
+
+/**
+ * Calls the handler of the container's data type, and returns false if there
+ * is none.
+ */
+template<typename Owner>
+bool Dispatcher<Owner>::dispatch(Owner &a_owner,
+    odcore::data::Container &a_container) const
+{
+  int32_t const dataType = a_container.getDataType();
+  auto it = std::lower_bound(m_entries.begin(), m_entries.end(), dataType,
+      [](Entry const &a_entry, int32_t a_dataType) {
+        return a_entry.dataType < a_dataType;
+      });
+  if (it == m_entries.end() || it->dataType != dataType) {
+    return false;
+  }
+  it->thunk(a_owner, a_container);
+  return true;
+}
+
+template<typename Owner>
+template<typename T, void (Owner::*Handler)(T const &, odcore::data::Container &)>
+void Dispatcher<Owner>::deserialiseAndCall(Owner &a_owner,
+    odcore::data::Container &a_container)
+{
+  T const message = a_container.template getData<T>();
+  (a_owner.*Handler)(message, a_container);
+}
+
+template<typename Owner>
+template<void (Owner::*Handler)(odcore::data::Container &)>
+void Dispatcher<Owner>::call(Owner &a_owner,
+    odcore::data::Container &a_container)
+{
+  (a_owner.*Handler)(a_container);
+}
+
+/**
+ * Adding a data type again replaces its handler.
+ */
+template<typename Owner>
+void Dispatcher<Owner>::insert(int32_t a_dataType, Thunk a_thunk)
+{
+  auto it = std::lower_bound(m_entries.begin(), m_entries.end(), a_dataType,
+      [](Entry const &a_entry, int32_t a_value) {
+        return a_entry.dataType < a_value;
+      });
+  if (it != m_entries.end() && it->dataType == a_dataType) {
+    it->thunk = a_thunk;
+  } else {
+    m_entries.insert(it, Entry{a_dataType, a_thunk});
+  }
+}
+
+}
+}
+}
+}
+
+#endif
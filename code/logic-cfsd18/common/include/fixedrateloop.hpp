@@ -0,0 +1,76 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_COMMON_FIXEDRATELOOP_HPP
+#define OPENDLV_LOGIC_CFSD18_COMMON_FIXEDRATELOOP_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace common {
+
+/**
+ * Runs a function at a fixed frequency on its own thread, independent of when
+ * data arrives. The start of every iteration is scheduled on an absolute time
+ * grid so that jitter does not accumulate. An iteration that ends after the
+ * start of the next one is counted as an overrun, and the grid is restarted
+ * from the current time.
+ */
+class FixedRateLoop {
+ public:
+  FixedRateLoop();
+  FixedRateLoop(FixedRateLoop const &) = delete;
+  FixedRateLoop &operator=(FixedRateLoop const &) = delete;
+  virtual ~FixedRateLoop();
+
+  void start(float, std::function<void()>);
+  void stop();
+  bool isRunning() const;
+  uint64_t iterations() const;
+  uint64_t overruns() const;
+  double meanPeriod() const;
+  double maxPeriod() const;
+  std::string statistics() const;
+
+ private:
+  void run(double);
+
+  std::function<void()> m_body;
+  std::thread m_thread;
+  std::atomic<bool> m_isRunning;
+  mutable std::mutex m_statisticsMutex;
+  uint64_t m_iterations;
+  uint64_t m_overruns;
+  double m_periodSum;
+  double m_maxPeriod;
+};
+
+}
+}
+}
+}
+
+#endif
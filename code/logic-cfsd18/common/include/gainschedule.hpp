@@ -0,0 +1,57 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_COMMON_GAINSCHEDULE_HPP
+#define OPENDLV_LOGIC_CFSD18_COMMON_GAINSCHEDULE_HPP
+
+#include <algorithm>
+#include <cstdint>
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace common {
+
+/**
+ * Gains tabulated over ground speed with a fixed step, starting at zero speed.
+ * The type is a literal aggregate so tables can be generated by constexpr
+ * functions, and lookups interpolate linearly without branching by clamping
+ * the fractional index.
+ */
+template<uint32_t N>
+struct GainSchedule {
+  float speedStep;
+  float gains[N];
+
+  float at(float a_speed) const
+  {
+    float const index = std::min(std::max(a_speed / speedStep, 0.0f),
+        static_cast<float>(N - 1));
+    uint32_t const i = std::min(static_cast<uint32_t>(index), N - 2);
+    float const t = index - static_cast<float>(i);
+    return gains[i] + t * (gains[i + 1] - gains[i]);
+  }
+};
+
+}
+}
+}
+}
+
+#endif
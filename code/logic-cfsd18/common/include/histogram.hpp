@@ -0,0 +1,69 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_COMMON_HISTOGRAM_HPP
+#define OPENDLV_LOGIC_CFSD18_COMMON_HISTOGRAM_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace common {
+
+/**
+ * Histogram with logarithmic buckets, as in HDR histograms: every power of
+ * two is split into SUB_BUCKETS linear buckets, so that any value is stored
+ * with a relative error below 1/SUB_BUCKETS. Recording is a few relaxed
+ * atomic increments, so the histogram can be read from another thread while
+ * it is recorded to.
+ */
+class Histogram {
+ public:
+  static uint32_t const SUB_BUCKET_BITS = 4;
+  static uint32_t const SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+  static uint32_t const BUCKETS = SUB_BUCKETS * (64 - SUB_BUCKET_BITS + 1);
+
+  Histogram();
+  Histogram(Histogram const &) = delete;
+  Histogram &operator=(Histogram const &) = delete;
+  virtual ~Histogram();
+
+  void record(uint64_t);
+  void reset();
+  uint64_t count() const;
+  uint64_t max() const;
+  uint64_t percentile(float) const;
+  static uint32_t bucketOf(uint64_t) __attribute__((const));
+  static uint64_t valueOf(uint32_t) __attribute__((const));
+
+ private:
+  std::array<std::atomic<uint64_t>, BUCKETS> m_counts;
+  std::atomic<uint64_t> m_count;
+  std::atomic<uint64_t> m_max;
+};
+
+}
+}
+}
+}
+
+#endif
@@ -0,0 +1,138 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_COMMON_INPROCESSBUS_HPP
+#define OPENDLV_LOGIC_CFSD18_COMMON_INPROCESSBUS_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <opendavinci/odcore/data/Container.h>
+
+#include "clock.hpp"
+#include "spscring.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace common {
+
+enum class Delivery {
+  Direct,
+  Queued
+};
+
+enum class Mirroring {
+  Conference,
+  None
+};
+
+/**
+ * In-memory bus between microservices hosted in the same process. With
+ * direct delivery, containers are handed to every other subscriber by
+ * reference in the publisher's thread. With queued delivery, every pair of
+ * publisher and subscriber has its own single-producer, single-consumer ring,
+ * and each subscriber drains its rings in a thread of its own, so that
+ * pipeline stages run concurrently. A full ring holds its publisher back
+ * until there is room, so that nothing is lost between stages. A draining
+ * thread that is held back moves the containers waiting for its own
+ * subscriber to a backlog meanwhile, since it may be what the full ring is
+ * waiting for. A queued bus that is not running drops everything published
+ * on it, and so does a publisher that is held back when the bus stops. The bus
+ * also remembers the latest ECHO_WINDOW containers published on it, by what
+ * their publisher put in them and the conference keeps, which is their data
+ * type, sample time stamp and message. The mirrored copies arriving through
+ * the conference can then be ignored however the conference stamps them,
+ * while containers of the same data types from other processes still get
+ * through. Subscribers may be added at any time,
+ * but with queued delivery those added while the bus runs are handed
+ * containers directly until it is started again. Without mirroring, the
+ * microservices on the bus never use their conference, so that they can be
+ * driven without one. The bus carries the clock of the microservices on it.
+ */
+class InProcessBus {
+ public:
+  typedef std::function<void(odcore::data::Container &)> Handler;
+  static uint32_t const RING_CAPACITY = 64;
+  static uint32_t const ECHO_WINDOW = 1024;
+
+  explicit InProcessBus(Delivery = Delivery::Direct,
+      Mirroring = Mirroring::Conference);
+  InProcessBus(InProcessBus const &) = delete;
+  InProcessBus &operator=(InProcessBus const &) = delete;
+  virtual ~InProcessBus();
+
+  uint32_t subscribe(Handler);
+  void start();
+  void stop();
+  void publish(uint32_t, odcore::data::Container &);
+  bool isEcho(odcore::data::Container const &) const;
+  bool isMirrored() const;
+  uint32_t queueDepth(uint32_t) const;
+  uint64_t dropped() const;
+  Clock &clock() __attribute__((const));
+  Clock const &clock() const __attribute__((const));
+
+ private:
+  typedef SpscRing<odcore::data::Container, RING_CAPACITY> Ring;
+  typedef std::vector<Handler> Handlers;
+  typedef std::deque<odcore::data::Container> Backlog;
+
+  std::shared_ptr<Handlers const> handlers() const;
+  static uint64_t fingerprintOf(odcore::data::Container const &);
+  void remember(odcore::data::Container const &);
+  void push(uint32_t, uint32_t, odcore::data::Container const &);
+  void drain(uint32_t);
+  uint32_t drainingSubscriber() const;
+  void moveToBacklog(uint32_t);
+  Ring &ring(uint32_t, uint32_t);
+
+  Delivery m_delivery;
+  Mirroring m_mirroring;
+  Clock m_clock;
+  mutable std::mutex m_handlersMutex;
+  std::shared_ptr<Handlers const> m_handlers;
+  std::vector<std::unique_ptr<Ring>> m_rings;
+  std::vector<std::unique_ptr<std::mutex>> m_producerMutexes;
+  std::vector<std::unique_ptr<Backlog>> m_backlogs;
+  uint32_t m_ringSubscribers;
+  mutable std::mutex m_threadsMutex;
+  std::vector<std::thread> m_threads;
+  std::atomic<bool> m_isRunning;
+  std::atomic<uint64_t> m_dropped;
+  mutable std::mutex m_echoesMutex;
+  std::vector<int32_t> m_dataTypes;
+  std::vector<uint64_t> m_echoes;
+  std::unordered_map<uint64_t, uint32_t> m_echoCounts;
+  uint32_t m_nextEcho;
+};
+
+}
+}
+}
+}
+
+#endif
@@ -0,0 +1,96 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_COMMON_INSTRUMENTATION_HPP
+#define OPENDLV_LOGIC_CFSD18_COMMON_INSTRUMENTATION_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "histogram.hpp"
+
+/**
+ * The instrumentation is only compiled in when CFSD18_INSTRUMENTATION is
+ * defined, which the INSTRUMENTATION CMake option does. Otherwise the macros
+ * expand to nothing.
+ */
+#ifdef CFSD18_INSTRUMENTATION
+#define CFSD18_TIME_SCOPE(histogram) \
+  opendlv::logic::cfsd18::common::ScopedTimer const scopedTimer(histogram)
+#define CFSD18_INSTRUMENT(statement) statement
+#else
+#define CFSD18_TIME_SCOPE(histogram)
+#define CFSD18_INSTRUMENT(statement)
+#endif
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace common {
+
+/**
+ * Records the time [ns] from its construction to its destruction.
+ */
+class ScopedTimer {
+ public:
+  explicit ScopedTimer(Histogram &);
+  ScopedTimer(ScopedTimer const &) = delete;
+  ScopedTimer &operator=(ScopedTimer const &) = delete;
+  virtual ~ScopedTimer();
+
+ private:
+  Histogram &m_histogram;
+  std::chrono::steady_clock::time_point m_start;
+};
+
+/**
+ * Statistics of the handling of incoming containers: the rate, the handler
+ * time and the largest number of containers waiting to be handled. Once
+ * published, they are written to the log and restarted every period.
+ */
+class HandlerStatistics {
+ public:
+  HandlerStatistics();
+  HandlerStatistics(HandlerStatistics const &) = delete;
+  HandlerStatistics &operator=(HandlerStatistics const &) = delete;
+  virtual ~HandlerStatistics();
+
+  Histogram &handlerTimes() __attribute__((const));
+  void publish(std::string const &, float);
+  void update(uint32_t);
+  std::string summary() const;
+
+ private:
+  void restart(std::chrono::steady_clock::time_point);
+
+  Histogram m_handlerTimes;
+  std::atomic<uint32_t> m_queueDepth;
+  std::chrono::steady_clock::time_point m_periodStart;
+  std::chrono::steady_clock::duration m_period;
+  std::string m_name;
+};
+
+}
+}
+}
+}
+
+#endif
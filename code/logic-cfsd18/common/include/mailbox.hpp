@@ -0,0 +1,106 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_COMMON_MAILBOX_HPP
+#define OPENDLV_LOGIC_CFSD18_COMMON_MAILBOX_HPP
+
+#include <cstdint>
+#include <mutex>
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace common {
+
+/**
+ * Latest-value mailbox between the thread that receives data and a control
+ * loop. Posting overwrites the previous value; the reader can either take the
+ * value only if it is newer than the one it took last, or peek at the latest
+ * value regardless.
+ */
+template<typename T>
+class Mailbox {
+ public:
+  Mailbox();
+  Mailbox(Mailbox const &) = delete;
+  Mailbox &operator=(Mailbox const &) = delete;
+  virtual ~Mailbox();
+
+  void post(T const &);
+  bool take(T &);
+  bool peek(T &) const;
+
+ private:
+  mutable std::mutex m_mutex;
+  T m_value;
+  uint64_t m_posted;
+  uint64_t m_taken;
+};
+
+template<typename T>
+Mailbox<T>::Mailbox() :
+  m_mutex(),
+  m_value(),
+  m_posted(0),
+  m_taken(0)
+{
+}
+
+template<typename T>
+Mailbox<T>::~Mailbox()
+{
+}
+
+template<typename T>
+void Mailbox<T>::post(T const &a_value)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_value = a_value;
+  m_posted++;
+}
+
+template<typename T>
+bool Mailbox<T>::take(T &a_value)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_taken == m_posted) {
+    return false;
+  }
+  a_value = m_value;
+  m_taken = m_posted;
+  return true;
+}
+
+template<typename T>
+bool Mailbox<T>::peek(T &a_value) const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_posted == 0) {
+    return false;
+  }
+  a_value = m_value;
+  return true;
+}
+
+}
+}
+}
+}
+
+#endif
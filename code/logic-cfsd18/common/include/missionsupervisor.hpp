@@ -0,0 +1,69 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_COMMON_MISSIONSUPERVISOR_HPP
+#define OPENDLV_LOGIC_CFSD18_COMMON_MISSIONSUPERVISOR_HPP
+
+#include <cstdint>
+
+#include <odvdcfsd18/GeneratedHeaders_ODVDcfsd18.h>
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace common {
+
+/**
+ * The dynamic events, numbered as the code of the SystemOperationState that
+ * selects them. Any other code means that no mission is running.
+ */
+enum class MissionId : int32_t {
+  None = 0,
+  Acceleration = 1,
+  Skidpad = 2,
+  Autocross = 3,
+  Trackdrive = 4,
+  BrakeTest = 5
+};
+
+/**
+ * Keeps track of the mission selected by the latest SystemOperationState.
+ * All planners see the same state, so exactly one of them is active at a
+ * time while the others stay idle.
+ */
+class MissionSupervisor {
+ public:
+  MissionSupervisor();
+  MissionSupervisor(MissionSupervisor const &) = default;
+  MissionSupervisor &operator=(MissionSupervisor const &) = default;
+  virtual ~MissionSupervisor();
+
+  bool update(opendlv::system::SystemOperationState const &);
+  MissionId activeMission() const;
+
+ private:
+  MissionId m_activeMission;
+};
+
+}
+}
+}
+}
+
+#endif
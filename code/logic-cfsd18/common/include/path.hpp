@@ -0,0 +1,65 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_COMMON_PATH_HPP
+#define OPENDLV_LOGIC_CFSD18_COMMON_PATH_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include <opendavinci/odcore/wrapper/Eigen.h>
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace common {
+
+/**
+ * Planned path in the vehicle frame, stored as a polyline together with the
+ * accumulated arc length at every point so that lookups by distance are a
+ * binary search. The storage is kept between frames to avoid allocations.
+ */
+class Path {
+ public:
+  Path();
+  Path(Path const &) = default;
+  Path &operator=(Path const &) = default;
+  virtual ~Path();
+
+  void clear();
+  void append(float, float);
+  uint32_t size() const;
+  float length() const;
+  Eigen::Vector2f pointAt(float) const;
+  Eigen::Vector2f extrapolatedPointAt(float) const;
+  float curvatureAt(uint32_t) const;
+  float speedLimit(float, float, float) const;
+
+ private:
+  std::vector<float> m_x;
+  std::vector<float> m_y;
+  std::vector<float> m_s;
+};
+
+}
+}
+}
+}
+
+#endif
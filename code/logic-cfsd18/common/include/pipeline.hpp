@@ -0,0 +1,336 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_COMMON_PIPELINE_HPP
+#define OPENDLV_LOGIC_CFSD18_COMMON_PIPELINE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "spscring.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace common {
+
+bool pinToCore(std::thread &, int32_t);
+
+/**
+ * Fixed pool of one thread per stage, where every frame passes through the
+ * stages in order and stage i of frame n + 1 runs while stage i + 1 of frame
+ * n does. The stages are connected by bounded rings of N frames, so a slow
+ * stage holds back the ones before it instead of letting the frames queue
+ * up, and the latency of a frame is bounded by the ring sizes. Each thread
+ * can be pinned to a core, so that the stages do not migrate and share
+ * caches with each other. A stage without frames spins briefly and then
+ * sleeps until one is handed to it, so that the threads of an idle pipeline
+ * do not keep their cores busy between frames. The last stage is where the
+ * results are used, since frames do not come back out of the pipeline.
+ */
+template<typename T, uint32_t N>
+class Pipeline {
+ public:
+  typedef std::function<void(T &)> Stage;
+
+  Pipeline();
+  Pipeline(Pipeline const &) = delete;
+  Pipeline &operator=(Pipeline const &) = delete;
+  virtual ~Pipeline();
+
+  void add(Stage, int32_t = -1);
+  void start();
+  void stop();
+  bool isRunning() const;
+  bool tryPush(T &&);
+  void push(T &&);
+  void drain() const;
+  uint64_t completed() const;
+  uint64_t dropped() const;
+  std::string statistics() const;
+
+ private:
+  typedef SpscRing<T, N> Ring;
+
+  void run(uint32_t);
+  void wait(uint32_t, uint32_t &);
+  void wake();
+  static void backOff(uint32_t &);
+
+  std::vector<Stage> m_stages;
+  std::vector<int32_t> m_cores;
+  std::vector<std::unique_ptr<Ring>> m_rings;
+  std::vector<std::thread> m_threads;
+  std::atomic<bool> m_isRunning;
+  std::atomic<uint64_t> m_pushed;
+  std::atomic<uint64_t> m_completed;
+  std::atomic<uint64_t> m_dropped;
+  uint32_t m_pinned;
+  std::mutex m_wakeMutex;
+  std::condition_variable m_wake;
+  std::atomic<uint32_t> m_sleepers;
+};
+
+template<typename T, uint32_t N>
+Pipeline<T, N>::Pipeline() :
+  m_stages(),
+  m_cores(),
+  m_rings(),
+  m_threads(),
+  m_isRunning(false),
+  m_pushed(0),
+  m_completed(0),
+  m_dropped(0),
+  m_pinned(0),
+  m_wakeMutex(),
+  m_wake(),
+  m_sleepers(0)
+{
+}
+
+template<typename T, uint32_t N>
+Pipeline<T, N>::~Pipeline()
+{
+  stop();
+}
+
+/**
+ * Appends a stage, run on the given core, or on any core if negative. All
+ * stages are added before the pipeline is started.
+ */
+template<typename T, uint32_t N>
+void Pipeline<T, N>::add(Stage a_stage, int32_t a_core)
+{
+  m_stages.push_back(a_stage);
+  m_cores.push_back(a_core);
+}
+
+/**
+ * Allocates the rings in front of every stage and starts the threads.
+ */
+template<typename T, uint32_t N>
+void Pipeline<T, N>::start()
+{
+  if (m_isRunning || m_stages.empty()) {
+    return;
+  }
+  m_rings.clear();
+  for (uint32_t i = 0; i < m_stages.size(); i++) {
+    m_rings.push_back(std::unique_ptr<Ring>(new Ring));
+  }
+  m_isRunning = true;
+  m_pinned = 0;
+  for (uint32_t i = 0; i < m_stages.size(); i++) {
+    m_threads.push_back(std::thread(&Pipeline::run, this, i));
+    if (m_cores[i] >= 0 && pinToCore(m_threads.back(), m_cores[i])) {
+      m_pinned++;
+    }
+  }
+}
+
+/**
+ * Stops the threads, and drops the frames that are still in the pipeline.
+ */
+template<typename T, uint32_t N>
+void Pipeline<T, N>::stop()
+{
+  m_isRunning = false;
+  {
+    std::lock_guard<std::mutex> lock(m_wakeMutex);
+    m_wake.notify_all();
+  }
+  for (auto &thread : m_threads) {
+    thread.join();
+  }
+  m_threads.clear();
+}
+
+template<typename T, uint32_t N>
+bool Pipeline<T, N>::isRunning() const
+{
+  return m_isRunning;
+}
+
+/**
+ * Hands a frame to the first stage, or drops it if that stage is still
+ * behind by N frames, so that the caller is never blocked. Only one thread
+ * may push at a time.
+ */
+template<typename T, uint32_t N>
+bool Pipeline<T, N>::tryPush(T &&a_frame)
+{
+  if (m_isRunning && m_rings.front()->tryPush(std::move(a_frame))) {
+    m_pushed++;
+    wake();
+    return true;
+  }
+  m_dropped++;
+  return false;
+}
+
+/**
+ * Hands a frame to the first stage, and waits while that stage is behind.
+ */
+template<typename T, uint32_t N>
+void Pipeline<T, N>::push(T &&a_frame)
+{
+  uint32_t spins = 0;
+  while (m_isRunning) {
+    if (m_rings.front()->tryPush(std::move(a_frame))) {
+      m_pushed++;
+      wake();
+      return;
+    }
+    backOff(spins);
+  }
+  m_dropped++;
+}
+
+/**
+ * Waits until every frame that was pushed has left the last stage.
+ */
+template<typename T, uint32_t N>
+void Pipeline<T, N>::drain() const
+{
+  uint32_t spins = 0;
+  while (m_isRunning && m_completed < m_pushed) {
+    backOff(spins);
+  }
+}
+
+template<typename T, uint32_t N>
+uint64_t Pipeline<T, N>::completed() const
+{
+  return m_completed;
+}
+
+template<typename T, uint32_t N>
+uint64_t Pipeline<T, N>::dropped() const
+{
+  return m_dropped;
+}
+
+template<typename T, uint32_t N>
+std::string Pipeline<T, N>::statistics() const
+{
+  std::stringstream statistics;
+  statistics << m_stages.size() << " stages on " << m_pinned
+    << " pinned cores, " << completed() << " frames completed, "
+    << dropped() << " dropped";
+  return statistics.str();
+}
+
+/**
+ * Takes frames from the ring in front of a stage, runs the stage on them and
+ * hands them on. It waits for the stage before while there is nothing to do,
+ * and backs off while the next stage is full.
+ */
+template<typename T, uint32_t N>
+void Pipeline<T, N>::run(uint32_t a_stage)
+{
+  bool const isLast = a_stage + 1 == m_stages.size();
+  uint32_t spins = 0;
+  T frame;
+  while (m_isRunning) {
+    if (!m_rings[a_stage]->tryPop(frame)) {
+      wait(a_stage, spins);
+      continue;
+    }
+    spins = 0;
+    m_stages[a_stage](frame);
+    if (isLast) {
+      m_completed++;
+      continue;
+    }
+    while (!m_rings[a_stage + 1]->tryPush(std::move(frame))) {
+      if (!m_isRunning) {
+        return;
+      }
+      backOff(spins);
+    }
+    wake();
+    spins = 0;
+  }
+}
+
+/**
+ * Spins while frames may still be close behind, and then sleeps until a
+ * frame is handed to the stage or the pipeline stops. The sleep is also
+ * bounded, so that a stage never depends on being woken to make progress.
+ */
+template<typename T, uint32_t N>
+void Pipeline<T, N>::wait(uint32_t a_stage, uint32_t &a_spins)
+{
+  uint32_t const maxSpins = 1000;
+  if (a_spins < maxSpins) {
+    a_spins++;
+    std::this_thread::yield();
+    return;
+  }
+  std::unique_lock<std::mutex> lock(m_wakeMutex);
+  m_sleepers++;
+  m_wake.wait_for(lock, std::chrono::milliseconds(10), [this, a_stage]() {
+      return !m_isRunning || !m_rings[a_stage]->isEmpty();
+    });
+  m_sleepers--;
+}
+
+/**
+ * Wakes the sleeping stages after a frame was handed on. The fence orders
+ * the frame before the check for sleepers, as going to sleep orders it the
+ * other way round, so that a stage either sees the frame or is woken.
+ */
+template<typename T, uint32_t N>
+void Pipeline<T, N>::wake()
+{
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (m_sleepers > 0) {
+    std::lock_guard<std::mutex> lock(m_wakeMutex);
+    m_wake.notify_all();
+  }
+}
+
+template<typename T, uint32_t N>
+void Pipeline<T, N>::backOff(uint32_t &a_spins)
+{
+  uint32_t const maxSpins = 1000;
+  if (a_spins < maxSpins) {
+    a_spins++;
+    std::this_thread::yield();
+  } else {
+    std::this_thread::sleep_for(std::chrono::microseconds(50));
+  }
+}
+
+}
+}
+}
+}
+
+#endif
@@ -0,0 +1,240 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_COMMON_PLANNER_HPP
+#define OPENDLV_LOGIC_CFSD18_COMMON_PLANNER_HPP
+
+#include <cmath>
+#include <cstdint>
+
+#include <opendavinci/odcore/data/Container.h>
+#include <opendavinci/odcore/data/TimeStamp.h>
+
+#include <odvdcfsd18/GeneratedHeaders_ODVDcfsd18.h>
+
+#include "dispatcher.hpp"
+#include "missionsupervisor.hpp"
+#include "path.hpp"
+#include "trace.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace common {
+
+/**
+ * Planner core shared by the cognition planners. It builds the path from the
+ * incoming surfaces, keeps the vehicle state and sends the aim point, preview
+ * point and speed limit while the mission selected by the SystemOperationState
+ * is served by this planner, and stays idle otherwise. Everything that
+ * differs between the missions is provided by the Mission type, which is
+ * resolved at compile time and must implement:
+ *
+ *   static bool serves(MissionId);
+ *   static bool isPreviewExtrapolated();
+ *   float aimDistance(Path const &, float groundSpeed) const;
+ *   float previewDistance(Path const &, float groundSpeed) const;
+ *   float speedLimit(Path const &, float groundSpeed) const;
+ */
+template<typename Mission>
+class Planner {
+ public:
+  explicit Planner(Mission const &);
+  Planner(Planner const &) = default;
+  Planner &operator=(Planner const &) = default;
+  virtual ~Planner();
+
+  template<typename Send>
+  void nextContainer(odcore::data::Container &, Send);
+  void setMission(Mission const &);
+  bool isActive() const;
+  Path const &path() const;
+
+ private:
+  void onSurface(odcore::data::Container &);
+  void onGroundSpeedReading(opendlv::proxy::GroundSpeedReading const &,
+      odcore::data::Container &);
+  void onSystemOperationState(opendlv::system::SystemOperationState const &,
+      odcore::data::Container &);
+  void addSurface(opendlv::logic::perception::Surface const &);
+  template<typename Send>
+  void plan(Send);
+  template<typename Send>
+  void send(odcore::data::Container, Send);
+
+  Dispatcher<Planner> m_dispatcher;
+  Mission m_mission;
+  MissionSupervisor m_missionSupervisor;
+  bool m_isActive;
+  bool m_isPlanDue;
+  Path m_path;
+  uint32_t m_lastSurfaceId;
+  float m_groundSpeed;
+  odcore::data::TimeStamp m_origin;
+};
+
+template<typename Mission>
+Planner<Mission>::Planner(Mission const &a_mission) :
+  m_dispatcher(),
+  m_mission(a_mission),
+  m_missionSupervisor(),
+  m_isActive(false),
+  m_isPlanDue(false),
+  m_path(),
+  m_lastSurfaceId(0),
+  m_groundSpeed(0.0f),
+  m_origin()
+{
+  m_dispatcher
+    .template add<opendlv::logic::perception::Surface, &Planner::onSurface>()
+    .template add<opendlv::proxy::GroundSpeedReading, &Planner::onGroundSpeedReading>()
+    .template add<opendlv::system::SystemOperationState, &Planner::onSystemOperationState>();
+}
+
+template<typename Mission>
+Planner<Mission>::~Planner()
+{
+}
+
+/**
+ * Handles a container, and plans with the new path if it was extended.
+ */
+template<typename Mission>
+template<typename Send>
+void Planner<Mission>::nextContainer(odcore::data::Container &a_container, Send a_send)
+{
+  m_dispatcher.dispatch(*this, a_container);
+  if (m_isPlanDue) {
+    m_isPlanDue = false;
+    plan(a_send);
+  }
+}
+
+template<typename Mission>
+void Planner<Mission>::setMission(Mission const &a_mission)
+{
+  m_mission = a_mission;
+}
+
+template<typename Mission>
+bool Planner<Mission>::isActive() const
+{
+  return m_isActive;
+}
+
+template<typename Mission>
+Path const &Planner<Mission>::path() const
+{
+  return m_path;
+}
+
+/**
+ * The plan is caused by the latest surface, so it inherits its origin. The
+ * surface is only deserialised while the planner is active.
+ */
+template<typename Mission>
+void Planner<Mission>::onSurface(odcore::data::Container &a_container)
+{
+  if (!m_isActive) {
+    return;
+  }
+  addSurface(a_container.getData<opendlv::logic::perception::Surface>());
+  m_origin = originOf(a_container);
+  m_isPlanDue = true;
+}
+
+template<typename Mission>
+void Planner<Mission>::onGroundSpeedReading(
+    opendlv::proxy::GroundSpeedReading const &a_groundSpeedReading,
+    odcore::data::Container &)
+{
+  m_groundSpeed = a_groundSpeedReading.getGroundSpeed();
+}
+
+template<typename Mission>
+void Planner<Mission>::onSystemOperationState(
+    opendlv::system::SystemOperationState const &a_systemOperationState,
+    odcore::data::Container &)
+{
+  if (m_missionSupervisor.update(a_systemOperationState)) {
+    m_isActive = Mission::serves(m_missionSupervisor.activeMission());
+    m_path.clear();
+  }
+}
+
+/**
+ * Surfaces are sent from the car and outwards, each one spanned by a near
+ * (first and second corner) and a far (third and fourth corner) pair of
+ * cones. The path runs through the midpoints of the pairs, and a surface id
+ * that does not increase starts a new path.
+ */
+template<typename Mission>
+void Planner<Mission>::addSurface(opendlv::logic::perception::Surface const &a_surface)
+{
+  uint32_t const surfaceId = a_surface.getSurfaceId();
+  if (m_path.size() == 0 || surfaceId <= m_lastSurfaceId) {
+    m_path.clear();
+    m_path.append(0.0f, 0.0f);
+    m_path.append(0.5f * (a_surface.getX1() + a_surface.getX2()),
+        0.5f * (a_surface.getY1() + a_surface.getY2()));
+  }
+  m_path.append(0.5f * (a_surface.getX3() + a_surface.getX4()),
+      0.5f * (a_surface.getY3() + a_surface.getY4()));
+  m_lastSurfaceId = surfaceId;
+}
+
+template<typename Mission>
+template<typename Send>
+void Planner<Mission>::plan(Send a_send)
+{
+  Eigen::Vector2f const aimPoint =
+    m_path.pointAt(m_mission.aimDistance(m_path, m_groundSpeed));
+  float const previewDistance =
+    m_mission.previewDistance(m_path, m_groundSpeed);
+  Eigen::Vector2f const previewPoint = Mission::isPreviewExtrapolated()
+    ? m_path.extrapolatedPointAt(previewDistance)
+    : m_path.pointAt(previewDistance);
+  float const speedLimit = m_mission.speedLimit(m_path, m_groundSpeed);
+
+  opendlv::logic::action::AimPoint o1(std::atan2(aimPoint(1), aimPoint(0)),
+      0.0f, aimPoint.norm());
+  send(odcore::data::Container(o1), a_send);
+
+  opendlv::logic::action::PreviewPoint o2(
+      std::atan2(previewPoint(1), previewPoint(0)), 0.0f, previewPoint.norm());
+  send(odcore::data::Container(o2), a_send);
+
+  opendlv::logic::cognition::GroundSpeedLimit o3(speedLimit);
+  send(odcore::data::Container(o3), a_send);
+}
+
+template<typename Mission>
+template<typename Send>
+void Planner<Mission>::send(odcore::data::Container a_container, Send a_send)
+{
+  a_container.setSampleTimeStamp(m_origin);
+  a_send(a_container);
+}
+
+}
+}
+}
+}
+
+#endif
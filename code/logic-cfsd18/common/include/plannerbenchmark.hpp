@@ -0,0 +1,84 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_COMMON_PLANNERBENCHMARK_HPP
+#define OPENDLV_LOGIC_CFSD18_COMMON_PLANNERBENCHMARK_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include <opendavinci/odcore/data/Container.h>
+
+#include <odvdcfsd18/GeneratedHeaders_ODVDcfsd18.h>
+
+#include "benchmark.hpp"
+#include "inprocessbus.hpp"
+#include "missionsupervisor.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace common {
+
+std::vector<odcore::data::Container> arcSurfaces(float);
+
+/**
+ * Benchmarks a planner microservice in the given mission by having it plan
+ * once for every surface, with the surfaces repeated as often as needed.
+ */
+template<typename T>
+void planSurfaces(BenchmarkState &a_state, MissionId a_mission,
+    std::vector<odcore::data::Container> &a_surfaces)
+{
+  InProcessBus bus(Delivery::Direct, Mirroring::None);
+  auto planner = createMicroservice<T>(bus);
+  opendlv::system::SystemOperationState systemOperationState(
+      static_cast<int32_t>(a_mission), "");
+  odcore::data::Container mission(systemOperationState);
+  planner->nextContainer(mission);
+
+  uint64_t i = 0;
+  while (a_state.keepRunning()) {
+    planner->nextContainer(a_surfaces[i++ % a_surfaces.size()]);
+  }
+  a_state.setItemsProcessed(a_state.iterations());
+}
+
+/**
+ * The same on the surfaces of the recording, or skipped without them.
+ */
+template<typename T>
+void planRecordedSurfaces(BenchmarkState &a_state, MissionId a_mission)
+{
+  std::vector<odcore::data::Container> surfaces =
+    Benchmarks::instance().recorded(
+        opendlv::logic::perception::Surface::ID());
+  if (surfaces.empty()) {
+    a_state.skip("No recorded surfaces.");
+    return;
+  }
+  planSurfaces<T>(a_state, a_mission, surfaces);
+}
+
+}
+}
+}
+}
+
+#endif
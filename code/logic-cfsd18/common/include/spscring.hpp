@@ -0,0 +1,196 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_COMMON_SPSCRING_HPP
+#define OPENDLV_LOGIC_CFSD18_COMMON_SPSCRING_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <utility>
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace common {
+
+/**
+ * Bounded single-producer, single-consumer ring of preallocated slots. The
+ * try operations are wait-free; the blocking ones spin briefly and then back
+ * off with short sleeps. The producer and consumer indices live on separate
+ * cache lines, and each side keeps a cached copy of the other side's index so
+ * that the shared line is only read when the ring looks full or empty.
+ * Padding arrays are used instead of alignas, since C++14 operator new does
+ * not honour over-alignment.
+ */
+template<typename T, uint32_t N>
+class SpscRing {
+  static_assert(N >= 2 && (N & (N - 1)) == 0,
+      "The ring capacity must be a power of two.");
+
+ public:
+  SpscRing();
+  SpscRing(SpscRing const &) = delete;
+  SpscRing &operator=(SpscRing const &) = delete;
+  virtual ~SpscRing();
+
+  bool tryPush(T &&);
+  bool tryPush(T const &);
+  bool tryPop(T &);
+  void push(T &&);
+  void push(T const &);
+  void pop(T &);
+  bool isEmpty() const;
+  uint32_t size() const;
+
+ private:
+  static uint32_t const CACHE_LINE = 64;
+
+  static void backOff(uint32_t &);
+
+  std::array<T, N> m_slots;
+  char m_padding0[CACHE_LINE];
+  std::atomic<uint32_t> m_head;
+  uint32_t m_cachedTail;
+  char m_padding1[CACHE_LINE - sizeof(std::atomic<uint32_t>) - sizeof(uint32_t)];
+  std::atomic<uint32_t> m_tail;
+  uint32_t m_cachedHead;
+  char m_padding2[CACHE_LINE - sizeof(std::atomic<uint32_t>) - sizeof(uint32_t)];
+};
+
+template<typename T, uint32_t N>
+SpscRing<T, N>::SpscRing() :
+  m_slots(),
+  m_padding0(),
+  m_head(0),
+  m_cachedTail(0),
+  m_padding1(),
+  m_tail(0),
+  m_cachedHead(0),
+  m_padding2()
+{
+}
+
+template<typename T, uint32_t N>
+SpscRing<T, N>::~SpscRing()
+{
+}
+
+template<typename T, uint32_t N>
+bool SpscRing<T, N>::tryPush(T &&a_value)
+{
+  uint32_t const tail = m_tail.load(std::memory_order_relaxed);
+  if (tail - m_cachedHead == N) {
+    m_cachedHead = m_head.load(std::memory_order_acquire);
+    if (tail - m_cachedHead == N) {
+      return false;
+    }
+  }
+  m_slots[tail & (N - 1)] = std::move(a_value);
+  m_tail.store(tail + 1, std::memory_order_release);
+  return true;
+}
+
+template<typename T, uint32_t N>
+bool SpscRing<T, N>::tryPush(T const &a_value)
+{
+  T copy(a_value);
+  return tryPush(std::move(copy));
+}
+
+template<typename T, uint32_t N>
+bool SpscRing<T, N>::tryPop(T &a_value)
+{
+  uint32_t const head = m_head.load(std::memory_order_relaxed);
+  if (head == m_cachedTail) {
+    m_cachedTail = m_tail.load(std::memory_order_acquire);
+    if (head == m_cachedTail) {
+      return false;
+    }
+  }
+  a_value = std::move(m_slots[head & (N - 1)]);
+  m_head.store(head + 1, std::memory_order_release);
+  return true;
+}
+
+template<typename T, uint32_t N>
+void SpscRing<T, N>::push(T &&a_value)
+{
+  uint32_t spins = 0;
+  while (!tryPush(std::move(a_value))) {
+    backOff(spins);
+  }
+}
+
+template<typename T, uint32_t N>
+void SpscRing<T, N>::push(T const &a_value)
+{
+  T copy(a_value);
+  push(std::move(copy));
+}
+
+template<typename T, uint32_t N>
+void SpscRing<T, N>::pop(T &a_value)
+{
+  uint32_t spins = 0;
+  while (!tryPop(a_value)) {
+    backOff(spins);
+  }
+}
+
+/**
+ * Only meaningful to the consumer; the producer may add entries at any time.
+ */
+template<typename T, uint32_t N>
+bool SpscRing<T, N>::isEmpty() const
+{
+  return m_head.load(std::memory_order_relaxed)
+    == m_tail.load(std::memory_order_acquire);
+}
+
+/**
+ * The number of values in the ring, which is only exact for the consumer.
+ */
+template<typename T, uint32_t N>
+uint32_t SpscRing<T, N>::size() const
+{
+  return m_tail.load(std::memory_order_acquire)
+    - m_head.load(std::memory_order_relaxed);
+}
+
+template<typename T, uint32_t N>
+void SpscRing<T, N>::backOff(uint32_t &a_spins)
+{
+  uint32_t const maxSpins = 1000;
+  if (a_spins < maxSpins) {
+    a_spins++;
+    std::this_thread::yield();
+  } else {
+    std::this_thread::sleep_for(std::chrono::microseconds(50));
+  }
+}
+
+}
+}
+}
+}
+
+#endif
@@ -0,0 +1,86 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_COMMON_SYNTHETICSENSOR_HPP
+#define OPENDLV_LOGIC_CFSD18_COMMON_SYNTHETICSENSOR_HPP
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <opendavinci/odcore/data/Container.h>
+#include <opendavinci/odcore/wrapper/Eigen.h>
+#include <opendavinci/generated/odcore/data/CompactPointCloud.h>
+
+#include <odvdcfsd18/GeneratedHeaders_ODVDcfsd18.h>
+
+#include "synthetictrack.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace common {
+
+/**
+ * Sensor data of a synthetic track as seen from a pose on it, as the lidar
+ * and the cone detection would send it: point clouds, object lists, the
+ * surfaces ahead and the geolocation. Ranges and angles get Gaussian noise
+ * and points and cones are dropped with the given probability, with a seeded
+ * generator so that a run can be repeated.
+ */
+class SyntheticSensor {
+ public:
+  static uint32_t const LAYERS = 16;
+  static uint32_t const COLUMNS = 1800;
+
+  SyntheticSensor(uint32_t, float, float, float, float);
+  SyntheticSensor(SyntheticSensor const &) = default;
+  SyntheticSensor &operator=(SyntheticSensor const &) = default;
+  virtual ~SyntheticSensor();
+
+  static float elevation(uint32_t) __attribute__((const));
+  odcore::data::CompactPointCloud scan(SyntheticTrack const &,
+      Eigen::Vector3f const &);
+  std::vector<odcore::data::Container> objects(SyntheticTrack const &,
+      Eigen::Vector3f const &);
+  std::vector<odcore::data::Container> surfaces(SyntheticTrack const &,
+      Eigen::Vector3f const &, float, uint32_t) const;
+  opendlv::logic::sensation::Geolocation geolocation(Eigen::Vector3f const &);
+
+ private:
+  float withRangeNoise(float);
+  float withAngleNoise(float);
+  bool isDropped();
+
+  std::mt19937 m_generator;
+  std::normal_distribution<float> m_normal;
+  std::uniform_real_distribution<float> m_uniform;
+  float m_range;
+  float m_rangeNoise;
+  float m_angleNoise;
+  float m_dropout;
+  std::vector<float> m_distances;
+};
+
+}
+}
+}
+}
+
+#endif
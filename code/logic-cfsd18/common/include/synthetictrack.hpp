@@ -0,0 +1,93 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_COMMON_SYNTHETICTRACK_HPP
+#define OPENDLV_LOGIC_CFSD18_COMMON_SYNTHETICTRACK_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include <opendavinci/odcore/wrapper/Eigen.h>
+
+#include "path.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace common {
+
+/**
+ * Cone colours as in the rules, blue on the left and yellow on the right of
+ * the track, sent as the type of an object.
+ */
+enum class ConeType : uint32_t {
+  Blue = 1,
+  Yellow = 2,
+  Orange = 3,
+  BigOrange = 4
+};
+
+/**
+ * Procedurally generated track in the style of the Formula Student Germany
+ * layouts, given by its cones and the centreline that the car drives. The
+ * tracks are deterministic, so that benchmarks on them are comparable
+ * between runs, and the trackdrive layout scales to any length.
+ */
+class SyntheticTrack {
+ public:
+  static float const WIDTH;
+  static float const CONE_SPACING;
+  static float const MIN_RADIUS;
+
+  SyntheticTrack();
+  SyntheticTrack(SyntheticTrack const &) = default;
+  SyntheticTrack &operator=(SyntheticTrack const &) = default;
+  virtual ~SyntheticTrack();
+
+  static SyntheticTrack acceleration();
+  static SyntheticTrack skidpad();
+  static SyntheticTrack trackdrive(float, uint32_t);
+
+  void addCone(float, float, ConeType);
+  void extendCentreline(float, float);
+  uint32_t coneCount() const;
+  Eigen::Vector2f cone(uint32_t) const;
+  ConeType coneType(uint32_t) const;
+  Path const &centreline() const __attribute__((const));
+  bool isClosed() const;
+  Eigen::Vector3f poseAt(float) const;
+  Eigen::Vector2f boundaryAt(float, float) const;
+  float distanceAlong(Eigen::Vector2f const &, float, float) const;
+  std::vector<float> drive(float, float, float) const;
+
+ private:
+  void addBoundaryCones(ConeType, ConeType);
+
+  std::vector<float> m_x;
+  std::vector<float> m_y;
+  std::vector<ConeType> m_type;
+  Path m_centreline;
+};
+
+}
+}
+}
+}
+
+#endif
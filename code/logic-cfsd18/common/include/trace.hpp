@@ -0,0 +1,79 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_COMMON_TRACE_HPP
+#define OPENDLV_LOGIC_CFSD18_COMMON_TRACE_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <opendavinci/odcore/data/Container.h>
+#include <opendavinci/odcore/data/TimeStamp.h>
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace common {
+
+/**
+ * The origin of a container is the time its data was sampled: the sample
+ * time stamp if the sender set one, and otherwise the time it was sent.
+ * Every microservice gives the containers it sends the origin of the
+ * container that caused them, so that a steering request can be traced back
+ * to the point cloud it was computed from.
+ */
+odcore::data::TimeStamp originOf(odcore::data::Container &);
+void propagateOrigin(odcore::data::Container &, odcore::data::Container &);
+double percentile(std::vector<double>, float);
+
+/**
+ * Times spent in one pipeline stage, from when a container enters the
+ * microservice until the container it causes is sent, and from the origin
+ * until then. The latest CAPACITY samples of each are kept.
+ */
+class StageTrace {
+ public:
+  static uint32_t const CAPACITY = 1024;
+
+  StageTrace();
+  StageTrace(StageTrace const &) = default;
+  StageTrace &operator=(StageTrace const &) = default;
+  virtual ~StageTrace();
+
+  void enter();
+  void exit(odcore::data::Container &, odcore::data::TimeStamp const &);
+  uint32_t size() const;
+  double stagePercentile(float) const;
+  double totalPercentile(float) const;
+  std::string report() const;
+
+ private:
+  odcore::data::TimeStamp m_enterTime;
+  std::vector<double> m_stageTimes;
+  std::vector<double> m_totalTimes;
+  uint32_t m_next;
+};
+
+}
+}
+}
+}
+
+#endif
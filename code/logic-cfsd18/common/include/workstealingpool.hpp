@@ -0,0 +1,89 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_COMMON_WORKSTEALINGPOOL_HPP
+#define OPENDLV_LOGIC_CFSD18_COMMON_WORKSTEALINGPOOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace common {
+
+/**
+ * Fixed pool of workers for loops whose iterations are independent. The
+ * indices of a loop are split into one contiguous block per worker, which
+ * runs it from the front, and a worker that runs out of its own takes from
+ * the back of another worker's block, so that uneven iterations are balanced
+ * without a shared queue. The thread that runs a loop is one of the
+ * workers, and every iteration is told which worker runs it, so that workers
+ * can keep scratch memory of their own.
+ */
+class WorkStealingPool {
+ public:
+  typedef std::function<void(uint32_t, uint32_t)> Task;
+
+  explicit WorkStealingPool(uint32_t);
+  WorkStealingPool(WorkStealingPool const &) = delete;
+  WorkStealingPool &operator=(WorkStealingPool const &) = delete;
+  virtual ~WorkStealingPool();
+
+  uint32_t size() const;
+  void parallelFor(uint32_t, Task);
+  uint64_t steals() const;
+
+ private:
+  struct Queue {
+    Queue();
+
+    std::mutex mutex;
+    std::deque<uint32_t> indices;
+  };
+
+  void run(uint32_t);
+  void work(uint32_t, Task const &);
+  bool take(uint32_t, uint32_t &);
+
+  std::vector<std::unique_ptr<Queue>> m_queues;
+  std::vector<std::thread> m_threads;
+  std::mutex m_mutex;
+  std::condition_variable m_start;
+  std::condition_variable m_finish;
+  Task m_task;
+  uint64_t m_generation;
+  uint32_t m_busy;
+  bool m_isRunning;
+  std::atomic<uint64_t> m_steals;
+};
+
+}
+}
+}
+}
+
+#endif
@@ -0,0 +1,164 @@
+/**
+* Copyright (C) 2017 Chalmers Revere
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+* USA.
+*/
+
+#include <algorithm>
+#include <cstring>
+
+#include "arena.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace common {
+
+/**
+ * Takes the size [bytes] of the first block.
+ */
+Arena::Arena(uint64_t a_size) :
+  m_blocks(),
+  m_blockSizes(),
+  m_next(nullptr),
+  m_remaining(0),
+  m_capacity(0),
+  m_used(0),
+  m_blockAllocations(0),
+  m_depth(0)
+{
+  addBlock(std::max(a_size, static_cast<uint64_t>(64)));
+}
+
+Arena::~Arena()
+{
+}
+
+/**
+ * Memory of the given size [bytes] and alignment, which is a power of two.
+ */
+void *Arena::allocate(uint64_t a_size, uint64_t a_alignment)
+{
+  uint64_t const address = reinterpret_cast<uint64_t>(m_next);
+  uint64_t padding = (a_alignment - address % a_alignment) % a_alignment;
+  if (padding + a_size > m_remaining) {
+    addBlock(std::max(a_size + a_alignment, 2 * m_blockSizes.back()));
+    padding = (a_alignment - reinterpret_cast<uint64_t>(m_next) % a_alignment)
+      % a_alignment;
+  }
+  char *memory = m_next + padding;
+  m_next = memory + a_size;
+  m_remaining -= padding + a_size;
+  m_used += padding + a_size;
+  return memory;
+}
+
+/**
+ * Ends the frame, after which nothing that was allocated may be used.
+ */
+void Arena::reset()
+{
+  if (m_blocks.size() > 1) {
+    uint64_t const capacity = m_capacity;
+    m_blocks.clear();
+    m_blockSizes.clear();
+    m_capacity = 0;
+    addBlock(capacity);
+  }
+  m_next = m_blocks.back().get();
+  m_remaining = m_blockSizes.back();
+  m_used = 0;
+}
+
+/**
+ * Starts a frame, which may be inside another one.
+ */
+void Arena::enter()
+{
+  m_depth++;
+}
+
+/**
+ * Ends a frame. The arena is only reset when the outermost frame ends, since
+ * the temporaries of the frames around it are still in use.
+ */
+void Arena::leave()
+{
+  m_depth--;
+  if (m_depth == 0) {
+    reset();
+  }
+}
+
+/**
+ * The number of frames that have been entered and not left.
+ */
+uint32_t Arena::depth() const
+{
+  return m_depth;
+}
+
+/**
+ * Size [bytes] of all blocks.
+ */
+uint64_t Arena::capacity() const
+{
+  return m_capacity;
+}
+
+/**
+ * Size [bytes] allocated in this frame, including padding.
+ */
+uint64_t Arena::used() const
+{
+  return m_used;
+}
+
+/**
+ * The number of blocks that were allocated from the heap, which stops
+ * growing once the arena is warm.
+ */
+uint64_t Arena::blockAllocations() const
+{
+  return m_blockAllocations;
+}
+
+void Arena::addBlock(uint64_t a_size)
+{
+  m_blocks.push_back(std::unique_ptr<char[]>(new char[a_size]));
+  m_blockSizes.push_back(a_size);
+  std::memset(m_blocks.back().get(), 0, a_size);
+  m_next = m_blocks.back().get();
+  m_remaining = a_size;
+  m_capacity += a_size;
+  m_blockAllocations++;
+}
+
+ArenaFrame::ArenaFrame(Arena &a_arena) :
+  m_arena(a_arena)
+{
+  m_arena.enter();
+}
+
+ArenaFrame::~ArenaFrame()
+{
+  m_arena.leave();
+}
+
+}
+}
+}
+}
@@ -0,0 +1,428 @@
+/**
+* Copyright (C) 2017 Chalmers Revere
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+* USA.
+*/
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <regex>
+#include <sstream>
+#include <thread>
+
+#include "benchmark.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace common {
+
+BenchmarkState::BenchmarkState(uint64_t a_iterations) :
+  m_iterations(a_iterations),
+  m_remaining(a_iterations),
+  m_itemsProcessed(0),
+  m_skipReason(),
+  m_start(),
+  m_cpuStart(0),
+  m_realTime(0.0),
+  m_cpuTime(0.0)
+{
+}
+
+BenchmarkState::~BenchmarkState()
+{
+}
+
+/**
+ * Starts the clocks on the first call, and stops them when the iterations
+ * are done or the benchmark was skipped.
+ */
+bool BenchmarkState::keepRunning()
+{
+  if (m_remaining == m_iterations) {
+    m_start = std::chrono::steady_clock::now();
+    m_cpuStart = std::clock();
+  }
+  if (m_remaining > 0 && m_skipReason.empty()) {
+    m_remaining--;
+    return true;
+  }
+  m_realTime = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - m_start).count();
+  m_cpuTime = static_cast<double>(std::clock() - m_cpuStart)
+    / static_cast<double>(CLOCKS_PER_SEC);
+  return false;
+}
+
+uint64_t BenchmarkState::iterations() const
+{
+  return m_iterations;
+}
+
+void BenchmarkState::setItemsProcessed(uint64_t a_itemsProcessed)
+{
+  m_itemsProcessed = a_itemsProcessed;
+}
+
+uint64_t BenchmarkState::itemsProcessed() const
+{
+  return m_itemsProcessed;
+}
+
+/**
+ * Marks the benchmark as not run, for example when its recorded inputs are
+ * missing.
+ */
+void BenchmarkState::skip(std::string const &a_reason)
+{
+  m_skipReason = a_reason;
+}
+
+std::string const &BenchmarkState::skipReason() const
+{
+  return m_skipReason;
+}
+
+double BenchmarkState::realTime() const
+{
+  return m_realTime;
+}
+
+double BenchmarkState::cpuTime() const
+{
+  return m_cpuTime;
+}
+
+Benchmarks::Benchmarks() :
+  m_benchmarks(),
+  m_recording(),
+  m_executable()
+{
+}
+
+Benchmarks::~Benchmarks()
+{
+}
+
+Benchmarks &Benchmarks::instance()
+{
+  static Benchmarks benchmarks;
+  return benchmarks;
+}
+
+bool Benchmarks::add(std::string const &a_name, Function a_function)
+{
+  m_benchmarks.push_back(std::make_pair(a_name, a_function));
+  return true;
+}
+
+/**
+ * Runs the benchmarks selected by the flags, and writes the results to the
+ * output file, or to the standard output. When compared with a baseline, a
+ * regression, a missing baseline or a build without optimisation makes the
+ * exit code 1, so that a perf test never passes without comparing.
+ */
+int32_t Benchmarks::run(int32_t const &a_argc, char **a_argv)
+{
+  m_executable = a_argv[0];
+  std::string const filter = argument(a_argc, a_argv, "benchmark_filter");
+  std::string const minTime = argument(a_argc, a_argv, "benchmark_min_time");
+  std::string const out = argument(a_argc, a_argv, "benchmark_out");
+  std::string const rec = argument(a_argc, a_argv, "benchmark_rec");
+
+  if (!rec.empty()) {
+    std::ifstream recording(rec, std::ios::in | std::ios::binary);
+    if (!recording.good()) {
+      std::cerr << "Cannot open the recording '" << rec << "'." << std::endl;
+      return 1;
+    }
+    while (recording.good()) {
+      odcore::data::Container container;
+      recording >> container;
+      if (recording.fail()) {
+        break;
+      }
+      m_recording.push_back(container);
+    }
+  }
+
+  double const minimumTime = minTime.empty() ? 0.5 : std::stod(minTime);
+  std::stringstream results;
+  write(results, filter, minimumTime);
+  if (out.empty()) {
+    std::cout << results.str();
+  } else {
+    std::ofstream file(out);
+    if (!file.good()) {
+      std::cerr << "Cannot open the output '" << out << "'." << std::endl;
+      return 1;
+    }
+    file << results.str();
+  }
+
+  std::string const baseline = argument(a_argc, a_argv, "benchmark_baseline");
+  if (baseline.empty()) {
+    return 0;
+  }
+#ifdef NDEBUG
+  bool const isRelease = true;
+#else
+  bool const isRelease = false;
+#endif
+  if (!isRelease) {
+    std::clog << "Only release builds are compared with the baseline."
+      << std::endl;
+    return 1;
+  }
+  std::ifstream baselineFile(baseline);
+  if (!baselineFile.good()) {
+    std::clog << "No baseline '" << baseline << "' to compare with. Write "
+      << "it with the -bench-baseline target of the module." << std::endl;
+    return 1;
+  }
+  std::string const threshold =
+    argument(a_argc, a_argv, "benchmark_threshold");
+  std::map<std::string, double> times = readTimes(results);
+  return compare(times, baselineFile,
+      threshold.empty() ? 0.25 : std::stod(threshold), minimumTime);
+}
+
+/**
+ * Writes the results of the benchmarks whose names match the filter, which
+ * matches all if empty.
+ */
+void Benchmarks::write(std::ostream &a_out, std::string const &a_filter,
+    double a_minimumTime) const
+{
+  std::regex const filter(a_filter.empty() ? ".*" : a_filter);
+
+  char date[32];
+  std::time_t const now = std::time(nullptr);
+  std::strftime(date, sizeof(date), "%Y-%m-%d %H:%M:%S",
+      std::localtime(&now));
+#ifdef NDEBUG
+  std::string const buildType = "release";
+#else
+  std::string const buildType = "debug";
+#endif
+
+  a_out << "{" << std::endl
+    << "  \"context\": {" << std::endl
+    << "    \"date\": \"" << date << "\"," << std::endl
+    << "    \"executable\": \"" << m_executable << "\"," << std::endl
+    << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ","
+    << std::endl
+    << "    \"library_build_type\": \"" << buildType << "\"" << std::endl
+    << "  }," << std::endl
+    << "  \"benchmarks\": [";
+  bool isFirst = true;
+  for (auto const &benchmark : m_benchmarks) {
+    if (!std::regex_search(benchmark.first, filter)) {
+      continue;
+    }
+    a_out << (isFirst ? "" : ",") << std::endl;
+    measure(a_out, benchmark.first, benchmark.second, a_minimumTime);
+    isFirst = false;
+  }
+  a_out << std::endl << "  ]" << std::endl << "}" << std::endl;
+}
+
+/**
+ * The containers of the given data type in the recording.
+ */
+std::vector<odcore::data::Container> Benchmarks::recorded(
+    int32_t a_dataType) const
+{
+  std::vector<odcore::data::Container> containers;
+  for (auto const &container : m_recording) {
+    if (container.getDataType() == a_dataType) {
+      containers.push_back(container);
+    }
+  }
+  return containers;
+}
+
+/**
+ * Real time per iteration [ns] of every benchmark in an output of this
+ * harness or of Google Benchmark. Benchmarks that were skipped have no
+ * time.
+ */
+std::map<std::string, double> Benchmarks::readTimes(std::istream &a_results)
+{
+  std::regex const entry("\\{[^{}]*\"name\": *\"([^\"]*)\"[^{}]*\\}");
+  std::regex const realTime("\"real_time\": *([-+0-9.eE]+)");
+  std::regex const timeUnit("\"time_unit\": *\"([a-z]+)\"");
+
+  std::stringstream text;
+  text << a_results.rdbuf();
+  std::string const results = text.str();
+  std::map<std::string, double> times;
+  for (std::sregex_iterator i(results.begin(), results.end(), entry);
+      i != std::sregex_iterator(); i++) {
+    std::string const body = i->str(0);
+    std::smatch time;
+    if (!std::regex_search(body, time, realTime)) {
+      continue;
+    }
+    double scale = 1.0;
+    std::smatch unit;
+    if (std::regex_search(body, unit, timeUnit)) {
+      scale = (unit[1] == "us") ? 1e3 : (unit[1] == "ms") ? 1e6
+        : (unit[1] == "s") ? 1e9 : 1.0;
+    }
+    times[i->str(1)] = std::stod(time[1]) * scale;
+  }
+  return times;
+}
+
+/**
+ * Names of the benchmarks that are slower than in the baseline by more than
+ * the threshold, a fraction of the baseline time. Benchmarks missing from
+ * either are not compared.
+ */
+std::vector<std::string> Benchmarks::regressions(
+    std::map<std::string, double> const &a_times,
+    std::map<std::string, double> const &a_baseline, double a_threshold)
+{
+  std::vector<std::string> names;
+  for (auto const &time : a_times) {
+    auto const baseline = a_baseline.find(time.first);
+    if (baseline != a_baseline.end() && baseline->second > 0.0
+        && time.second > (1.0 + a_threshold) * baseline->second) {
+      names.push_back(time.first);
+    }
+  }
+  return names;
+}
+
+/**
+ * Compares the times with the baseline and reports every benchmark to the
+ * log. A benchmark that seems to regress is measured once more, and only
+ * fails if it is still too slow, so that a noisy machine does not fail the
+ * run.
+ */
+int32_t Benchmarks::compare(std::map<std::string, double> &a_times,
+    std::istream &a_baseline, double a_threshold, double a_minimumTime) const
+{
+  std::map<std::string, double> const baseline = readTimes(a_baseline);
+  for (auto const &name : regressions(a_times, baseline, a_threshold)) {
+    for (auto const &benchmark : m_benchmarks) {
+      if (benchmark.first == name) {
+        std::stringstream again;
+        again << "{\"benchmarks\": [";
+        measure(again, benchmark.first, benchmark.second, a_minimumTime);
+        again << "]}";
+        std::map<std::string, double> const time = readTimes(again);
+        if (time.count(name) > 0) {
+          a_times[name] = std::min(a_times[name], time.at(name));
+        }
+      }
+    }
+  }
+
+  std::vector<std::string> const regressed =
+    regressions(a_times, baseline, a_threshold);
+  for (auto const &time : a_times) {
+    auto const before = baseline.find(time.first);
+    std::clog << time.first << ": " << time.second << " ns";
+    if (before == baseline.end() || before->second <= 0.0) {
+      std::clog << ", not in the baseline" << std::endl;
+      continue;
+    }
+    std::clog << ", baseline " << before->second << " ns ("
+      << std::showpos << 100.0 * (time.second / before->second - 1.0)
+      << std::noshowpos << " %)";
+    if (std::find(regressed.begin(), regressed.end(), time.first)
+        != regressed.end()) {
+      std::clog << ", REGRESSION";
+    }
+    std::clog << std::endl;
+  }
+  if (!regressed.empty()) {
+    std::clog << regressed.size() << " benchmarks regressed by more than "
+      << 100.0 * a_threshold << " %." << std::endl;
+    return 1;
+  }
+  return 0;
+}
+
+/**
+ * Runs a benchmark with increasing iterations, as Google Benchmark does,
+ * until it takes the minimum time, and writes the time per iteration [ns].
+ */
+void Benchmarks::measure(std::ostream &a_out, std::string const &a_name,
+    Function a_function, double a_minimumTime) const
+{
+  uint64_t const maxIterations = 1000000000;
+  uint64_t iterations = 1;
+  BenchmarkState state(iterations);
+  while (true) {
+    state = BenchmarkState(iterations);
+    a_function(state);
+    if (!state.skipReason().empty() || state.realTime() >= a_minimumTime
+        || iterations >= maxIterations) {
+      break;
+    }
+    double const multiplier = std::min(10.0, std::max(2.0,
+          1.4 * a_minimumTime / std::max(state.realTime(), 1e-9)));
+    iterations = std::min(maxIterations,
+        static_cast<uint64_t>(static_cast<double>(iterations) * multiplier));
+  }
+
+  a_out << "    {" << std::endl
+    << "      \"name\": \"" << a_name << "\"," << std::endl;
+  if (!state.skipReason().empty()) {
+    a_out << "      \"error_occurred\": true," << std::endl
+      << "      \"error_message\": \"" << state.skipReason() << "\""
+      << std::endl << "    }";
+    return;
+  }
+  double const count = static_cast<double>(iterations);
+  a_out << "      \"iterations\": " << iterations << "," << std::endl
+    << "      \"real_time\": " << state.realTime() * 1e9 / count << ","
+    << std::endl
+    << "      \"cpu_time\": " << state.cpuTime() * 1e9 / count << ","
+    << std::endl
+    << "      \"time_unit\": \"ns\"";
+  if (state.itemsProcessed() > 0 && state.realTime() > 0.0) {
+    a_out << "," << std::endl << "      \"items_per_second\": "
+      << static_cast<double>(state.itemsProcessed()) / state.realTime();
+  }
+  a_out << std::endl << "    }";
+}
+
+/**
+ * Value of the last --<name>=<value> argument, or an empty string.
+ */
+std::string Benchmarks::argument(int32_t const &a_argc, char **a_argv,
+    std::string const &a_name)
+{
+  std::string const prefix = "--" + a_name + "=";
+  std::string value;
+  for (int32_t i = 1; i < a_argc; i++) {
+    std::string const argument(a_argv[i]);
+    if (argument.compare(0, prefix.size(), prefix) == 0) {
+      value = argument.substr(prefix.size());
+    }
+  }
+  return value;
+}
+
+}
+}
+}
+}
@@ -0,0 +1,195 @@
+/**
+* Copyright (C) 2017 Chalmers Revere
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+* USA.
+*/
+
+#include "busport.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace common {
+
+/**
+ * Takes the handler for incoming containers and the one that sends to the
+ * conference.
+ */
+BusPort::BusPort(Handler a_receive, Handler a_send) :
+  m_receive(a_receive),
+  m_send(a_send),
+  m_bus(nullptr),
+  m_id(0),
+  m_mutex(),
+  m_deliveringThread(),
+  m_sendMutex(),
+  m_outbox(),
+  m_stageTrace()
+#ifdef CFSD18_INSTRUMENTATION
+  , m_statistics()
+#endif
+{
+}
+
+BusPort::~BusPort()
+{
+}
+
+void BusPort::attach(InProcessBus &a_bus)
+{
+  m_bus = &a_bus;
+  m_id = a_bus.subscribe(
+      [this](odcore::data::Container &a_container) { deliver(a_container); });
+}
+
+bool BusPort::isAttached() const
+{
+  return m_bus != nullptr;
+}
+
+/**
+ * Entry point for containers from the conference.
+ */
+void BusPort::receive(odcore::data::Container &a_container)
+{
+  if (m_bus != nullptr && m_bus->isEcho(a_container)) {
+    return;
+  }
+  deliver(a_container);
+}
+
+/**
+ * Only containers sent while handling a delivered one count as the end of a
+ * stage, and those are kept until the handling is done when there is a bus.
+ * The container is stamped as sent, and for the bus also as received, as
+ * the conference would have done. A container without a sample time stamp
+ * is sampled when it is sent, which is also its origin, so that the bus can
+ * tell its mirrored copy from the same message sent at another time.
+ */
+void BusPort::send(odcore::data::Container &a_container)
+{
+  {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    odcore::data::TimeStamp const now = this->now();
+    a_container.setSentTimeStamp(now);
+    if (m_bus != nullptr) {
+      a_container.setReceivedTimeStamp(now);
+      if (a_container.getSampleTimeStamp().toMicroseconds() == 0) {
+        a_container.setSampleTimeStamp(now);
+      }
+    }
+    if (m_deliveringThread == std::this_thread::get_id()) {
+      m_stageTrace.exit(a_container, now);
+      if (m_bus != nullptr) {
+        m_outbox.push_back(a_container);
+        return;
+      }
+    }
+  }
+  forward(a_container);
+}
+
+/**
+ * The time the microservice should stamp and age its data with.
+ */
+odcore::data::TimeStamp BusPort::now() const
+{
+  return (m_bus != nullptr) ? m_bus->clock().now()
+    : odcore::data::TimeStamp();
+}
+
+std::string BusPort::traceReport() const
+{
+  std::lock_guard<std::recursive_mutex> lock(m_mutex);
+  return m_stageTrace.report();
+}
+
+/**
+ * Writes the handler statistics to the log every period [s], if the
+ * instrumentation is built.
+ */
+void BusPort::publishStatistics(std::string const &a_name, float a_period)
+{
+#ifdef CFSD18_INSTRUMENTATION
+  std::lock_guard<std::recursive_mutex> lock(m_mutex);
+  m_statistics.publish(a_name, a_period);
+#else
+  (void) a_name;
+  (void) a_period;
+#endif
+}
+
+/**
+ * Hands a container to the microservice, and then forwards what it sent
+ * meanwhile without holding the lock. The outbox is handed back afterwards,
+ * so that it keeps its capacity.
+ */
+void BusPort::deliver(odcore::data::Container &a_container)
+{
+  std::vector<odcore::data::Container> outbox;
+  {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    std::thread::id const previousThread = m_deliveringThread;
+    m_deliveringThread = std::this_thread::get_id();
+    m_stageTrace.enter();
+    {
+      CFSD18_TIME_SCOPE(m_statistics.handlerTimes());
+      m_receive(a_container);
+    }
+    CFSD18_INSTRUMENT(m_statistics.update(queueDepth()));
+    m_deliveringThread = previousThread;
+    if (previousThread != std::this_thread::get_id()) {
+      outbox.swap(m_outbox);
+    }
+  }
+
+  if (outbox.capacity() > 0) {
+    for (auto &container : outbox) {
+      forward(container);
+    }
+    outbox.clear();
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    if (m_outbox.empty()) {
+      m_outbox.swap(outbox);
+    }
+  }
+}
+
+/**
+ * Publishes a sent container on the bus before it is mirrored, so that the
+ * bus knows the copy when it comes back. It only goes to the conference
+ * without a bus, or if the bus is mirrored.
+ */
+void BusPort::forward(odcore::data::Container &a_container)
+{
+  if (m_bus != nullptr) {
+    m_bus->publish(m_id, a_container);
+  }
+  if (m_bus == nullptr || m_bus->isMirrored()) {
+    std::lock_guard<std::mutex> lock(m_sendMutex);
+    m_send(a_container);
+  }
+}
+
+uint32_t BusPort::queueDepth() const
+{
+  return (m_bus != nullptr) ? m_bus->queueDepth(m_id) : 0;
+}
+
+}
+}
+}
+}
@@ -0,0 +1,71 @@
+/**
+* Copyright (C) 2017 Chalmers Revere
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+* USA.
+*/
+
+#include "clock.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace common {
+
+Clock::Clock() :
+  m_isSimulated(false),
+  m_simulatedMicroseconds(0)
+{
+}
+
+Clock::~Clock()
+{
+}
+
+odcore::data::TimeStamp Clock::now() const
+{
+  if (!m_isSimulated.load(std::memory_order_acquire)) {
+    return odcore::data::TimeStamp();
+  }
+  int64_t const microseconds =
+    m_simulatedMicroseconds.load(std::memory_order_relaxed);
+  return odcore::data::TimeStamp(static_cast<int32_t>(microseconds / 1000000),
+      static_cast<int32_t>(microseconds % 1000000));
+}
+
+/**
+ * Holds the clock at the given time until it is set again or released.
+ */
+void Clock::simulate(odcore::data::TimeStamp const &a_time)
+{
+  m_simulatedMicroseconds.store(a_time.toMicroseconds(),
+      std::memory_order_relaxed);
+  m_isSimulated.store(true, std::memory_order_release);
+}
+
+void Clock::release()
+{
+  m_isSimulated.store(false, std::memory_order_release);
+}
+
+bool Clock::isSimulated() const
+{
+  return m_isSimulated.load(std::memory_order_acquire);
+}
+
+}
+}
+}
+}
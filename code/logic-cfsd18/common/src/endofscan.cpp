@@ -0,0 +1,49 @@
+/**
+* Copyright (C) 2017 Chalmers Revere
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+* USA.
+*/
+
+#include "endofscan.hpp"
+#include "trace.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace common {
+
+/**
+ * The end of the scan taken at the origin of the given container. It is an
+ * attention at a negative distance, which no point of a scan can have, so
+ * that a point at any distance, zero included, is never taken for it.
+ */
+odcore::data::Container endOfScan(odcore::data::Container &a_origin)
+{
+  opendlv::logic::sensation::Attention const attention(0.0f, 0.0f, -1.0f);
+  odcore::data::Container container(attention);
+  propagateOrigin(a_origin, container);
+  return container;
+}
+
+bool isEndOfScan(opendlv::logic::sensation::Attention const &a_attention)
+{
+  return a_attention.getDistance() < 0.0f;
+}
+
+}
+}
+}
+}
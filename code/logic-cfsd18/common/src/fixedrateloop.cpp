@@ -0,0 +1,148 @@
+/**
+* Copyright (C) 2017 Chalmers Revere
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+* USA.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+
+#include "fixedrateloop.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace common {
+
+FixedRateLoop::FixedRateLoop() :
+  m_body(),
+  m_thread(),
+  m_isRunning(false),
+  m_statisticsMutex(),
+  m_iterations(0),
+  m_overruns(0),
+  m_periodSum(0.0),
+  m_maxPeriod(0.0)
+{
+}
+
+FixedRateLoop::~FixedRateLoop()
+{
+  stop();
+}
+
+/**
+ * Starts calling the body at the given frequency [Hz].
+ */
+void FixedRateLoop::start(float a_frequency, std::function<void()> a_body)
+{
+  stop();
+  m_body = a_body;
+  m_isRunning = true;
+  m_thread = std::thread(&FixedRateLoop::run, this, 1.0 / static_cast<double>(a_frequency));
+}
+
+void FixedRateLoop::stop()
+{
+  m_isRunning = false;
+  if (m_thread.joinable()) {
+    m_thread.join();
+  }
+}
+
+bool FixedRateLoop::isRunning() const
+{
+  return m_isRunning;
+}
+
+uint64_t FixedRateLoop::iterations() const
+{
+  std::lock_guard<std::mutex> lock(m_statisticsMutex);
+  return m_iterations;
+}
+
+uint64_t FixedRateLoop::overruns() const
+{
+  std::lock_guard<std::mutex> lock(m_statisticsMutex);
+  return m_overruns;
+}
+
+/**
+ * Mean measured time [s] between the starts of two iterations.
+ */
+double FixedRateLoop::meanPeriod() const
+{
+  std::lock_guard<std::mutex> lock(m_statisticsMutex);
+  return (m_iterations > 1)
+    ? m_periodSum / static_cast<double>(m_iterations - 1) : 0.0;
+}
+
+double FixedRateLoop::maxPeriod() const
+{
+  std::lock_guard<std::mutex> lock(m_statisticsMutex);
+  return m_maxPeriod;
+}
+
+std::string FixedRateLoop::statistics() const
+{
+  std::stringstream statistics;
+  statistics << iterations() << " iterations, mean period "
+    << meanPeriod() * 1000.0 << " ms, max period " << maxPeriod() * 1000.0
+    << " ms, " << overruns() << " overruns";
+  return statistics.str();
+}
+
+void FixedRateLoop::run(double a_period)
+{
+  typedef std::chrono::steady_clock Clock;
+  Clock::duration const period = std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double>(a_period));
+
+  Clock::time_point next = Clock::now();
+  Clock::time_point previousStart = next;
+  bool isFirst = true;
+  while (m_isRunning) {
+    std::this_thread::sleep_until(next);
+    Clock::time_point const start = Clock::now();
+
+    m_body();
+
+    Clock::time_point const end = Clock::now();
+    next += period;
+    bool const isOverrun = end > next;
+    if (isOverrun) {
+      next = end;
+    }
+
+    std::lock_guard<std::mutex> lock(m_statisticsMutex);
+    if (!isFirst) {
+      double const measured =
+        std::chrono::duration<double>(start - previousStart).count();
+      m_periodSum += measured;
+      m_maxPeriod = std::max(m_maxPeriod, measured);
+    }
+    m_iterations++;
+    m_overruns += isOverrun ? 1 : 0;
+    previousStart = start;
+    isFirst = false;
+  }
+}
+
+}
+}
+}
+}
@@ -0,0 +1,126 @@
+/**
+* Copyright (C) 2017 Chalmers Revere
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+* USA.
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include "histogram.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace common {
+
+Histogram::Histogram() :
+  m_counts(),
+  m_count(0),
+  m_max(0)
+{
+  reset();
+}
+
+Histogram::~Histogram()
+{
+}
+
+void Histogram::record(uint64_t a_value)
+{
+  m_counts[bucketOf(a_value)].fetch_add(1, std::memory_order_relaxed);
+  m_count.fetch_add(1, std::memory_order_relaxed);
+  uint64_t max = m_max.load(std::memory_order_relaxed);
+  while (a_value > max && !m_max.compare_exchange_weak(max, a_value,
+        std::memory_order_relaxed)) {
+  }
+}
+
+void Histogram::reset()
+{
+  for (auto &count : m_counts) {
+    count.store(0, std::memory_order_relaxed);
+  }
+  m_count.store(0, std::memory_order_relaxed);
+  m_max.store(0, std::memory_order_relaxed);
+}
+
+uint64_t Histogram::count() const
+{
+  return m_count.load(std::memory_order_relaxed);
+}
+
+uint64_t Histogram::max() const
+{
+  return m_max.load(std::memory_order_relaxed);
+}
+
+/**
+ * Nearest-rank percentile, given as the highest value of its bucket but never
+ * above the largest recorded value, or zero without samples.
+ */
+uint64_t Histogram::percentile(float a_percentile) const
+{
+  uint64_t const total = count();
+  if (total == 0) {
+    return 0;
+  }
+  uint64_t const rank = std::max(static_cast<uint64_t>(1),
+      static_cast<uint64_t>(std::ceil(static_cast<double>(a_percentile)
+          / 100.0 * static_cast<double>(total))));
+  uint64_t cumulative = 0;
+  for (uint32_t i = 0; i < BUCKETS; i++) {
+    cumulative += m_counts[i].load(std::memory_order_relaxed);
+    if (cumulative >= rank) {
+      return std::min(valueOf(i), max());
+    }
+  }
+  return max();
+}
+
+/**
+ * Values below SUB_BUCKETS have a bucket each. Above that, the bucket is
+ * given by the magnitude and the SUB_BUCKET_BITS bits below the highest set
+ * bit.
+ */
+uint32_t Histogram::bucketOf(uint64_t a_value)
+{
+  if (a_value < SUB_BUCKETS) {
+    return static_cast<uint32_t>(a_value);
+  }
+  uint32_t const magnitude =
+    63 - static_cast<uint32_t>(__builtin_clzll(a_value));
+  uint32_t const shift = magnitude - SUB_BUCKET_BITS;
+  return SUB_BUCKETS * shift + static_cast<uint32_t>(a_value >> shift);
+}
+
+/**
+ * The highest value stored in a bucket.
+ */
+uint64_t Histogram::valueOf(uint32_t a_bucket)
+{
+  if (a_bucket < SUB_BUCKETS) {
+    return a_bucket;
+  }
+  uint32_t const shift = a_bucket / SUB_BUCKETS - 1;
+  uint64_t const subBucket = a_bucket % SUB_BUCKETS + SUB_BUCKETS;
+  return ((subBucket + 1) << shift) - 1;
+}
+
+}
+}
+}
+}
@@ -0,0 +1,372 @@
+/**
+* Copyright (C) 2017 Chalmers Revere
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+* USA.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <sstream>
+#include <string>
+
+#include <opendavinci/odcore/data/TimeStamp.h>
+
+#include "inprocessbus.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace common {
+
+InProcessBus::InProcessBus(Delivery a_delivery, Mirroring a_mirroring) :
+  m_delivery(a_delivery),
+  m_mirroring(a_mirroring),
+  m_clock(),
+  m_handlersMutex(),
+  m_handlers(std::make_shared<Handlers const>()),
+  m_rings(),
+  m_producerMutexes(),
+  m_backlogs(),
+  m_ringSubscribers(0),
+  m_threadsMutex(),
+  m_threads(),
+  m_isRunning(false),
+  m_dropped(0),
+  m_echoesMutex(),
+  m_dataTypes(),
+  m_echoes(),
+  m_echoCounts(),
+  m_nextEcho(0)
+{
+}
+
+InProcessBus::~InProcessBus()
+{
+  stop();
+}
+
+/**
+ * Adds a subscriber and returns its id, which is used when it publishes. The
+ * handlers are copied on write, so that publishers in other threads keep
+ * using the ones they started with.
+ */
+uint32_t InProcessBus::subscribe(Handler a_handler)
+{
+  std::lock_guard<std::mutex> lock(m_handlersMutex);
+  std::shared_ptr<Handlers> handlers = std::make_shared<Handlers>(*m_handlers);
+  handlers->push_back(a_handler);
+  m_handlers = handlers;
+  return static_cast<uint32_t>(handlers->size() - 1);
+}
+
+/**
+ * With queued delivery, allocates the rings and starts one draining thread
+ * per subscriber.
+ */
+void InProcessBus::start()
+{
+  if (m_delivery != Delivery::Queued || m_isRunning) {
+    return;
+  }
+  m_ringSubscribers = static_cast<uint32_t>(handlers()->size());
+  m_rings.clear();
+  m_producerMutexes.clear();
+  m_backlogs.clear();
+  for (uint32_t i = 0; i < m_ringSubscribers * m_ringSubscribers; i++) {
+    m_rings.push_back(std::unique_ptr<Ring>(new Ring));
+  }
+  for (uint32_t i = 0; i < m_ringSubscribers; i++) {
+    m_producerMutexes.push_back(std::unique_ptr<std::mutex>(new std::mutex));
+    m_backlogs.push_back(std::unique_ptr<Backlog>(new Backlog));
+  }
+  m_isRunning = true;
+  std::lock_guard<std::mutex> lock(m_threadsMutex);
+  for (uint32_t i = 0; i < m_ringSubscribers; i++) {
+    m_threads.push_back(std::thread(&InProcessBus::drain, this, i));
+  }
+}
+
+void InProcessBus::stop()
+{
+  m_isRunning = false;
+  for (auto &thread : m_threads) {
+    thread.join();
+  }
+  std::lock_guard<std::mutex> lock(m_threadsMutex);
+  m_threads.clear();
+}
+
+/**
+ * Delivers a container to all subscribers except the publisher. The rings
+ * of a publisher are filled under a lock of its own, since they have a
+ * single producer. No lock is held while a handler runs.
+ */
+void InProcessBus::publish(uint32_t a_publisher,
+    odcore::data::Container &a_container)
+{
+  if (isMirrored()) {
+    remember(a_container);
+  }
+
+  std::shared_ptr<Handlers const> const handlers = this->handlers();
+  uint32_t const subscribers = static_cast<uint32_t>(handlers->size());
+  if (m_delivery == Delivery::Queued && !m_isRunning) {
+    m_dropped += (a_publisher < subscribers) ? subscribers - 1 : subscribers;
+    return;
+  }
+  uint32_t const ringSubscribers = (m_isRunning
+      && a_publisher < m_ringSubscribers) ? m_ringSubscribers : 0;
+  if (ringSubscribers > 0) {
+    std::lock_guard<std::mutex> lock(*m_producerMutexes[a_publisher]);
+    for (uint32_t i = 0; i < ringSubscribers; i++) {
+      if (i != a_publisher) {
+        push(a_publisher, i, a_container);
+      }
+    }
+  }
+  for (uint32_t i = ringSubscribers; i < subscribers; i++) {
+    if (i != a_publisher) {
+      (*handlers)[i](a_container);
+    }
+  }
+}
+
+/**
+ * Waits for room in the ring from a publisher to a subscriber, and drops the
+ * container if the bus stops meanwhile. A draining thread keeps emptying the
+ * rings towards its own subscriber while it waits.
+ */
+void InProcessBus::push(uint32_t a_publisher, uint32_t a_subscriber,
+    odcore::data::Container const &a_container)
+{
+  Ring &ring = this->ring(a_publisher, a_subscriber);
+  if (ring.tryPush(a_container)) {
+    return;
+  }
+  uint32_t const drainer = drainingSubscriber();
+  while (!ring.tryPush(a_container)) {
+    if (!m_isRunning) {
+      m_dropped++;
+      return;
+    }
+    if (drainer < m_ringSubscribers) {
+      moveToBacklog(drainer);
+    }
+    std::this_thread::yield();
+  }
+}
+
+/**
+ * Hands the containers in the backlog and in all rings towards a subscriber
+ * to its handler, and backs off while they are empty. The backlog goes
+ * first, since it holds what was taken from the rings earlier.
+ */
+void InProcessBus::drain(uint32_t a_subscriber)
+{
+  std::shared_ptr<Handlers const> const handlers = this->handlers();
+  Backlog &backlog = *m_backlogs[a_subscriber];
+  uint32_t const maxSpins = 1000;
+  uint32_t spins = 0;
+  odcore::data::Container container;
+  while (m_isRunning) {
+    bool isIdle = true;
+    while (!backlog.empty()) {
+      container = backlog.front();
+      backlog.pop_front();
+      container.setReceivedTimeStamp(m_clock.now());
+      (*handlers)[a_subscriber](container);
+      isIdle = false;
+    }
+    for (uint32_t i = 0; i < m_ringSubscribers; i++) {
+      if (i == a_subscriber) {
+        continue;
+      }
+      while (ring(i, a_subscriber).tryPop(container)) {
+        container.setReceivedTimeStamp(m_clock.now());
+        (*handlers)[a_subscriber](container);
+        isIdle = false;
+      }
+    }
+
+    if (!isIdle) {
+      spins = 0;
+    } else if (spins < maxSpins) {
+      spins++;
+      std::this_thread::yield();
+    } else {
+      std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+  }
+}
+
+/**
+ * The subscriber whose draining thread is the calling thread, or the number
+ * of subscribers if the calling thread does not drain the bus.
+ */
+uint32_t InProcessBus::drainingSubscriber() const
+{
+  std::lock_guard<std::mutex> lock(m_threadsMutex);
+  for (uint32_t i = 0; i < m_threads.size(); i++) {
+    if (m_threads[i].get_id() == std::this_thread::get_id()) {
+      return i;
+    }
+  }
+  return m_ringSubscribers;
+}
+
+/**
+ * Empties the rings towards a subscriber into its backlog, keeping the order
+ * of every publisher. Only the draining thread of the subscriber may call it.
+ */
+void InProcessBus::moveToBacklog(uint32_t a_subscriber)
+{
+  Backlog &backlog = *m_backlogs[a_subscriber];
+  odcore::data::Container container;
+  for (uint32_t i = 0; i < m_ringSubscribers; i++) {
+    if (i == a_subscriber) {
+      continue;
+    }
+    while (ring(i, a_subscriber).tryPop(container)) {
+      backlog.push_back(container);
+    }
+  }
+}
+
+InProcessBus::Ring &InProcessBus::ring(uint32_t a_publisher,
+    uint32_t a_subscriber)
+{
+  return *m_rings[a_publisher * m_ringSubscribers + a_subscriber];
+}
+
+std::shared_ptr<InProcessBus::Handlers const> InProcessBus::handlers() const
+{
+  std::lock_guard<std::mutex> lock(m_handlersMutex);
+  return m_handlers;
+}
+
+/**
+ * Identifies a container by its serialisation without the sent and received
+ * time stamps, which the conference sets again.
+ */
+uint64_t InProcessBus::fingerprintOf(odcore::data::Container const &a_container)
+{
+  odcore::data::Container container(a_container);
+  container.setSentTimeStamp(odcore::data::TimeStamp(0, 0));
+  container.setReceivedTimeStamp(odcore::data::TimeStamp(0, 0));
+  std::stringstream serialisation;
+  serialisation << container;
+  return std::hash<std::string>()(serialisation.str());
+}
+
+/**
+ * Keeps the fingerprint of a published container, which its mirrored copy
+ * has as well.
+ */
+void InProcessBus::remember(odcore::data::Container const &a_container)
+{
+  int32_t const dataType = a_container.getDataType();
+  uint64_t const echo = fingerprintOf(a_container);
+  std::lock_guard<std::mutex> lock(m_echoesMutex);
+  auto it = std::lower_bound(m_dataTypes.begin(), m_dataTypes.end(),
+      dataType);
+  if (it == m_dataTypes.end() || *it != dataType) {
+    m_dataTypes.insert(it, dataType);
+  }
+  if (m_echoes.size() < ECHO_WINDOW) {
+    m_echoes.push_back(echo);
+  } else {
+    auto const forgotten = m_echoCounts.find(m_echoes[m_nextEcho]);
+    if (--forgotten->second == 0) {
+      m_echoCounts.erase(forgotten);
+    }
+    m_echoes[m_nextEcho] = echo;
+  }
+  m_echoCounts[echo]++;
+  m_nextEcho = (m_nextEcho + 1) % ECHO_WINDOW;
+}
+
+/**
+ * Whether a container from the conference is the mirrored copy of one
+ * published on the bus. Data types that were never published are passed
+ * without serialising them.
+ */
+bool InProcessBus::isEcho(odcore::data::Container const &a_container) const
+{
+  if (!isMirrored()) {
+    return false;
+  }
+  int32_t const dataType = a_container.getDataType();
+  {
+    std::lock_guard<std::mutex> lock(m_echoesMutex);
+    if (!std::binary_search(m_dataTypes.begin(), m_dataTypes.end(),
+          dataType)) {
+      return false;
+    }
+  }
+  uint64_t const echo = fingerprintOf(a_container);
+  std::lock_guard<std::mutex> lock(m_echoesMutex);
+  return m_echoCounts.count(echo) > 0;
+}
+
+bool InProcessBus::isMirrored() const
+{
+  return m_mirroring == Mirroring::Conference;
+}
+
+/**
+ * The number of containers waiting in the rings towards a subscriber, which
+ * is always zero with direct delivery.
+ */
+uint32_t InProcessBus::queueDepth(uint32_t a_subscriber) const
+{
+  if (!m_isRunning || a_subscriber >= m_ringSubscribers) {
+    return 0;
+  }
+  uint32_t queueDepth = 0;
+  for (uint32_t i = 0; i < m_ringSubscribers; i++) {
+    queueDepth += m_rings[i * m_ringSubscribers + a_subscriber]->size();
+  }
+  return queueDepth;
+}
+
+/**
+ * The number of containers that did not reach a subscriber, since the queued
+ * bus was not running or stopped while their publisher waited for room.
+ */
+uint64_t InProcessBus::dropped() const
+{
+  return m_dropped;
+}
+
+/**
+ * The time of the microservices on the bus, which whoever drives them may
+ * simulate.
+ */
+Clock &InProcessBus::clock()
+{
+  return m_clock;
+}
+
+Clock const &InProcessBus::clock() const
+{
+  return m_clock;
+}
+
+}
+}
+}
+}
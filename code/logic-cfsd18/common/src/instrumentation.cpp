@@ -0,0 +1,118 @@
+/**
+* Copyright (C) 2017 Chalmers Revere
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+* USA.
+*/
+
+#include <iostream>
+#include <sstream>
+
+#include "instrumentation.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace common {
+
+ScopedTimer::ScopedTimer(Histogram &a_histogram) :
+  m_histogram(a_histogram),
+  m_start(std::chrono::steady_clock::now())
+{
+}
+
+ScopedTimer::~ScopedTimer()
+{
+  m_histogram.record(static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - m_start).count()));
+}
+
+HandlerStatistics::HandlerStatistics() :
+  m_handlerTimes(),
+  m_queueDepth(0),
+  m_periodStart(std::chrono::steady_clock::now()),
+  m_period(std::chrono::steady_clock::duration::zero()),
+  m_name()
+{
+}
+
+HandlerStatistics::~HandlerStatistics()
+{
+}
+
+Histogram &HandlerStatistics::handlerTimes()
+{
+  return m_handlerTimes;
+}
+
+/**
+ * Starts writing the statistics to the log every period [s].
+ */
+void HandlerStatistics::publish(std::string const &a_name, float a_period)
+{
+  m_name = a_name;
+  m_period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::duration<float>(a_period));
+  restart(std::chrono::steady_clock::now());
+}
+
+/**
+ * Called after every handled container with the number of containers still
+ * waiting.
+ */
+void HandlerStatistics::update(uint32_t a_queueDepth)
+{
+  if (a_queueDepth > m_queueDepth.load(std::memory_order_relaxed)) {
+    m_queueDepth.store(a_queueDepth, std::memory_order_relaxed);
+  }
+  if (m_period == std::chrono::steady_clock::duration::zero()) {
+    return;
+  }
+  auto const now = std::chrono::steady_clock::now();
+  if (now - m_periodStart >= m_period) {
+    std::clog << m_name << ": " << summary() << std::endl;
+    restart(now);
+  }
+}
+
+std::string HandlerStatistics::summary() const
+{
+  double const period = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - m_periodStart).count();
+  double const rate = (period > 0.0)
+    ? static_cast<double>(m_handlerTimes.count()) / period : 0.0;
+
+  std::stringstream summary;
+  summary << rate << " Hz, handler p50 "
+    << static_cast<double>(m_handlerTimes.percentile(50.0f)) / 1000.0
+    << " us, p99 "
+    << static_cast<double>(m_handlerTimes.percentile(99.0f)) / 1000.0
+    << " us, max " << static_cast<double>(m_handlerTimes.max()) / 1000.0
+    << " us, queue depth " << m_queueDepth.load(std::memory_order_relaxed);
+  return summary.str();
+}
+
+void HandlerStatistics::restart(std::chrono::steady_clock::time_point a_now)
+{
+  m_handlerTimes.reset();
+  m_queueDepth.store(0, std::memory_order_relaxed);
+  m_periodStart = a_now;
+}
+
+}
+}
+}
+}
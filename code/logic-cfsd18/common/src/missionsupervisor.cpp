@@ -0,0 +1,61 @@
+/**
+* Copyright (C) 2017 Chalmers Revere
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+* USA.
+*/
+
+#include "missionsupervisor.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace common {
+
+MissionSupervisor::MissionSupervisor() :
+  m_activeMission(MissionId::None)
+{
+}
+
+MissionSupervisor::~MissionSupervisor()
+{
+}
+
+/**
+ * Returns true if the active mission changed.
+ */
+bool MissionSupervisor::update(opendlv::system::SystemOperationState const &a_systemOperationState)
+{
+  int32_t const code = a_systemOperationState.getCode();
+  MissionId mission = MissionId::None;
+  if (code >= static_cast<int32_t>(MissionId::Acceleration)
+      && code <= static_cast<int32_t>(MissionId::BrakeTest)) {
+    mission = static_cast<MissionId>(code);
+  }
+
+  bool const changed = mission != m_activeMission;
+  m_activeMission = mission;
+  return changed;
+}
+
+MissionId MissionSupervisor::activeMission() const
+{
+  return m_activeMission;
+}
+
+}
+}
+}
+}
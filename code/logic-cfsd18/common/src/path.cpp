@@ -0,0 +1,163 @@
+/**
+* Copyright (C) 2017 Chalmers Revere
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+* USA.
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include "path.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace common {
+
+Path::Path() :
+  m_x(),
+  m_y(),
+  m_s()
+{
+  uint32_t const initialCapacity = 64;
+  m_x.reserve(initialCapacity);
+  m_y.reserve(initialCapacity);
+  m_s.reserve(initialCapacity);
+}
+
+Path::~Path()
+{
+}
+
+void Path::clear()
+{
+  m_x.clear();
+  m_y.clear();
+  m_s.clear();
+}
+
+void Path::append(float a_x, float a_y)
+{
+  float s = 0.0f;
+  if (!m_s.empty()) {
+    float const dx = a_x - m_x.back();
+    float const dy = a_y - m_y.back();
+    s = m_s.back() + std::sqrt(dx * dx + dy * dy);
+  }
+  m_x.push_back(a_x);
+  m_y.push_back(a_y);
+  m_s.push_back(s);
+}
+
+uint32_t Path::size() const
+{
+  return static_cast<uint32_t>(m_s.size());
+}
+
+float Path::length() const
+{
+  return m_s.empty() ? 0.0f : m_s.back();
+}
+
+/**
+ * Point at the given arc length, clamped to the ends of the path.
+ */
+Eigen::Vector2f Path::pointAt(float a_distance) const
+{
+  if (m_s.empty()) {
+    return Eigen::Vector2f::Zero();
+  }
+  if (a_distance <= 0.0f || m_s.size() == 1) {
+    return Eigen::Vector2f(m_x.front(), m_y.front());
+  }
+  if (a_distance >= m_s.back()) {
+    return Eigen::Vector2f(m_x.back(), m_y.back());
+  }
+
+  uint32_t const i = static_cast<uint32_t>(
+      std::lower_bound(m_s.begin(), m_s.end(), a_distance) - m_s.begin());
+  float const segment = m_s[i] - m_s[i - 1];
+  float const t = segment > 0.0f ? (a_distance - m_s[i - 1]) / segment : 0.0f;
+  return Eigen::Vector2f(m_x[i - 1] + t * (m_x[i] - m_x[i - 1]),
+      m_y[i - 1] + t * (m_y[i] - m_y[i - 1]));
+}
+
+/**
+ * Point at the given arc length, continuing straight along the last segment
+ * past the end of the path.
+ */
+Eigen::Vector2f Path::extrapolatedPointAt(float a_distance) const
+{
+  if (m_s.size() < 2 || a_distance <= m_s.back()) {
+    return pointAt(a_distance);
+  }
+  uint32_t i = static_cast<uint32_t>(m_s.size() - 1);
+  while (i > 1 && m_s[i] <= m_s[i - 1]) {
+    i--;
+  }
+  float const segment = m_s[i] - m_s[i - 1];
+  if (segment <= 0.0f) {
+    return pointAt(a_distance);
+  }
+  float const t = (a_distance - m_s.back()) / segment;
+  return Eigen::Vector2f(m_x.back() + t * (m_x[i] - m_x[i - 1]),
+      m_y.back() + t * (m_y[i] - m_y[i - 1]));
+}
+
+/**
+ * Unsigned Menger curvature through the point and its two neighbours, zero
+ * at the ends of the path.
+ */
+float Path::curvatureAt(uint32_t a_index) const
+{
+  if (a_index == 0 || a_index + 1 >= m_s.size()) {
+    return 0.0f;
+  }
+  float const ax = m_x[a_index] - m_x[a_index - 1];
+  float const ay = m_y[a_index] - m_y[a_index - 1];
+  float const bx = m_x[a_index + 1] - m_x[a_index];
+  float const by = m_y[a_index + 1] - m_y[a_index];
+  float const cx = m_x[a_index + 1] - m_x[a_index - 1];
+  float const cy = m_y[a_index + 1] - m_y[a_index - 1];
+  float const a = m_s[a_index] - m_s[a_index - 1];
+  float const b = m_s[a_index + 1] - m_s[a_index];
+  float const c = std::sqrt(cx * cx + cy * cy);
+  float const denominator = a * b * c;
+  return denominator > 0.0f ? 2.0f * std::fabs(ax * by - ay * bx) / denominator : 0.0f;
+}
+
+/**
+ * Highest speed at the vehicle such that the speed at every point of the path
+ * stays below the curvature limit sqrt(a_lat / kappa), given that the car can
+ * decelerate with the given rate in between.
+ */
+float Path::speedLimit(float a_maxLateralAcceleration, float a_maxDeceleration, float a_maxSpeed) const
+{
+  float const minCurvature = a_maxLateralAcceleration / (a_maxSpeed * a_maxSpeed);
+  float speedSquared = a_maxSpeed * a_maxSpeed;
+  for (uint32_t i = 1; i + 1 < m_s.size(); i++) {
+    float const curvature = std::max(curvatureAt(i), minCurvature);
+    float const cornerSpeedSquared = a_maxLateralAcceleration / curvature;
+    speedSquared = std::min(speedSquared,
+        cornerSpeedSquared + 2.0f * a_maxDeceleration * m_s[i]);
+  }
+  return std::sqrt(speedSquared);
+}
+
+}
+}
+}
+}
@@ -0,0 +1,57 @@
+/**
+* Copyright (C) 2017 Chalmers Revere
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+* USA.
+*/
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "pipeline.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace common {
+
+/**
+ * Restricts a thread to one core, and returns false where that is not
+ * supported or the core does not exist.
+ */
+bool pinToCore(std::thread &a_thread, int32_t a_core)
+{
+#ifdef __linux__
+  if (a_core < 0 || a_core >= CPU_SETSIZE) {
+    return false;
+  }
+  cpu_set_t cores;
+  CPU_ZERO(&cores);
+  CPU_SET(static_cast<size_t>(a_core), &cores);
+  return pthread_setaffinity_np(a_thread.native_handle(), sizeof(cpu_set_t),
+      &cores) == 0;
+#else
+  (void) a_thread;
+  (void) a_core;
+  return false;
+#endif
+}
+
+}
+}
+}
+}
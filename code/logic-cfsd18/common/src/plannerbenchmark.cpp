@@ -0,0 +1,64 @@
+/**
+* Copyright (C) 2017 Chalmers Revere
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+* USA.
+*/
+
+#include <cmath>
+
+#include "plannerbenchmark.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace common {
+
+/**
+ * Surfaces between cone pairs 3 m apart along an arc of the given curvature,
+ * 20 of them, so that the path of a planner grows to 20 surfaces before it
+ * starts over.
+ */
+std::vector<odcore::data::Container> arcSurfaces(float a_curvature)
+{
+  float const spacing = 3.0f;
+  float const halfWidth = 1.5f;
+  std::vector<odcore::data::Container> surfaces;
+  float x = 0.0f;
+  float y = 0.0f;
+  float heading = 0.0f;
+  for (uint32_t i = 1; i <= 20; i++) {
+    float const nextHeading = heading + spacing * a_curvature;
+    float const nextX = x + spacing * std::cos(heading);
+    float const nextY = y + spacing * std::sin(heading);
+    opendlv::logic::perception::Surface surface(i,
+        x - halfWidth * std::sin(heading), y + halfWidth * std::cos(heading),
+        x + halfWidth * std::sin(heading), y - halfWidth * std::cos(heading),
+        nextX - halfWidth * std::sin(nextHeading),
+        nextY + halfWidth * std::cos(nextHeading),
+        nextX + halfWidth * std::sin(nextHeading),
+        nextY - halfWidth * std::cos(nextHeading));
+    surfaces.push_back(odcore::data::Container(surface));
+    x = nextX;
+    y = nextY;
+    heading = nextHeading;
+  }
+  return surfaces;
+}
+
+}
+}
+}
+}
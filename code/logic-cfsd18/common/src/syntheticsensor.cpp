@@ -0,0 +1,256 @@
+/**
+* Copyright (C) 2017 Chalmers Revere
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+* USA.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+#include "syntheticsensor.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace common {
+
+namespace {
+
+float const pi = static_cast<float>(M_PI);
+float const sensorHeight = 0.4f;
+float const coneRadius = 0.1f;
+float const coneHeight = 0.325f;
+float const fieldOfView = 2.0f * pi / 3.0f;
+double const originLatitude = 49.3278;
+double const originLongitude = 8.5656;
+double const earthRadius = 6371000.0;
+
+/**
+ * Position in the frame of the car at the given pose.
+ */
+Eigen::Vector2f toVehicleFrame(Eigen::Vector2f const &a_point,
+    Eigen::Vector3f const &a_pose)
+{
+  float const dx = a_point(0) - a_pose(0);
+  float const dy = a_point(1) - a_pose(1);
+  float const c = std::cos(a_pose(2));
+  float const s = std::sin(a_pose(2));
+  return Eigen::Vector2f(c * dx + s * dy, -s * dx + c * dy);
+}
+
+}
+
+SyntheticSensor::SyntheticSensor(uint32_t a_seed, float a_range,
+    float a_rangeNoise, float a_angleNoise, float a_dropout) :
+  m_generator(a_seed),
+  m_normal(0.0f, 1.0f),
+  m_uniform(0.0f, 1.0f),
+  m_range(a_range),
+  m_rangeNoise(a_rangeNoise),
+  m_angleNoise(a_angleNoise),
+  m_dropout(a_dropout),
+  m_distances(COLUMNS * LAYERS, 0.0f)
+{
+}
+
+SyntheticSensor::~SyntheticSensor()
+{
+}
+
+/**
+ * Elevation in radians of a layer, from -15 to 15 degrees in steps of two
+ * as on a VLP-16, ordered from the lowest layer upwards.
+ */
+float SyntheticSensor::elevation(uint32_t a_layer)
+{
+  return (-15.0f + 2.0f * static_cast<float>(a_layer)) * pi / 180.0f;
+}
+
+/**
+ * One revolution of a 16 layer lidar mounted above the car's position.
+ * Cones are cylinders standing on a flat ground, and every column only
+ * visits the cones that cover it, so a scan costs a pass over the cones and
+ * one over the points. The azimuth runs clockwise in degrees from the x
+ * axis of the car, and the distances are sent column by column, layer by
+ * layer, as big-endian 16 bit centimetres, with zero meaning no return.
+ */
+odcore::data::CompactPointCloud SyntheticSensor::scan(
+    SyntheticTrack const &a_track, Eigen::Vector3f const &a_pose)
+{
+  float const resolution = 360.0f / COLUMNS;
+
+  std::fill(m_distances.begin(), m_distances.end(), 0.0f);
+  for (uint32_t layer = 0; layer < LAYERS; layer++) {
+    float const angle = elevation(layer);
+    if (angle < 0.0f) {
+      float const ground = sensorHeight / std::sin(-angle);
+      if (ground <= m_range) {
+        for (uint32_t column = 0; column < COLUMNS; column++) {
+          m_distances[column * LAYERS + layer] = ground;
+        }
+      }
+    }
+  }
+
+  for (uint32_t i = 0; i < a_track.coneCount(); i++) {
+    Eigen::Vector2f const cone = toVehicleFrame(a_track.cone(i), a_pose);
+    float const distance = cone.norm();
+    if (distance <= coneRadius || distance > m_range + coneRadius) {
+      continue;
+    }
+    float const azimuth = -std::atan2(cone(1), cone(0)) * 180.0f / pi;
+    float const halfWidth = std::asin(coneRadius / distance) * 180.0f / pi;
+    int32_t const first = static_cast<int32_t>(
+        std::ceil((azimuth - halfWidth) / resolution));
+    int32_t const last = static_cast<int32_t>(
+        std::floor((azimuth + halfWidth) / resolution));
+    for (int32_t c = first; c <= last; c++) {
+      float const rayAngle = -static_cast<float>(c) * resolution * pi / 180.0f;
+      float const along = std::cos(rayAngle) * cone(0)
+        + std::sin(rayAngle) * cone(1);
+      float const acrossSquared = distance * distance - along * along;
+      if (acrossSquared > coneRadius * coneRadius) {
+        continue;
+      }
+      float const hit = along - std::sqrt(coneRadius * coneRadius - acrossSquared);
+      uint32_t const column = static_cast<uint32_t>(
+          (c % static_cast<int32_t>(COLUMNS) + static_cast<int32_t>(COLUMNS))
+          % static_cast<int32_t>(COLUMNS));
+      for (uint32_t layer = 0; layer < LAYERS; layer++) {
+        float const angle = elevation(layer);
+        float const height = sensorHeight + hit * std::tan(angle);
+        float const range = hit / std::cos(angle);
+        float &point = m_distances[column * LAYERS + layer];
+        if (height >= 0.0f && height <= coneHeight && range <= m_range
+            && (point <= 0.0f || range < point)) {
+          point = range;
+        }
+      }
+    }
+  }
+
+  std::string distances(2 * COLUMNS * LAYERS, '\0');
+  for (uint32_t i = 0; i < COLUMNS * LAYERS; i++) {
+    if (m_distances[i] > 0.0f && !isDropped()) {
+      float const centimetres =
+        std::round(100.0f * withRangeNoise(m_distances[i]));
+      uint16_t const value = static_cast<uint16_t>(
+          std::min(std::max(centimetres, 1.0f), 65535.0f));
+      distances[2 * i] = static_cast<char>(value >> 8);
+      distances[2 * i + 1] = static_cast<char>(value & 0xff);
+    }
+  }
+  return odcore::data::CompactPointCloud(0.0f, 360.0f, LAYERS, distances, 0);
+}
+
+/**
+ * Cones in range and in front of the car, as the cone detection sends them:
+ * an object, its direction, distance and type, all with the index of the
+ * cone as object id. The azimuth is counterclockwise in radians.
+ */
+std::vector<odcore::data::Container> SyntheticSensor::objects(
+    SyntheticTrack const &a_track, Eigen::Vector3f const &a_pose)
+{
+  std::vector<odcore::data::Container> containers;
+  for (uint32_t i = 0; i < a_track.coneCount(); i++) {
+    Eigen::Vector2f const cone = toVehicleFrame(a_track.cone(i), a_pose);
+    float const distance = cone.norm();
+    float const azimuth = std::atan2(cone(1), cone(0));
+    if (distance > m_range || std::fabs(azimuth) > 0.5f * fieldOfView
+        || isDropped()) {
+      continue;
+    }
+    opendlv::logic::perception::Object object(i);
+    opendlv::logic::perception::ObjectDirection direction(i,
+        withAngleNoise(azimuth), 0.0f);
+    opendlv::logic::perception::ObjectDistance objectDistance(i,
+        withRangeNoise(distance));
+    opendlv::logic::perception::ObjectType type(i,
+        static_cast<uint32_t>(a_track.coneType(i)));
+    containers.push_back(odcore::data::Container(object));
+    containers.push_back(odcore::data::Container(direction));
+    containers.push_back(odcore::data::Container(objectDistance));
+    containers.push_back(odcore::data::Container(type));
+  }
+  return containers;
+}
+
+/**
+ * Surfaces between the boundaries of the track from the given arc length
+ * onwards, one cone spacing long each, in the frame of the car at the given
+ * pose.
+ */
+std::vector<odcore::data::Container> SyntheticSensor::surfaces(
+    SyntheticTrack const &a_track, Eigen::Vector3f const &a_pose,
+    float a_distance, uint32_t a_count) const
+{
+  float const halfWidth = 0.5f * SyntheticTrack::WIDTH;
+  std::vector<odcore::data::Container> containers;
+  containers.reserve(a_count);
+  for (uint32_t i = 0; i < a_count; i++) {
+    float const near = a_distance + SyntheticTrack::CONE_SPACING * static_cast<float>(i);
+    float const far = near + SyntheticTrack::CONE_SPACING;
+    Eigen::Vector2f const nearLeft = toVehicleFrame(a_track.boundaryAt(near, halfWidth), a_pose);
+    Eigen::Vector2f const nearRight = toVehicleFrame(a_track.boundaryAt(near, -halfWidth), a_pose);
+    Eigen::Vector2f const farLeft = toVehicleFrame(a_track.boundaryAt(far, halfWidth), a_pose);
+    Eigen::Vector2f const farRight = toVehicleFrame(a_track.boundaryAt(far, -halfWidth), a_pose);
+    opendlv::logic::perception::Surface surface(i, nearLeft(0), nearLeft(1),
+        nearRight(0), nearRight(1), farLeft(0), farLeft(1), farRight(0),
+        farRight(1));
+    containers.push_back(odcore::data::Container(surface));
+  }
+  return containers;
+}
+
+/**
+ * Position of the car in degrees, on a flat earth around a point at the
+ * Hockenheimring, and its heading in radians counterclockwise from east.
+ */
+opendlv::logic::sensation::Geolocation SyntheticSensor::geolocation(
+    Eigen::Vector3f const &a_pose)
+{
+  double const degrees = 180.0 / M_PI;
+  double const north = static_cast<double>(withRangeNoise(a_pose(1)));
+  double const east = static_cast<double>(withRangeNoise(a_pose(0)));
+  double const latitude = originLatitude + degrees * north / earthRadius;
+  double const longitude = originLongitude
+    + degrees * east / (earthRadius * std::cos(originLatitude / degrees));
+  return opendlv::logic::sensation::Geolocation(latitude, longitude, 0.0f,
+      withAngleNoise(a_pose(2)));
+}
+
+float SyntheticSensor::withRangeNoise(float a_value)
+{
+  return (m_rangeNoise > 0.0f)
+    ? a_value + m_rangeNoise * m_normal(m_generator) : a_value;
+}
+
+float SyntheticSensor::withAngleNoise(float a_value)
+{
+  return (m_angleNoise > 0.0f)
+    ? a_value + m_angleNoise * m_normal(m_generator) : a_value;
+}
+
+bool SyntheticSensor::isDropped()
+{
+  return m_dropout > 0.0f && m_uniform(m_generator) < m_dropout;
+}
+
+}
+}
+}
+}
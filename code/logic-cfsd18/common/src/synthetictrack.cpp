@@ -0,0 +1,334 @@
+/**
+* Copyright (C) 2017 Chalmers Revere
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+* USA.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "synthetictrack.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace common {
+
+float const SyntheticTrack::WIDTH = 3.0f;
+float const SyntheticTrack::CONE_SPACING = 4.0f;
+float const SyntheticTrack::MIN_RADIUS = 6.0f;
+
+SyntheticTrack::SyntheticTrack() :
+  m_x(),
+  m_y(),
+  m_type(),
+  m_centreline()
+{
+}
+
+SyntheticTrack::~SyntheticTrack()
+{
+}
+
+/**
+ * A 75 m straight between big orange cones, followed by 100 m of braking
+ * area lined with orange cones.
+ */
+SyntheticTrack SyntheticTrack::acceleration()
+{
+  float const length = 75.0f;
+  float const brakingLength = 100.0f;
+  float const halfWidth = 0.5f * WIDTH;
+
+  SyntheticTrack track;
+  track.extendCentreline(0.0f, 0.0f);
+  track.extendCentreline(length + brakingLength, 0.0f);
+  uint32_t const gates = 15;
+  for (uint32_t i = 0; i <= gates; i++) {
+    float const x = length * static_cast<float>(i) / gates;
+    bool const isTimingLine = (i == 0 || i == gates);
+    track.addCone(x, halfWidth, isTimingLine ? ConeType::BigOrange : ConeType::Blue);
+    track.addCone(x, -halfWidth, isTimingLine ? ConeType::BigOrange : ConeType::Yellow);
+  }
+  for (float x = length + 5.0f; x <= length + brakingLength; x += 5.0f) {
+    track.addCone(x, halfWidth, ConeType::Orange);
+    track.addCone(x, -halfWidth, ConeType::Orange);
+  }
+  return track;
+}
+
+/**
+ * Two pairs of circles with a centreline radius of 9.125 m, which the car
+ * enters along the x axis, drives twice clockwise around the right circle,
+ * twice counterclockwise around the left circle and leaves. The outer cones
+ * are left out where the two outer circles overlap.
+ */
+SyntheticTrack SyntheticTrack::skidpad()
+{
+  float const pi = static_cast<float>(M_PI);
+  float const radius = 9.125f;
+  float const innerRadius = 7.625f;
+  float const outerRadius = 10.625f;
+  float const lane = 20.0f;
+  float const step = 0.5f;
+
+  SyntheticTrack track;
+  for (float x = -lane; x < 0.0f; x += step) {
+    track.extendCentreline(x, 0.0f);
+  }
+  uint32_t const circleSteps =
+    static_cast<uint32_t>(std::ceil(2.0f * 2.0f * pi * radius / step));
+  for (uint32_t i = 0; i < circleSteps; i++) {
+    float const angle = 0.5f * pi - 4.0f * pi * static_cast<float>(i) / circleSteps;
+    track.extendCentreline(radius * std::cos(angle), -radius + radius * std::sin(angle));
+  }
+  for (uint32_t i = 0; i < circleSteps; i++) {
+    float const angle = -0.5f * pi + 4.0f * pi * static_cast<float>(i) / circleSteps;
+    track.extendCentreline(radius * std::cos(angle), radius + radius * std::sin(angle));
+  }
+  for (float x = 0.0f; x <= lane; x += step) {
+    track.extendCentreline(x, 0.0f);
+  }
+
+  for (int32_t side = -1; side <= 1; side += 2) {
+    float const centre = static_cast<float>(side) * radius;
+    ConeType const inner = (side < 0) ? ConeType::Yellow : ConeType::Blue;
+    ConeType const outer = (side < 0) ? ConeType::Blue : ConeType::Yellow;
+    for (uint32_t i = 0; i < 16; i++) {
+      float const angle = 2.0f * pi * static_cast<float>(i) / 16.0f;
+      track.addCone(innerRadius * std::cos(angle),
+          centre + innerRadius * std::sin(angle), inner);
+    }
+    for (uint32_t i = 0; i < 13; i++) {
+      float const angle = 2.0f * pi * static_cast<float>(i) / 13.0f;
+      float const x = outerRadius * std::cos(angle);
+      float const y = centre + outerRadius * std::sin(angle);
+      if (std::hypot(x, y + centre) >= outerRadius) {
+        track.addCone(x, y, outer);
+      }
+    }
+  }
+  for (float x = 10.0f; x <= lane; x += 5.0f) {
+    track.addCone(-x, 0.5f * WIDTH, ConeType::Orange);
+    track.addCone(-x, -0.5f * WIDTH, ConeType::Orange);
+    track.addCone(x, 0.5f * WIDTH, ConeType::Orange);
+    track.addCone(x, -0.5f * WIDTH, ConeType::Orange);
+  }
+  return track;
+}
+
+/**
+ * A closed loop of the given length, drawn around a circle whose radius is
+ * perturbed by random harmonics, about one corner per 150 m. The harmonics
+ * are damped until no corner is tighter than the minimum radius, so that
+ * the cones of the inner boundary never cross, and the same seed always
+ * gives the same track.
+ */
+SyntheticTrack SyntheticTrack::trackdrive(float a_length, uint32_t a_seed)
+{
+  float const pi = static_cast<float>(M_PI);
+  float const length = std::max(a_length, 2.0f * pi * 2.0f * MIN_RADIUS);
+  uint32_t const harmonics = std::max(4u, static_cast<uint32_t>(length / 150.0f));
+  uint32_t const points = static_cast<uint32_t>(std::ceil(length));
+
+  std::mt19937 generator(a_seed);
+  std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+  std::vector<float> amplitudes;
+  std::vector<float> phases;
+  for (uint32_t k = 2; k < harmonics + 2; k++) {
+    amplitudes.push_back(0.3f * uniform(generator)
+        / std::pow(static_cast<float>(k), 1.5f));
+    phases.push_back(2.0f * pi * uniform(generator));
+  }
+
+  SyntheticTrack track;
+  for (float damping = 1.0f; ; damping *= 0.8f) {
+    std::vector<float> x(points + 1);
+    std::vector<float> y(points + 1);
+    float perimeter = 0.0f;
+    for (uint32_t i = 0; i <= points; i++) {
+      float const angle = 2.0f * pi * static_cast<float>(i % points) / points;
+      float r = 1.0f;
+      for (uint32_t k = 0; k < amplitudes.size(); k++) {
+        r += damping * amplitudes[k] * std::sin((k + 2) * angle + phases[k]);
+      }
+      x[i] = r * std::cos(angle);
+      y[i] = r * std::sin(angle);
+      if (i > 0) {
+        perimeter += std::hypot(x[i] - x[i - 1], y[i] - y[i - 1]);
+      }
+    }
+
+    track.m_centreline.clear();
+    float const scale = length / perimeter;
+    for (uint32_t i = 0; i <= points; i++) {
+      track.extendCentreline(scale * x[i], scale * y[i]);
+    }
+    float maxCurvature = 0.0f;
+    for (uint32_t i = 1; i < points; i++) {
+      maxCurvature = std::max(maxCurvature, track.m_centreline.curvatureAt(i));
+    }
+    if (maxCurvature <= 1.0f / MIN_RADIUS || damping < 0.01f) {
+      break;
+    }
+  }
+
+  track.addBoundaryCones(ConeType::Blue, ConeType::Yellow);
+  track.m_type[0] = ConeType::BigOrange;
+  track.m_type[1] = ConeType::BigOrange;
+  return track;
+}
+
+void SyntheticTrack::addCone(float a_x, float a_y, ConeType a_type)
+{
+  m_x.push_back(a_x);
+  m_y.push_back(a_y);
+  m_type.push_back(a_type);
+}
+
+void SyntheticTrack::extendCentreline(float a_x, float a_y)
+{
+  m_centreline.append(a_x, a_y);
+}
+
+uint32_t SyntheticTrack::coneCount() const
+{
+  return static_cast<uint32_t>(m_x.size());
+}
+
+Eigen::Vector2f SyntheticTrack::cone(uint32_t a_index) const
+{
+  return Eigen::Vector2f(m_x[a_index], m_y[a_index]);
+}
+
+ConeType SyntheticTrack::coneType(uint32_t a_index) const
+{
+  return m_type[a_index];
+}
+
+Path const &SyntheticTrack::centreline() const
+{
+  return m_centreline;
+}
+
+bool SyntheticTrack::isClosed() const
+{
+  return m_centreline.size() > 2
+    && (m_centreline.pointAt(0.0f) - m_centreline.pointAt(m_centreline.length())).norm()
+    < 1e-3f;
+}
+
+/**
+ * Position and heading of the car on the centreline at the given arc
+ * length, which wraps around on a closed track.
+ */
+Eigen::Vector3f SyntheticTrack::poseAt(float a_distance) const
+{
+  float const length = m_centreline.length();
+  float distance = a_distance;
+  if (isClosed() && length > 0.0f) {
+    distance = std::fmod(a_distance, length);
+    distance = (distance < 0.0f) ? distance + length : distance;
+  }
+  float const delta = 0.5f;
+  Eigen::Vector2f const position = m_centreline.pointAt(distance);
+  Eigen::Vector2f const direction = m_centreline.pointAt(distance + delta)
+    - m_centreline.pointAt(distance - delta);
+  return Eigen::Vector3f(position(0), position(1),
+      std::atan2(direction(1), direction(0)));
+}
+
+/**
+ * Point at the given lateral offset from the centreline, positive to the
+ * left.
+ */
+Eigen::Vector2f SyntheticTrack::boundaryAt(float a_distance, float a_offset) const
+{
+  Eigen::Vector3f const pose = poseAt(a_distance);
+  return Eigen::Vector2f(pose(0) - a_offset * std::sin(pose(2)),
+      pose(1) + a_offset * std::cos(pose(2)));
+}
+
+/**
+ * Arc length of the point on the centreline closest to the given position,
+ * searched for in steps of 2 cm within the given window after a guess, such
+ * as the previous result. On a closed track the result keeps counting up
+ * over laps.
+ */
+float SyntheticTrack::distanceAlong(Eigen::Vector2f const &a_position,
+    float a_guess, float a_window) const
+{
+  float const step = 0.02f;
+  float bestDistance = a_guess;
+  float bestError = -1.0f;
+  for (float distance = a_guess - 0.25f * a_window;
+      distance <= a_guess + a_window; distance += step) {
+    Eigen::Vector3f const pose = poseAt(distance);
+    float const error = (Eigen::Vector2f(pose(0), pose(1)) - a_position)
+      .squaredNorm();
+    if (bestError < 0.0f || error < bestError) {
+      bestError = error;
+      bestDistance = distance;
+    }
+  }
+  return isClosed() ? bestDistance
+    : std::min(std::max(bestDistance, 0.0f), m_centreline.length());
+}
+
+/**
+ * Arc lengths at which the car, driving along the centreline with the given
+ * speed, is sampled at the given rate until it has covered the distance.
+ * A closed track is lapped; an open track ends the drive at its end.
+ */
+std::vector<float> SyntheticTrack::drive(float a_speed, float a_rate,
+    float a_distance) const
+{
+  float const length = m_centreline.length();
+  float const distance = isClosed() ? a_distance : std::min(a_distance, length);
+  float const step = a_speed / a_rate;
+  std::vector<float> distances;
+  if (step <= 0.0f) {
+    return distances;
+  }
+  distances.reserve(static_cast<uint32_t>(distance / step) + 1);
+  for (uint64_t i = 0; static_cast<float>(i) * step <= distance; i++) {
+    distances.push_back(static_cast<float>(i) * step);
+  }
+  return distances;
+}
+
+/**
+ * Cones along both sides of the centreline, the same distance apart.
+ */
+void SyntheticTrack::addBoundaryCones(ConeType a_left, ConeType a_right)
+{
+  float const length = m_centreline.length();
+  uint32_t const count = static_cast<uint32_t>(length / CONE_SPACING);
+  float const spacing = length / static_cast<float>(count);
+  for (uint32_t i = 0; i < count; i++) {
+    float const distance = spacing * static_cast<float>(i);
+    Eigen::Vector2f const left = boundaryAt(distance, 0.5f * WIDTH);
+    Eigen::Vector2f const right = boundaryAt(distance, -0.5f * WIDTH);
+    addCone(left(0), left(1), a_left);
+    addCone(right(0), right(1), a_right);
+  }
+}
+
+}
+}
+}
+}
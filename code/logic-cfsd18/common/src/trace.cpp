@@ -0,0 +1,144 @@
+/**
+* Copyright (C) 2017 Chalmers Revere
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+* USA.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+#include "trace.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace common {
+
+namespace {
+
+double toSeconds(odcore::data::TimeStamp const &a_timeStamp)
+{
+  return static_cast<double>(a_timeStamp.toMicroseconds()) / 1000000.0;
+}
+
+}
+
+odcore::data::TimeStamp originOf(odcore::data::Container &a_container)
+{
+  odcore::data::TimeStamp const sampleTimeStamp =
+    a_container.getSampleTimeStamp();
+  if (sampleTimeStamp.toMicroseconds() != 0) {
+    return sampleTimeStamp;
+  }
+  return a_container.getSentTimeStamp();
+}
+
+/**
+ * Gives the effect the origin of its cause.
+ */
+void propagateOrigin(odcore::data::Container &a_cause,
+    odcore::data::Container &a_effect)
+{
+  a_effect.setSampleTimeStamp(originOf(a_cause));
+}
+
+/**
+ * Nearest-rank percentile, or zero without samples.
+ */
+double percentile(std::vector<double> a_samples, float a_percentile)
+{
+  if (a_samples.empty()) {
+    return 0.0;
+  }
+  float const rank = std::ceil(a_percentile / 100.0f
+      * static_cast<float>(a_samples.size()));
+  uint32_t const index = static_cast<uint32_t>(
+      std::min(std::max(rank, 1.0f), static_cast<float>(a_samples.size()))) - 1;
+  std::nth_element(a_samples.begin(), a_samples.begin() + index,
+      a_samples.end());
+  return a_samples[index];
+}
+
+StageTrace::StageTrace() :
+  m_enterTime(),
+  m_stageTimes(),
+  m_totalTimes(),
+  m_next(0)
+{
+  m_stageTimes.reserve(CAPACITY);
+  m_totalTimes.reserve(CAPACITY);
+}
+
+StageTrace::~StageTrace()
+{
+}
+
+void StageTrace::enter()
+{
+  m_enterTime = odcore::data::TimeStamp();
+}
+
+/**
+ * Records the times [s] of a container sent by the stage at the given time.
+ * The stage time is always measured on the wall clock, while the time since
+ * the origin follows the clock of the data, which a simulation may step.
+ */
+void StageTrace::exit(odcore::data::Container &a_container,
+    odcore::data::TimeStamp const &a_now)
+{
+  double const stageTime = toSeconds(odcore::data::TimeStamp() - m_enterTime);
+  double const totalTime = toSeconds(a_now - originOf(a_container));
+  if (m_stageTimes.size() < CAPACITY) {
+    m_stageTimes.push_back(stageTime);
+    m_totalTimes.push_back(totalTime);
+  } else {
+    m_stageTimes[m_next] = stageTime;
+    m_totalTimes[m_next] = totalTime;
+  }
+  m_next = (m_next + 1) % CAPACITY;
+}
+
+uint32_t StageTrace::size() const
+{
+  return static_cast<uint32_t>(m_stageTimes.size());
+}
+
+double StageTrace::stagePercentile(float a_percentile) const
+{
+  return percentile(m_stageTimes, a_percentile);
+}
+
+double StageTrace::totalPercentile(float a_percentile) const
+{
+  return percentile(m_totalTimes, a_percentile);
+}
+
+std::string StageTrace::report() const
+{
+  std::stringstream report;
+  report << "stage p50 " << stagePercentile(50.0f) * 1000.0 << " ms, p99 "
+    << stagePercentile(99.0f) * 1000.0 << " ms, since origin p50 "
+    << totalPercentile(50.0f) * 1000.0 << " ms, p99 "
+    << totalPercentile(99.0f) * 1000.0 << " ms over " << size()
+    << " samples";
+  return report.str();
+}
+
+}
+}
+}
+}
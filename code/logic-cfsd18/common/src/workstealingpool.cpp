@@ -0,0 +1,192 @@
+/**
+* Copyright (C) 2017 Chalmers Revere
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+* USA.
+*/
+
+#include <algorithm>
+
+#include "workstealingpool.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace common {
+
+WorkStealingPool::Queue::Queue() :
+  mutex(),
+  indices()
+{
+}
+
+/**
+ * Takes the number of workers, including the thread that runs the loops, so
+ * that one worker runs everything in that thread.
+ */
+WorkStealingPool::WorkStealingPool(uint32_t a_size) :
+  m_queues(),
+  m_threads(),
+  m_mutex(),
+  m_start(),
+  m_finish(),
+  m_task(),
+  m_generation(0),
+  m_busy(0),
+  m_isRunning(true),
+  m_steals(0)
+{
+  for (uint32_t i = 0; i < std::max(a_size, 1u); i++) {
+    m_queues.push_back(std::unique_ptr<Queue>(new Queue));
+  }
+  for (uint32_t i = 1; i < m_queues.size(); i++) {
+    m_threads.push_back(std::thread(&WorkStealingPool::run, this, i));
+  }
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isRunning = false;
+  }
+  m_start.notify_all();
+  for (auto &thread : m_threads) {
+    thread.join();
+  }
+}
+
+uint32_t WorkStealingPool::size() const
+{
+  return static_cast<uint32_t>(m_queues.size());
+}
+
+/**
+ * Calls the task with every index below the count and the worker that runs
+ * it, and returns when all have been run. Only one loop runs at a time.
+ */
+void WorkStealingPool::parallelFor(uint32_t a_count, Task a_task)
+{
+  uint32_t const workers = size();
+  if (workers == 1) {
+    for (uint32_t i = 0; i < a_count; i++) {
+      a_task(i, 0);
+    }
+    return;
+  }
+
+  for (uint32_t worker = 0; worker < workers; worker++) {
+    Queue &queue = *m_queues[worker];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    uint64_t const first = static_cast<uint64_t>(a_count) * worker / workers;
+    uint64_t const last =
+      static_cast<uint64_t>(a_count) * (worker + 1) / workers;
+    for (uint64_t i = first; i < last; i++) {
+      queue.indices.push_back(static_cast<uint32_t>(i));
+    }
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_task = a_task;
+    m_generation++;
+    m_busy = workers - 1;
+  }
+  m_start.notify_all();
+
+  work(0, a_task);
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_finish.wait(lock, [this]() { return m_busy == 0; });
+  m_task = nullptr;
+}
+
+/**
+ * The number of indices that were run by another worker than the one they
+ * were given to.
+ */
+uint64_t WorkStealingPool::steals() const
+{
+  return m_steals;
+}
+
+void WorkStealingPool::run(uint32_t a_worker)
+{
+  uint64_t generation = 0;
+  while (true) {
+    Task task;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_start.wait(lock, [this, generation]() {
+          return !m_isRunning || m_generation != generation;
+        });
+      if (!m_isRunning) {
+        return;
+      }
+      generation = m_generation;
+      task = m_task;
+    }
+
+    work(a_worker, task);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_busy--;
+    if (m_busy == 0) {
+      m_finish.notify_one();
+    }
+  }
+}
+
+void WorkStealingPool::work(uint32_t a_worker, Task const &a_task)
+{
+  uint32_t index = 0;
+  while (take(a_worker, index)) {
+    a_task(index, a_worker);
+  }
+}
+
+/**
+ * Takes the next index of a worker's own block, or else the last one left
+ * in the block of another worker. Since all indices are handed out before
+ * the loop starts, there is nothing left to do once this fails.
+ */
+bool WorkStealingPool::take(uint32_t a_worker, uint32_t &a_index)
+{
+  {
+    Queue &queue = *m_queues[a_worker];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.indices.empty()) {
+      a_index = queue.indices.front();
+      queue.indices.pop_front();
+      return true;
+    }
+  }
+  uint32_t const workers = size();
+  for (uint32_t i = 1; i < workers; i++) {
+    Queue &queue = *m_queues[(a_worker + i) % workers];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.indices.empty()) {
+      a_index = queue.indices.back();
+      queue.indices.pop_back();
+      m_steals++;
+      return true;
+    }
+  }
+  return false;
+}
+
+}
+}
+}
+}
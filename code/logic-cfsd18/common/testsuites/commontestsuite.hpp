@@ -0,0 +1,987 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_COMMON_TESTSUITE_HPP
+#define OPENDLV_LOGIC_CFSD18_COMMON_TESTSUITE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <map>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cxxtest/TestSuite.h"
+
+#include "../include/arena.hpp"
+#include "../include/benchmark.hpp"
+#include "../include/busport.hpp"
+#include "../include/dispatcher.hpp"
+#include "../include/fixedrateloop.hpp"
+#include "../include/gainschedule.hpp"
+#include "../include/histogram.hpp"
+#include "../include/inprocessbus.hpp"
+#include "../include/instrumentation.hpp"
+#include "../include/mailbox.hpp"
+#include "../include/missionsupervisor.hpp"
+#include "../include/path.hpp"
+#include "../include/pipeline.hpp"
+#include "../include/planner.hpp"
+#include "../include/spscring.hpp"
+#include "../include/syntheticsensor.hpp"
+#include "../include/synthetictrack.hpp"
+#include "../include/trace.hpp"
+#include "../include/workstealingpool.hpp"
+
+namespace {
+std::atomic<uint64_t> g_allocations(0);
+}
+
+/**
+ * Counts the heap allocations of the test runner, so that tests can check
+ * what a hot path allocates. The deallocation functions are kept out of line,
+ * since GCC otherwise takes an inlined free() for a mismatch with new.
+ */
+void *operator new(std::size_t a_size)
+{
+  g_allocations++;
+  void *memory = std::malloc(a_size > 0 ? a_size : 1);
+  if (memory == nullptr) {
+    throw std::bad_alloc();
+  }
+  return memory;
+}
+
+__attribute__((noinline)) void operator delete(void *a_memory) noexcept
+{
+  std::free(a_memory);
+}
+
+__attribute__((noinline)) void operator delete(void *a_memory, std::size_t) noexcept
+{
+  std::free(a_memory);
+}
+
+class CommonTest : public CxxTest::TestSuite {
+  public:
+    void setUp()
+    {
+    }
+
+    void tearDown()
+    {
+    }
+
+    void testPathLookupByDistance()
+    {
+      opendlv::logic::cfsd18::common::Path path;
+      path.append(0.0f, 0.0f);
+      path.append(3.0f, 4.0f);
+      path.append(3.0f, 9.0f);
+      TS_ASSERT_DELTA(path.length(), 10.0f, 1e-5f);
+
+      Eigen::Vector2f const point = path.pointAt(7.5f);
+      TS_ASSERT_DELTA(point(0), 3.0f, 1e-5f);
+      TS_ASSERT_DELTA(point(1), 6.5f, 1e-5f);
+      TS_ASSERT_DELTA(path.pointAt(20.0f)(1), 9.0f, 1e-5f);
+    }
+
+    void testPathCurvatureOnCircle()
+    {
+      float const radius = 9.0f;
+      opendlv::logic::cfsd18::common::Path path;
+      for (uint32_t i = 0; i < 10; i++) {
+        float const angle = 0.1f * static_cast<float>(i);
+        path.append(radius * std::sin(angle), radius * (1.0f - std::cos(angle)));
+      }
+      TS_ASSERT_DELTA(path.curvatureAt(5), 1.0f / radius, 1e-3f);
+      TS_ASSERT_DELTA(path.speedLimit(9.0f, 0.0f, 100.0f), 9.0f, 1e-2f);
+    }
+
+    void testPathSpeedLimitOnStraight()
+    {
+      opendlv::logic::cfsd18::common::Path path;
+      for (uint32_t i = 0; i < 10; i++) {
+        path.append(static_cast<float>(i), 0.0f);
+      }
+      TS_ASSERT_DELTA(path.speedLimit(10.0f, 10.0f, 20.0f), 20.0f, 1e-3f);
+    }
+
+    void testGainScheduleInterpolatesAndClamps()
+    {
+      opendlv::logic::cfsd18::common::GainSchedule<3> const schedule{
+        5.0f, {1.0f, 2.0f, 4.0f}};
+      TS_ASSERT_DELTA(schedule.at(-1.0f), 1.0f, 1e-6f);
+      TS_ASSERT_DELTA(schedule.at(2.5f), 1.5f, 1e-6f);
+      TS_ASSERT_DELTA(schedule.at(7.5f), 3.0f, 1e-6f);
+      TS_ASSERT_DELTA(schedule.at(10.0f), 4.0f, 1e-6f);
+      TS_ASSERT_DELTA(schedule.at(100.0f), 4.0f, 1e-6f);
+    }
+
+    void testBusPortsShareContainersInProcess()
+    {
+      using opendlv::logic::cfsd18::common::BusPort;
+      uint32_t producerReceived = 0;
+      uint32_t consumerReceived = 0;
+      uint32_t conferenceSent = 0;
+      auto count = [](uint32_t &a_count) {
+        return [&a_count](odcore::data::Container &) { a_count++; };
+      };
+      BusPort producer(count(producerReceived), count(conferenceSent));
+      BusPort consumer(count(consumerReceived), count(conferenceSent));
+
+      opendlv::proxy::GroundSpeedReading groundSpeedReading(10.0f);
+      odcore::data::Container container(groundSpeedReading);
+      producer.send(container);
+      TS_ASSERT_EQUALS(consumerReceived, 0u);
+      TS_ASSERT_EQUALS(conferenceSent, 1u);
+
+      opendlv::logic::cfsd18::common::InProcessBus bus;
+      producer.attach(bus);
+      consumer.attach(bus);
+      producer.send(container);
+      TS_ASSERT_EQUALS(producerReceived, 0u);
+      TS_ASSERT_EQUALS(consumerReceived, 1u);
+      TS_ASSERT_EQUALS(conferenceSent, 2u);
+      TS_ASSERT(bus.isEcho(container));
+
+      // The mirrored copy coming back from the conference is dropped, while
+      // the same data type sent by another process gets through.
+      consumer.receive(container);
+      TS_ASSERT_EQUALS(consumerReceived, 1u);
+      odcore::data::Container foreign(groundSpeedReading);
+      foreign.setSentTimeStamp(odcore::data::TimeStamp(1, 0));
+      consumer.receive(foreign);
+      TS_ASSERT_EQUALS(consumerReceived, 2u);
+      opendlv::logic::sensation::Geolocation geolocation;
+      odcore::data::Container other(geolocation);
+      consumer.receive(other);
+      TS_ASSERT_EQUALS(consumerReceived, 3u);
+    }
+
+    void testBusPortsDropEchoesThatTheConferenceStamped()
+    {
+      // The conference stamps what it sends and what it receives, so the
+      // mirrored copy comes back with other time stamps than were published.
+      using opendlv::logic::cfsd18::common::BusPort;
+      std::vector<odcore::data::Container> conference;
+      auto stamp = [&conference](odcore::data::Container &a_container) {
+        odcore::data::Container copy(a_container);
+        copy.setSentTimeStamp(odcore::data::TimeStamp(
+              a_container.getSentTimeStamp().getSeconds() + 1, 0));
+        copy.setReceivedTimeStamp(odcore::data::TimeStamp(
+              a_container.getSentTimeStamp().getSeconds() + 2, 0));
+        conference.push_back(copy);
+      };
+      uint32_t consumerReceived = 0;
+      BusPort producer([](odcore::data::Container &) {}, stamp);
+      BusPort consumer([&consumerReceived](odcore::data::Container &) {
+            consumerReceived++;
+          }, stamp);
+      opendlv::logic::cfsd18::common::InProcessBus bus;
+      producer.attach(bus);
+      consumer.attach(bus);
+
+      opendlv::proxy::GroundSpeedReading groundSpeedReading(10.0f);
+      for (uint32_t i = 0; i < 3; i++) {
+        odcore::data::Container container(groundSpeedReading);
+        producer.send(container);
+      }
+      TS_ASSERT_EQUALS(consumerReceived, 3u);
+      TS_ASSERT_EQUALS(conference.size(), 3u);
+      for (auto &echo : conference) {
+        consumer.receive(echo);
+      }
+      TS_ASSERT_EQUALS(consumerReceived, 3u);
+
+      // The same message sampled at another time by another process.
+      odcore::data::Container foreign(groundSpeedReading);
+      foreign.setSampleTimeStamp(odcore::data::TimeStamp(1, 0));
+      consumer.receive(foreign);
+      TS_ASSERT_EQUALS(consumerReceived, 4u);
+    }
+
+    void testBusPortsFollowTheClockOfTheirBus()
+    {
+      using opendlv::logic::cfsd18::common::BusPort;
+      auto ignore = [](odcore::data::Container &) {};
+      BusPort simulated(ignore, ignore);
+      BusPort wall(ignore, ignore);
+      opendlv::logic::cfsd18::common::InProcessBus simulatedBus;
+      opendlv::logic::cfsd18::common::InProcessBus wallBus;
+      simulated.attach(simulatedBus);
+      wall.attach(wallBus);
+
+      simulatedBus.clock().simulate(odcore::data::TimeStamp(100, 0));
+      opendlv::proxy::GroundSpeedReading groundSpeedReading(10.0f);
+      odcore::data::Container container(groundSpeedReading);
+      simulated.send(container);
+      TS_ASSERT_EQUALS(container.getSentTimeStamp().toMicroseconds(),
+          100000000);
+      TS_ASSERT_EQUALS(simulated.now().toMicroseconds(), 100000000);
+
+      // Another bus in the same process keeps the wall clock.
+      TS_ASSERT(!wallBus.clock().isSimulated());
+      TS_ASSERT(wall.now().toMicroseconds() > 100000000);
+      wall.send(container);
+      TS_ASSERT(container.getSentTimeStamp().toMicroseconds() > 100000000);
+
+      simulatedBus.clock().release();
+      TS_ASSERT(simulated.now().toMicroseconds() > 100000000);
+    }
+
+    void testBusPortsPublishToEachOtherFromTwoThreads()
+    {
+      // Two ports get readings from the conference in two threads at the
+      // same time, and each answers on the bus while handling its reading.
+      using opendlv::logic::cfsd18::common::BusPort;
+      std::atomic<uint32_t> locations(0);
+      BusPort *ports[2] = {nullptr, nullptr};
+      auto answer = [&locations, &ports](uint32_t a_port) {
+        return [&locations, &ports, a_port](
+            odcore::data::Container &a_container) {
+          if (a_container.getDataType()
+              == opendlv::logic::sensation::Geolocation::ID()) {
+            locations++;
+            return;
+          }
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+          opendlv::logic::sensation::Geolocation geolocation;
+          odcore::data::Container location(geolocation);
+          ports[a_port]->send(location);
+        };
+      };
+      auto ignore = [](odcore::data::Container &) {};
+      BusPort left(answer(0), ignore);
+      BusPort right(answer(1), ignore);
+      ports[0] = &left;
+      ports[1] = &right;
+
+      opendlv::logic::cfsd18::common::InProcessBus bus;
+      left.attach(bus);
+      right.attach(bus);
+      uint32_t const count = 20;
+      auto receiveReadings = [count](BusPort *a_port) {
+        for (uint32_t i = 0; i < count; i++) {
+          opendlv::proxy::GroundSpeedReading groundSpeedReading(10.0f);
+          odcore::data::Container reading(groundSpeedReading);
+          a_port->receive(reading);
+        }
+      };
+      std::thread leftThread(receiveReadings, &left);
+      std::thread rightThread(receiveReadings, &right);
+      leftThread.join();
+      rightThread.join();
+      TS_ASSERT_EQUALS(locations.load(), 2 * count);
+    }
+
+    void testInactivePlannerDoesNotDeserialiseSurfaces()
+    {
+      struct Mission {
+        static bool serves(opendlv::logic::cfsd18::common::MissionId a_id)
+        {
+          return a_id == opendlv::logic::cfsd18::common::MissionId::Trackdrive;
+        }
+        static bool isPreviewExtrapolated()
+        {
+          return false;
+        }
+        float aimDistance(opendlv::logic::cfsd18::common::Path const &,
+            float) const
+        {
+          return 1.0f;
+        }
+        float previewDistance(opendlv::logic::cfsd18::common::Path const &,
+            float) const
+        {
+          return 2.0f;
+        }
+        float speedLimit(opendlv::logic::cfsd18::common::Path const &,
+            float) const
+        {
+          return 3.0f;
+        }
+      };
+      opendlv::logic::cfsd18::common::Planner<Mission> planner{Mission()};
+      uint32_t sentCount = 0;
+      auto send = [&sentCount](odcore::data::Container &) {
+        sentCount++;
+      };
+      opendlv::logic::perception::Surface surface(0, 0.0f, 1.5f, 0.0f, -1.5f,
+          5.0f, 1.5f, 5.0f, -1.5f);
+      odcore::data::Container surfaceContainer(surface);
+
+      // Deserialising a message allocates, so an inactive planner that
+      // handles a surface must not allocate at all.
+      uint64_t const before = g_allocations.load();
+      planner.nextContainer(surfaceContainer, send);
+      TS_ASSERT_EQUALS(g_allocations.load() - before, 0u);
+      TS_ASSERT_EQUALS(sentCount, 0u);
+
+      opendlv::system::SystemOperationState systemOperationState(
+          static_cast<int32_t>(
+            opendlv::logic::cfsd18::common::MissionId::Trackdrive), "");
+      odcore::data::Container systemOperationStateContainer(
+          systemOperationState);
+      planner.nextContainer(systemOperationStateContainer, send);
+      planner.nextContainer(surfaceContainer, send);
+      TS_ASSERT_EQUALS(sentCount, 3u);
+      TS_ASSERT_DELTA(planner.path().length(), 5.0f, 1e-4f);
+    }
+
+    void testSpscRingKeepsOrderAcrossThreads()
+    {
+      opendlv::logic::cfsd18::common::SpscRing<uint32_t, 4> ring;
+      uint32_t value = 0;
+      TS_ASSERT(ring.isEmpty());
+      TS_ASSERT(!ring.tryPop(value));
+      for (uint32_t i = 0; i < 4; i++) {
+        TS_ASSERT(ring.tryPush(i));
+      }
+      TS_ASSERT(!ring.tryPush(4u));
+      TS_ASSERT(ring.tryPop(value));
+      TS_ASSERT_EQUALS(value, 0u);
+
+      uint32_t const count = 100000;
+      std::thread producer([&ring, count]() {
+          for (uint32_t i = 4; i < count; i++) {
+            ring.push(i);
+          }
+        });
+      bool isOrdered = true;
+      for (uint32_t i = 1; i < count; i++) {
+        ring.pop(value);
+        isOrdered = isOrdered && value == i;
+      }
+      producer.join();
+      TS_ASSERT(isOrdered);
+      TS_ASSERT(ring.isEmpty());
+    }
+
+    void testPipelineRunsStagesInOrder()
+    {
+      opendlv::logic::cfsd18::common::Pipeline<uint32_t, 4> pipeline;
+      std::vector<uint32_t> results;
+      std::thread::id lastStageThread;
+      pipeline.add([](uint32_t &a_value) { a_value *= 2; });
+      pipeline.add([](uint32_t &a_value) { a_value += 1; });
+      pipeline.add([&results, &lastStageThread](uint32_t &a_value) {
+          results.push_back(a_value);
+          lastStageThread = std::this_thread::get_id();
+        });
+      TS_ASSERT(!pipeline.tryPush(0u));
+      pipeline.start();
+
+      uint32_t const count = 1000;
+      for (uint32_t i = 0; i < count; i++) {
+        uint32_t value = i;
+        pipeline.push(std::move(value));
+      }
+      pipeline.drain();
+      TS_ASSERT_EQUALS(pipeline.completed(), count);
+      TS_ASSERT_EQUALS(pipeline.dropped(), 1u);
+
+      // Idle stages sleep instead of polling, and still wake for a frame.
+      std::clock_t const idleStart = std::clock();
+      std::this_thread::sleep_for(std::chrono::milliseconds(500));
+      double const idleTime = static_cast<double>(std::clock() - idleStart)
+        / static_cast<double>(CLOCKS_PER_SEC);
+      TS_ASSERT(idleTime < 0.02);
+      uint32_t last = count;
+      pipeline.push(std::move(last));
+      pipeline.drain();
+      TS_ASSERT_EQUALS(pipeline.completed(), count + 1);
+      pipeline.stop();
+
+      bool isOrdered = results.size() == count + 1;
+      for (uint32_t i = 0; i < results.size(); i++) {
+        isOrdered = isOrdered && results[i] == 2 * i + 1;
+      }
+      TS_ASSERT(isOrdered);
+      TS_ASSERT(lastStageThread != std::this_thread::get_id());
+    }
+
+    void testWorkStealingPoolRunsEveryIndexOnce()
+    {
+      opendlv::logic::cfsd18::common::WorkStealingPool pool(4);
+      TS_ASSERT_EQUALS(pool.size(), 4u);
+
+      uint32_t const count = 1000;
+      std::vector<std::atomic<uint32_t>> runs(count);
+      std::vector<std::atomic<uint32_t>> workers(pool.size());
+      for (uint32_t loop = 0; loop < 3; loop++) {
+        pool.parallelFor(count, [&runs, &workers](uint32_t a_i,
+              uint32_t a_worker) {
+            if (a_i < 10) {
+              std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            runs[a_i]++;
+            workers[a_worker]++;
+          });
+      }
+      bool isEveryIndexRun = true;
+      for (auto const &run : runs) {
+        isEveryIndexRun = isEveryIndexRun && run == 3;
+      }
+      TS_ASSERT(isEveryIndexRun);
+      uint32_t total = 0;
+      for (auto const &worker : workers) {
+        total += worker;
+      }
+      TS_ASSERT_EQUALS(total, 3 * count);
+
+      opendlv::logic::cfsd18::common::WorkStealingPool serial(1);
+      std::thread::id thread;
+      serial.parallelFor(1, [&thread](uint32_t, uint32_t) {
+          thread = std::this_thread::get_id();
+        });
+      TS_ASSERT(thread == std::this_thread::get_id());
+    }
+
+    void testArenaStopsAllocatingOnceWarm()
+    {
+      opendlv::logic::cfsd18::common::Arena arena(256);
+      TS_ASSERT_EQUALS(arena.blockAllocations(), 1u);
+
+      // The first frame outgrows the first block, and the reset after it
+      // replaces the blocks by one that holds every frame since. The
+      // containers of a frame go before its reset.
+      uint64_t warm = 0;
+      for (uint32_t frame = 0; frame < 3; frame++) {
+        {
+          opendlv::logic::cfsd18::common::ArenaVector<double> values{
+            opendlv::logic::cfsd18::common::ArenaAllocator<double>(arena)};
+          for (uint32_t i = 0; i < 100; i++) {
+            values.push_back(i);
+          }
+          TS_ASSERT_EQUALS(
+              reinterpret_cast<uint64_t>(values.data()) % alignof(double), 0u);
+          TS_ASSERT_DELTA(values[99], 99.0, 1e-9);
+
+          opendlv::logic::cfsd18::common::ArenaUnorderedMap<uint32_t, uint32_t>
+            counts(8, std::hash<uint32_t>(), std::equal_to<uint32_t>(),
+                opendlv::logic::cfsd18::common::ArenaAllocator<
+                  std::pair<uint32_t const, uint32_t>>(arena));
+          for (uint32_t i = 0; i < 100; i++) {
+            counts[i % 10]++;
+          }
+          TS_ASSERT_EQUALS(counts.size(), 10u);
+          TS_ASSERT_EQUALS(counts[3], 10u);
+          TS_ASSERT_LESS_THAN(0u, arena.used());
+        }
+        arena.reset();
+        TS_ASSERT_EQUALS(arena.used(), 0u);
+        if (frame == 0) {
+          warm = arena.blockAllocations();
+          TS_ASSERT_LESS_THAN(1u, warm);
+        }
+      }
+      TS_ASSERT_EQUALS(arena.blockAllocations(), warm);
+    }
+
+    void testArenaIsOnlyResetWhenTheOutermostFrameEnds()
+    {
+      // A handler that takes its temporaries from the arena of its
+      // microservice, and that is delivered another container while it
+      // still uses them.
+      using opendlv::logic::cfsd18::common::ArenaAllocator;
+      using opendlv::logic::cfsd18::common::ArenaVector;
+      opendlv::logic::cfsd18::common::Arena arena(256);
+      opendlv::logic::cfsd18::common::BusPort *port = nullptr;
+      uint32_t depth = 0;
+      bool isIntact = true;
+      auto receive = [&arena, &port, &depth, &isIntact](
+          odcore::data::Container &) {
+        opendlv::logic::cfsd18::common::ArenaFrame const frame(arena);
+        uint32_t const level = depth++;
+        ArenaVector<uint32_t> values(64, level,
+            ArenaAllocator<uint32_t>(arena));
+        if (level == 0) {
+          opendlv::proxy::GroundSpeedReading groundSpeedReading(10.0f);
+          odcore::data::Container nested(groundSpeedReading);
+          port->receive(nested);
+          TS_ASSERT_EQUALS(arena.depth(), 1u);
+          TS_ASSERT_LESS_THAN(0u, arena.used());
+        }
+        for (uint32_t const value : values) {
+          isIntact = isIntact && value == level;
+        }
+        // Allocations after the nested frame must not reuse its memory.
+        ArenaVector<uint32_t> more(64, 7, ArenaAllocator<uint32_t>(arena));
+        for (uint32_t const value : values) {
+          isIntact = isIntact && value == level;
+        }
+      };
+      opendlv::logic::cfsd18::common::BusPort busPort(receive,
+          [](odcore::data::Container &) {});
+      port = &busPort;
+
+      opendlv::proxy::GroundSpeedReading groundSpeedReading(10.0f);
+      odcore::data::Container container(groundSpeedReading);
+      busPort.receive(container);
+      TS_ASSERT_EQUALS(depth, 2u);
+      TS_ASSERT(isIntact);
+      TS_ASSERT_EQUALS(arena.depth(), 0u);
+      TS_ASSERT_EQUALS(arena.used(), 0u);
+    }
+
+    void testQueuedBusDeliversInSubscriberThread()
+    {
+      // The consumer is held up in its first container, so that its ring
+      // fills up. Publishing more than fits must wait, and lose nothing.
+      using opendlv::logic::cfsd18::common::BusPort;
+      std::atomic<uint32_t> received(0);
+      std::atomic<bool> isHeldUp(true);
+      std::thread::id receiver;
+      BusPort producer([](odcore::data::Container &) {},
+          [](odcore::data::Container &) {});
+      BusPort consumer([&received, &isHeldUp, &receiver](
+            odcore::data::Container &) {
+            receiver = std::this_thread::get_id();
+            received++;
+            while (isHeldUp) {
+              std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+          },
+          [](odcore::data::Container &) {});
+
+      opendlv::logic::cfsd18::common::InProcessBus bus(
+          opendlv::logic::cfsd18::common::Delivery::Queued);
+      producer.attach(bus);
+      consumer.attach(bus);
+      bus.start();
+      std::thread release([&isHeldUp]() {
+          std::this_thread::sleep_for(std::chrono::milliseconds(50));
+          isHeldUp = false;
+        });
+      uint32_t const count =
+        8 * opendlv::logic::cfsd18::common::InProcessBus::RING_CAPACITY;
+      opendlv::proxy::GroundSpeedReading groundSpeedReading(10.0f);
+      odcore::data::Container container(groundSpeedReading);
+      for (uint32_t i = 0; i < count; i++) {
+        producer.send(container);
+      }
+      TS_ASSERT(!isHeldUp);
+      release.join();
+      for (uint32_t i = 0; i < 1000 && received < count; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      bus.stop();
+      TS_ASSERT_EQUALS(received.load(), count);
+      TS_ASSERT_EQUALS(bus.dropped(), 0u);
+      TS_ASSERT(receiver != std::this_thread::get_id());
+
+      // Once stopped, the bus drops instead of delivering in the publisher.
+      producer.send(container);
+      TS_ASSERT_EQUALS(bus.dropped(), 1u);
+      TS_ASSERT_EQUALS(received.load(), count);
+    }
+
+    void testQueuedBusStagesThatFloodEachOtherLoseNothing()
+    {
+      // Both stages answer the start with more containers than a ring holds,
+      // each from its own draining thread, so that both are held back by a
+      // full ring towards the other.
+      using opendlv::logic::cfsd18::common::BusPort;
+      uint32_t const count =
+        4 * opendlv::logic::cfsd18::common::InProcessBus::RING_CAPACITY;
+      std::atomic<uint32_t> received[2];
+      received[0] = 0;
+      received[1] = 0;
+      std::unique_ptr<BusPort> stages[2];
+      for (uint32_t i = 0; i < 2; i++) {
+        stages[i].reset(new BusPort([&stages, &received, count, i](
+                odcore::data::Container &a_container) {
+              if (a_container.getDataType()
+                  == opendlv::proxy::GroundSpeedReading::ID()) {
+                received[i]++;
+                return;
+              }
+              opendlv::proxy::GroundSpeedReading groundSpeedReading(1.0f);
+              odcore::data::Container container(groundSpeedReading);
+              for (uint32_t j = 0; j < count; j++) {
+                stages[i]->send(container);
+              }
+            },
+            [](odcore::data::Container &) {}));
+      }
+      BusPort starter([](odcore::data::Container &) {},
+          [](odcore::data::Container &) {});
+
+      opendlv::logic::cfsd18::common::InProcessBus bus(
+          opendlv::logic::cfsd18::common::Delivery::Queued);
+      stages[0]->attach(bus);
+      stages[1]->attach(bus);
+      starter.attach(bus);
+      bus.start();
+      opendlv::system::SystemOperationState systemOperationState(4, "");
+      odcore::data::Container start(systemOperationState);
+      starter.send(start);
+      for (uint32_t i = 0; i < 2000
+          && (received[0] < count || received[1] < count); i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      bus.stop();
+      TS_ASSERT_EQUALS(received[0].load(), count);
+      TS_ASSERT_EQUALS(received[1].load(), count);
+      TS_ASSERT_EQUALS(bus.dropped(), 0u);
+    }
+
+    void testMissionSupervisorFollowsSystemOperationState()
+    {
+      using opendlv::logic::cfsd18::common::MissionId;
+      opendlv::logic::cfsd18::common::MissionSupervisor missionSupervisor;
+      TS_ASSERT(missionSupervisor.activeMission() == MissionId::None);
+
+      TS_ASSERT(missionSupervisor.update(
+            opendlv::system::SystemOperationState(2, "skidpad")));
+      TS_ASSERT(missionSupervisor.activeMission() == MissionId::Skidpad);
+      TS_ASSERT(!missionSupervisor.update(
+            opendlv::system::SystemOperationState(2, "skidpad")));
+
+      TS_ASSERT(missionSupervisor.update(
+            opendlv::system::SystemOperationState(-1, "emergency")));
+      TS_ASSERT(missionSupervisor.activeMission() == MissionId::None);
+    }
+
+    void testMailboxKeepsLatestValue()
+    {
+      opendlv::logic::cfsd18::common::Mailbox<int32_t> mailbox;
+      int32_t value = 0;
+      TS_ASSERT(!mailbox.peek(value));
+      TS_ASSERT(!mailbox.take(value));
+
+      mailbox.post(1);
+      mailbox.post(2);
+      TS_ASSERT(mailbox.take(value));
+      TS_ASSERT_EQUALS(value, 2);
+      TS_ASSERT(!mailbox.take(value));
+
+      value = 0;
+      TS_ASSERT(mailbox.peek(value));
+      TS_ASSERT_EQUALS(value, 2);
+    }
+
+    void testDispatcherCallsHandlerOfDataType()
+    {
+      struct Handlers {
+        Handlers() : groundSpeed(0.0f), geolocations(0) {}
+        void onGroundSpeedReading(
+            opendlv::proxy::GroundSpeedReading const &a_groundSpeedReading,
+            odcore::data::Container &)
+        {
+          groundSpeed = a_groundSpeedReading.getGroundSpeed();
+        }
+        void onGeolocation(odcore::data::Container &)
+        {
+          geolocations++;
+        }
+        float groundSpeed;
+        uint32_t geolocations;
+      };
+
+      opendlv::logic::cfsd18::common::Dispatcher<Handlers> dispatcher;
+      dispatcher
+        .add<opendlv::logic::sensation::Geolocation, &Handlers::onGeolocation>()
+        .add<opendlv::proxy::GroundSpeedReading, &Handlers::onGroundSpeedReading>();
+
+      Handlers handlers;
+      opendlv::proxy::GroundSpeedReading groundSpeedReading(7.0f);
+      odcore::data::Container speed(groundSpeedReading);
+      TS_ASSERT(dispatcher.dispatch(handlers, speed));
+      TS_ASSERT_DELTA(handlers.groundSpeed, 7.0f, 1e-6f);
+
+      opendlv::logic::sensation::Geolocation geolocation;
+      odcore::data::Container location(geolocation);
+      TS_ASSERT(dispatcher.dispatch(handlers, location));
+      TS_ASSERT_EQUALS(handlers.geolocations, 1u);
+
+      opendlv::logic::action::AimPoint aimPoint;
+      odcore::data::Container unhandled(aimPoint);
+      TS_ASSERT(!dispatcher.dispatch(handlers, unhandled));
+    }
+
+    void testFixedRateLoopCountsOverruns()
+    {
+      std::atomic<int32_t> calls(0);
+      opendlv::logic::cfsd18::common::FixedRateLoop loop;
+      loop.start(200.0f, [&calls]() {
+          if (calls++ == 2) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+          }
+        });
+      TS_ASSERT(loop.isRunning());
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      loop.stop();
+
+      TS_ASSERT(!loop.isRunning());
+      TS_ASSERT_EQUALS(loop.iterations(), static_cast<uint64_t>(calls));
+      TS_ASSERT(loop.iterations() > 5);
+      TS_ASSERT(loop.overruns() >= 1);
+      TS_ASSERT(loop.maxPeriod() > 0.015);
+      TS_ASSERT(loop.meanPeriod() > 0.0);
+    }
+
+    void testStageTraceFollowsOrigin()
+    {
+      using opendlv::logic::cfsd18::common::BusPort;
+      BusPort *port = nullptr;
+      BusPort stage([&port](odcore::data::Container &a_container) {
+          opendlv::logic::action::AimPoint aimPoint;
+          odcore::data::Container effect(aimPoint);
+          opendlv::logic::cfsd18::common::propagateOrigin(a_container, effect);
+          port->send(effect);
+          TS_ASSERT_EQUALS(effect.getSampleTimeStamp().toMicroseconds(),
+              a_container.getSampleTimeStamp().toMicroseconds());
+        }, [](odcore::data::Container &) {});
+      port = &stage;
+
+      opendlv::logic::perception::Surface surface;
+      odcore::data::Container cause(surface);
+      cause.setSampleTimeStamp(
+          odcore::data::TimeStamp() - odcore::data::TimeStamp(0, 200000));
+      stage.receive(cause);
+      // Only what is sent while handling a container ends a stage.
+      stage.send(cause);
+
+      std::string const report = stage.traceReport();
+      TS_ASSERT(report.find("over 1 samples") != std::string::npos);
+
+      opendlv::logic::cfsd18::common::StageTrace trace;
+      trace.enter();
+      trace.exit(cause, odcore::data::TimeStamp());
+      TS_ASSERT_EQUALS(trace.size(), 1u);
+      TS_ASSERT(trace.totalPercentile(50.0f) >= 0.2);
+      TS_ASSERT(trace.stagePercentile(50.0f) < 0.2);
+
+      std::vector<double> const samples = {3.0, 1.0, 2.0, 4.0};
+      TS_ASSERT_DELTA(opendlv::logic::cfsd18::common::percentile(samples, 50.0f),
+          2.0, 1e-9);
+      TS_ASSERT_DELTA(opendlv::logic::cfsd18::common::percentile(samples, 99.0f),
+          4.0, 1e-9);
+      TS_ASSERT_DELTA(opendlv::logic::cfsd18::common::percentile({}, 50.0f),
+          0.0, 1e-9);
+    }
+
+    void testHistogramPercentiles()
+    {
+      using opendlv::logic::cfsd18::common::Histogram;
+      TS_ASSERT_EQUALS(Histogram::bucketOf(15), 15u);
+      TS_ASSERT_EQUALS(Histogram::bucketOf(16), 16u);
+      TS_ASSERT_EQUALS(Histogram::bucketOf(33), 32u);
+      TS_ASSERT_EQUALS(Histogram::valueOf(32), 33u);
+      TS_ASSERT_EQUALS(Histogram::bucketOf(UINT64_MAX), Histogram::BUCKETS - 1);
+      TS_ASSERT_EQUALS(Histogram::valueOf(Histogram::BUCKETS - 1), UINT64_MAX);
+
+      Histogram histogram;
+      TS_ASSERT_EQUALS(histogram.percentile(50.0f), 0u);
+      for (uint64_t i = 1; i <= 1000; i++) {
+        histogram.record(i * 1000);
+      }
+      TS_ASSERT_EQUALS(histogram.count(), 1000u);
+      TS_ASSERT_EQUALS(histogram.max(), 1000000u);
+      TS_ASSERT_EQUALS(histogram.percentile(100.0f), 1000000u);
+      uint64_t const median = histogram.percentile(50.0f);
+      TS_ASSERT(median >= 500000 && median < 500000 + 500000 / 16);
+      uint64_t const tail = histogram.percentile(99.0f);
+      TS_ASSERT(tail >= 990000 && tail <= 1000000);
+
+      histogram.reset();
+      TS_ASSERT_EQUALS(histogram.count(), 0u);
+      {
+        opendlv::logic::cfsd18::common::ScopedTimer timer(histogram);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      }
+      TS_ASSERT_EQUALS(histogram.count(), 1u);
+      TS_ASSERT(histogram.max() >= 2000000u);
+
+      opendlv::logic::cfsd18::common::HandlerStatistics statistics;
+      statistics.handlerTimes().record(4000);
+      statistics.update(3);
+      statistics.update(1);
+      std::string const summary = statistics.summary();
+      TS_ASSERT(summary.find("max 4 us") != std::string::npos);
+      TS_ASSERT(summary.find("queue depth 3") != std::string::npos);
+    }
+
+    void testBenchmarksWriteJson()
+    {
+      using opendlv::logic::cfsd18::common::BenchmarkState;
+      using opendlv::logic::cfsd18::common::Benchmarks;
+
+      Benchmarks &benchmarks = Benchmarks::instance();
+      benchmarks.add("countUp", [](BenchmarkState &a_state) {
+          uint64_t count = 0;
+          while (a_state.keepRunning()) {
+            opendlv::logic::cfsd18::common::doNotOptimize(++count);
+          }
+          a_state.setItemsProcessed(count);
+        });
+      benchmarks.add("skipAlways", [](BenchmarkState &a_state) {
+          a_state.skip("Nothing to do.");
+        });
+
+      std::ostringstream out;
+      benchmarks.write(out, "count.*", 0.001);
+      std::string const json = out.str();
+      TS_ASSERT(json.find("\"benchmarks\"") != std::string::npos);
+      TS_ASSERT(json.find("\"name\": \"countUp\"") != std::string::npos);
+      TS_ASSERT(json.find("\"items_per_second\"") != std::string::npos);
+      TS_ASSERT(json.find("skipAlways") == std::string::npos);
+
+      out.str("");
+      benchmarks.write(out, "skip.*", 0.001);
+      TS_ASSERT(out.str().find("\"error_occurred\": true")
+          != std::string::npos);
+      TS_ASSERT(out.str().find("Nothing to do.") != std::string::npos);
+    }
+
+    void testBenchmarksCompareWithBaseline()
+    {
+      using opendlv::logic::cfsd18::common::Benchmarks;
+
+      std::istringstream baselineJson("{\"benchmarks\": ["
+          "{\"name\": \"fast\", \"real_time\": 100, "
+          "\"time_unit\": \"ns\"}, "
+          "{\"name\": \"slow\", \"real_time\": 2, "
+          "\"time_unit\": \"us\"}, "
+          "{\"name\": \"skipped\", \"error_occurred\": true}]}");
+      std::map<std::string, double> const baseline =
+        Benchmarks::readTimes(baselineJson);
+      TS_ASSERT_EQUALS(baseline.size(), 2u);
+      TS_ASSERT_DELTA(baseline.at("slow"), 2000.0, 1e-9);
+
+      std::map<std::string, double> times;
+      times["fast"] = 120.0;
+      times["slow"] = 3000.0;
+      times["new"] = 1e6;
+      std::vector<std::string> const regressed =
+        Benchmarks::regressions(times, baseline, 0.25);
+      TS_ASSERT_EQUALS(regressed.size(), 1u);
+      TS_ASSERT_EQUALS(regressed.at(0), "slow");
+      TS_ASSERT(Benchmarks::regressions(times, baseline, 0.6).empty());
+    }
+
+    void testSyntheticTrackLayouts()
+    {
+      using opendlv::logic::cfsd18::common::ConeType;
+      using opendlv::logic::cfsd18::common::SyntheticTrack;
+
+      SyntheticTrack const acceleration = SyntheticTrack::acceleration();
+      TS_ASSERT_DELTA(acceleration.centreline().length(), 175.0f, 1e-3f);
+      TS_ASSERT(!acceleration.isClosed());
+      TS_ASSERT(acceleration.coneType(0) == ConeType::BigOrange);
+      TS_ASSERT(acceleration.coneType(2) == ConeType::Blue);
+      TS_ASSERT(acceleration.coneType(3) == ConeType::Yellow);
+      Eigen::Vector3f const start = acceleration.poseAt(10.0f);
+      TS_ASSERT_DELTA(start(0), 10.0f, 1e-3f);
+      TS_ASSERT_DELTA(start(2), 0.0f, 1e-3f);
+      TS_ASSERT_EQUALS(acceleration.drive(10.0f, 10.0f, 1000.0f).size(), 176u);
+
+      SyntheticTrack const skidpad = SyntheticTrack::skidpad();
+      float const pi = static_cast<float>(M_PI);
+      TS_ASSERT_DELTA(skidpad.centreline().length(),
+          40.0f + 8.0f * pi * 9.125f, 1.0f);
+      uint32_t const onCircle = skidpad.centreline().size() / 4;
+      TS_ASSERT_DELTA(skidpad.centreline().curvatureAt(onCircle),
+          1.0f / 9.125f, 1e-2f);
+
+      SyntheticTrack const trackdrive = SyntheticTrack::trackdrive(2000.0f, 7);
+      TS_ASSERT(trackdrive.isClosed());
+      TS_ASSERT_DELTA(trackdrive.centreline().length(), 2000.0f, 20.0f);
+      TS_ASSERT(trackdrive.coneCount() >= 990u && trackdrive.coneCount() <= 1010u);
+      for (uint32_t i = 1; i + 1 < trackdrive.centreline().size(); i++) {
+        TS_ASSERT(trackdrive.centreline().curvatureAt(i)
+            <= 1.0f / SyntheticTrack::MIN_RADIUS + 1e-3f);
+      }
+      SyntheticTrack const again = SyntheticTrack::trackdrive(2000.0f, 7);
+      TS_ASSERT_EQUALS(again.cone(101), trackdrive.cone(101));
+      Eigen::Vector3f const lapped = trackdrive.poseAt(2000.0f
+          + trackdrive.centreline().length());
+      TS_ASSERT_DELTA(lapped(0), trackdrive.poseAt(2000.0f)(0), 1e-1f);
+    }
+
+    void testSyntheticSensorSeesCones()
+    {
+      using opendlv::logic::cfsd18::common::SyntheticSensor;
+      using opendlv::logic::cfsd18::common::SyntheticTrack;
+
+      SyntheticTrack const track = SyntheticTrack::acceleration();
+      SyntheticSensor sensor(1, 30.0f, 0.0f, 0.0f, 0.0f);
+      Eigen::Vector3f const pose(0.0f, 0.0f, 0.0f);
+
+      std::vector<odcore::data::Container> objects =
+        sensor.objects(track, pose);
+      TS_ASSERT(!objects.empty());
+      TS_ASSERT_EQUALS(objects.size() % 4, 0u);
+      bool isFound = false;
+      for (uint32_t i = 0; i < objects.size(); i += 4) {
+        auto distance =
+          objects[i + 2].getData<opendlv::logic::perception::ObjectDistance>();
+        auto type =
+          objects[i + 3].getData<opendlv::logic::perception::ObjectType>();
+        TS_ASSERT(distance.getDistance() <= 30.0f);
+        if (distance.getObjectId() == 2) {
+          TS_ASSERT_DELTA(distance.getDistance(), std::hypot(5.0f, 1.5f), 1e-3f);
+          TS_ASSERT_EQUALS(type.getType(), 1u);
+          isFound = true;
+        }
+      }
+      TS_ASSERT(isFound);
+
+      odcore::data::CompactPointCloud const scan = sensor.scan(track, pose);
+      TS_ASSERT_EQUALS(scan.getEntriesPerAzimuth(), SyntheticSensor::LAYERS);
+      std::string const distances = scan.getDistances();
+      TS_ASSERT_EQUALS(distances.size(),
+          2 * SyntheticSensor::COLUMNS * SyntheticSensor::LAYERS);
+      auto centimetres = [&distances](uint32_t a_column, uint32_t a_layer) {
+          uint32_t const i = 2 * (a_column * SyntheticSensor::LAYERS + a_layer);
+          return static_cast<uint32_t>(static_cast<uint8_t>(distances[i])) << 8
+            | static_cast<uint8_t>(distances[i + 1]);
+        };
+      float const azimuth = 360.0f - std::atan2(1.5f, 5.0f) * 180.0f
+        / static_cast<float>(M_PI);
+      uint32_t const column = static_cast<uint32_t>(std::round(azimuth / 0.2f));
+      float const cone = static_cast<float>(centimetres(column, 7)) / 100.0f;
+      TS_ASSERT(cone > std::hypot(5.0f, 1.5f) - 0.2f);
+      TS_ASSERT(cone < std::hypot(5.0f, 1.5f));
+      TS_ASSERT_EQUALS(centimetres(column, SyntheticSensor::LAYERS - 1), 0u);
+      uint32_t const ground = centimetres(SyntheticSensor::COLUMNS / 2, 0);
+      TS_ASSERT_DELTA(static_cast<float>(ground) / 100.0f,
+          0.4f / std::sin(15.0f * static_cast<float>(M_PI) / 180.0f), 0.01f);
+
+      std::vector<odcore::data::Container> surfaces =
+        sensor.surfaces(track, pose, 0.0f, 20);
+      TS_ASSERT_EQUALS(surfaces.size(), 20u);
+      auto surface =
+        surfaces[1].getData<opendlv::logic::perception::Surface>();
+      TS_ASSERT_DELTA(surface.getX1(), SyntheticTrack::CONE_SPACING, 1e-3f);
+      TS_ASSERT_DELTA(surface.getY1(), 0.5f * SyntheticTrack::WIDTH, 1e-3f);
+      TS_ASSERT_DELTA(surface.getY2(), -0.5f * SyntheticTrack::WIDTH, 1e-3f);
+    }
+};
+
+#endif
@@ -0,0 +1,240 @@
+/**
+* Copyright (C) 2017 Chalmers Revere
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+* USA.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include <opendavinci/odcore/data/TimeStamp.h>
+
+#include <odvdcfsd18/GeneratedHeaders_ODVDcfsd18.h>
+
+#include "conedetector.hpp"
+#include "detectcone.hpp"
+#include "arena.hpp"
+#include "benchmark.hpp"
+#include "endofscan.hpp"
+#include "inprocessbus.hpp"
+#include "workstealingpool.hpp"
+
+namespace {
+
+using opendlv::logic::cfsd18::common::BenchmarkState;
+using opendlv::logic::cfsd18::common::InProcessBus;
+
+void nextContainerRecordedAttention(BenchmarkState &a_state)
+{
+  std::vector<odcore::data::Container> containers =
+    opendlv::logic::cfsd18::common::Benchmarks::instance().recorded(
+        opendlv::logic::sensation::Attention::ID());
+  if (containers.empty()) {
+    a_state.skip("No recorded attentions.");
+    return;
+  }
+  InProcessBus bus(opendlv::logic::cfsd18::common::Delivery::Direct,
+      opendlv::logic::cfsd18::common::Mirroring::None);
+  auto detectCone = opendlv::logic::cfsd18::common::createMicroservice<
+    opendlv::logic::cfsd18::perception::DetectCone>(bus);
+  uint64_t i = 0;
+  while (a_state.keepRunning()) {
+    detectCone->nextContainer(containers[i++ % containers.size()]);
+  }
+  a_state.setItemsProcessed(a_state.iterations());
+}
+
+/**
+ * Points of the given number of cones on a grid ahead of the sensor, eight
+ * on the side of every cone that faces it.
+ */
+Eigen::Matrix3Xf conePoints(uint32_t a_cones)
+{
+  uint32_t const pointsPerCone = 8;
+  Eigen::Matrix3Xf points(3, a_cones * pointsPerCone);
+  for (uint32_t i = 0; i < a_cones; i++) {
+    float const x = 3.0f + 1.5f * static_cast<float>(i / 16);
+    float const y = -12.0f + 1.5f * static_cast<float>(i % 16);
+    for (uint32_t j = 0; j < pointsPerCone; j++) {
+      float const angle = 0.4f * (static_cast<float>(j % 4) - 1.5f);
+      float const radius = (j < 4) ? 0.1f : 0.06f;
+      points.col(i * pointsPerCone + j) << x - radius * std::cos(angle),
+        y + radius * std::sin(angle), (j < 4) ? -0.3f : -0.15f;
+    }
+  }
+  return points;
+}
+
+opendlv::logic::cfsd18::perception::ConeDetector coneDetector()
+{
+  return opendlv::logic::cfsd18::perception::ConeDetector(0.3f, 2, 0.4f,
+      0.5f, 0.4f);
+}
+
+template<uint32_t Cones>
+void extractClusterFeatures(BenchmarkState &a_state)
+{
+  auto const detector = coneDetector();
+  Eigen::Matrix3Xf const points = conePoints(Cones);
+  opendlv::logic::cfsd18::common::Arena arena;
+  opendlv::logic::cfsd18::common::ArenaVector<uint32_t> indices{
+    opendlv::logic::cfsd18::common::ArenaAllocator<uint32_t>(arena)};
+  opendlv::logic::cfsd18::common::ArenaVector<uint32_t> offsets{
+    opendlv::logic::cfsd18::common::ArenaAllocator<uint32_t>(arena)};
+  detector.cluster(points, indices, offsets);
+  uint32_t const count = static_cast<uint32_t>(offsets.size() - 1);
+  Eigen::Matrix3Xf scratch;
+  while (a_state.keepRunning()) {
+    for (uint32_t i = 0; i < count; i++) {
+      opendlv::logic::cfsd18::common::doNotOptimize(
+          detector.extract(points, indices.data() + offsets[i],
+            offsets[i + 1] - offsets[i], scratch));
+    }
+  }
+  a_state.setItemsProcessed(a_state.iterations() * count);
+}
+
+/**
+ * The same on a pool with a worker per core, and at least two.
+ */
+template<uint32_t Cones>
+void extractClusterFeaturesInParallel(BenchmarkState &a_state)
+{
+  auto const detector = coneDetector();
+  Eigen::Matrix3Xf const points = conePoints(Cones);
+  opendlv::logic::cfsd18::common::Arena arena;
+  opendlv::logic::cfsd18::common::ArenaVector<uint32_t> indices{
+    opendlv::logic::cfsd18::common::ArenaAllocator<uint32_t>(arena)};
+  opendlv::logic::cfsd18::common::ArenaVector<uint32_t> offsets{
+    opendlv::logic::cfsd18::common::ArenaAllocator<uint32_t>(arena)};
+  detector.cluster(points, indices, offsets);
+  uint32_t const count = static_cast<uint32_t>(offsets.size() - 1);
+  opendlv::logic::cfsd18::common::WorkStealingPool pool(
+      std::max(std::thread::hardware_concurrency(), 2u));
+  std::vector<Eigen::Matrix3Xf> scratch(pool.size());
+  std::vector<opendlv::logic::cfsd18::perception::ClusterFeatures> features(
+      count);
+  while (a_state.keepRunning()) {
+    pool.parallelFor(count,
+        [&](uint32_t a_i, uint32_t a_worker) {
+          features[a_i] = detector.extract(points,
+              indices.data() + offsets[a_i], offsets[a_i + 1] - offsets[a_i],
+              scratch[a_worker]);
+        });
+    opendlv::logic::cfsd18::common::doNotOptimize(features);
+  }
+  a_state.setItemsProcessed(a_state.iterations() * count);
+}
+
+/**
+ * The attentions of a scan of the given points, and its end.
+ */
+std::vector<odcore::data::Container> scan(Eigen::Matrix3Xf const &a_points)
+{
+  std::vector<odcore::data::Container> containers;
+  for (uint32_t i = 0; i < a_points.cols(); i++) {
+    float const horizontal = std::hypot(a_points(0, i), a_points(1, i));
+    opendlv::logic::sensation::Attention attention(
+        std::atan2(a_points(1, i), a_points(0, i)),
+        std::atan2(a_points(2, i), horizontal), a_points.col(i).norm());
+    odcore::data::Container container(attention);
+    container.setSampleTimeStamp(odcore::data::TimeStamp(1, 0));
+    containers.push_back(container);
+  }
+  containers.push_back(
+      opendlv::logic::cfsd18::common::endOfScan(containers.back()));
+  return containers;
+}
+
+/**
+ * One attention of a scan of 64 cones at a time, so that the detection at
+ * the end of each scan is spread over its attentions.
+ */
+void nextContainerAttention(BenchmarkState &a_state)
+{
+  std::vector<odcore::data::Container> containers = scan(conePoints(64));
+  InProcessBus bus(opendlv::logic::cfsd18::common::Delivery::Direct,
+      opendlv::logic::cfsd18::common::Mirroring::None);
+  auto detectCone = opendlv::logic::cfsd18::common::createMicroservice<
+    opendlv::logic::cfsd18::perception::DetectCone>(bus);
+  uint64_t i = 0;
+  while (a_state.keepRunning()) {
+    detectCone->nextContainer(containers[i++ % containers.size()]);
+  }
+  a_state.setItemsProcessed(a_state.iterations());
+}
+
+/**
+ * Whole scans of the given number of cones.
+ */
+template<uint32_t Cones>
+void detectSyntheticCones(BenchmarkState &a_state)
+{
+  std::vector<odcore::data::Container> containers = scan(conePoints(Cones));
+  InProcessBus bus(opendlv::logic::cfsd18::common::Delivery::Direct,
+      opendlv::logic::cfsd18::common::Mirroring::None);
+  auto detectCone = opendlv::logic::cfsd18::common::createMicroservice<
+    opendlv::logic::cfsd18::perception::DetectCone>(bus);
+  while (a_state.keepRunning()) {
+    for (auto &container : containers) {
+      detectCone->nextContainer(container);
+    }
+  }
+  a_state.setItemsProcessed(a_state.iterations());
+}
+
+CFSD18_BENCHMARK(nextContainerAttention);
+CFSD18_BENCHMARK(nextContainerRecordedAttention);
+CFSD18_BENCHMARK_TEMPLATE(extractClusterFeatures, 8);
+CFSD18_BENCHMARK_TEMPLATE(extractClusterFeatures, 64);
+CFSD18_BENCHMARK_TEMPLATE(extractClusterFeatures, 256);
+CFSD18_BENCHMARK_TEMPLATE(extractClusterFeaturesInParallel, 8);
+CFSD18_BENCHMARK_TEMPLATE(extractClusterFeaturesInParallel, 64);
+CFSD18_BENCHMARK_TEMPLATE(extractClusterFeaturesInParallel, 256);
+/**
+ * The same with the features of every scan extracted on a pool with a worker
+ * per core, and at least two, however few clusters it has. Comparing these
+ * with the serial scans shows from how many clusters the pool pays off.
+ */
+template<uint32_t Cones>
+void detectSyntheticConesOnPool(BenchmarkState &a_state)
+{
+  std::vector<odcore::data::Container> containers = scan(conePoints(Cones));
+  InProcessBus bus(opendlv::logic::cfsd18::common::Delivery::Direct,
+      opendlv::logic::cfsd18::common::Mirroring::None);
+  auto detectCone = opendlv::logic::cfsd18::common::createMicroservice<
+    opendlv::logic::cfsd18::perception::DetectCone>(bus);
+  detectCone->startPool(std::max(std::thread::hardware_concurrency(), 2u), 1);
+  while (a_state.keepRunning()) {
+    for (auto &container : containers) {
+      detectCone->nextContainer(container);
+    }
+  }
+  a_state.setItemsProcessed(a_state.iterations());
+}
+
+CFSD18_BENCHMARK_TEMPLATE(detectSyntheticCones, 8);
+CFSD18_BENCHMARK_TEMPLATE(detectSyntheticCones, 64);
+CFSD18_BENCHMARK_TEMPLATE(detectSyntheticCones, 256);
+CFSD18_BENCHMARK_TEMPLATE(detectSyntheticConesOnPool, 8);
+CFSD18_BENCHMARK_TEMPLATE(detectSyntheticConesOnPool, 64);
+CFSD18_BENCHMARK_TEMPLATE(detectSyntheticConesOnPool, 256);
+
+}
+
+CFSD18_BENCHMARK_MAIN()
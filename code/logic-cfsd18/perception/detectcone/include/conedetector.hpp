@@ -0,0 +1,92 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_PERCEPTION_CONEDETECTOR_HPP
+#define OPENDLV_LOGIC_CFSD18_PERCEPTION_CONEDETECTOR_HPP
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <opendavinci/odcore/wrapper/Eigen.h>
+
+#include "arena.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace perception {
+
+/**
+ * What is known about a cluster of points: their number, centroid and
+ * bounding box, and the height profile, which is the widest horizontal
+ * distance from the centroid in each of a number of slices from the ground
+ * up to the highest cone.
+ */
+struct ClusterFeatures {
+  static uint32_t const PROFILE_SLICES = 4;
+
+  ClusterFeatures();
+
+  uint32_t count;
+  Eigen::Vector3f centroid;
+  Eigen::Vector3f min;
+  Eigen::Vector3f max;
+  std::array<float, PROFILE_SLICES> heightProfile;
+};
+
+/**
+ * Finds cones among the points that the attention sends, in the frame of
+ * the sensor. The points are clustered by their horizontal distance, the
+ * features of every cluster are extracted, and the clusters that are about
+ * as small as a cone and no wider at the top than at the bottom are taken
+ * as cones. Extracting the features of one cluster does not depend on the
+ * others, so they can be extracted in parallel. A clustering is given as
+ * the indices of the points, cluster by cluster, and the offset of the first
+ * index of every cluster, followed by the number of indices.
+ */
+class ConeDetector {
+ public:
+  ConeDetector(float, uint32_t, float, float, float);
+  ConeDetector(ConeDetector const &) = default;
+  ConeDetector &operator=(ConeDetector const &) = default;
+  virtual ~ConeDetector();
+
+  void cluster(Eigen::Ref<Eigen::Matrix3Xf const> const &,
+      common::ArenaVector<uint32_t> &, common::ArenaVector<uint32_t> &) const;
+  ClusterFeatures extract(Eigen::Ref<Eigen::Matrix3Xf const> const &,
+      uint32_t const *, uint32_t, Eigen::Matrix3Xf &) const;
+  bool isCone(ClusterFeatures const &) const;
+
+ private:
+  uint32_t sliceOf(float) const;
+
+  float m_clusterDistance;
+  uint32_t m_minPoints;
+  float m_maxWidth;
+  float m_maxHeight;
+  float m_sensorHeight;
+};
+
+}
+}
+}
+}
+
+#endif
@@ -20,12 +20,23 @@
 #ifndef OPENDLV_LOGIC_CFSD18_PERCEPTION_DETECTCONE_HPP
 #define OPENDLV_LOGIC_CFSD18_PERCEPTION_DETECTCONE_HPP
 
+#include <memory>
+#include <vector>
+
+#include <opendavinci/odcore/base/KeyValueConfiguration.h>
 #include <opendavinci/odcore/base/module/DataTriggeredConferenceClientModule.h>
 #include <opendavinci/odcore/data/Container.h>
 
 //#include <odvdopendlvstandardmessageset/GeneratedHeaders_ODVDOpenDLVStandardMessageSet.h>
 #include <odvdcfsd18/GeneratedHeaders_ODVDcfsd18.h>
 
+#include "arena.hpp"
+#include "busport.hpp"
+#include "dispatcher.hpp"
+#include "workstealingpool.hpp"
+
+#include "conedetector.hpp"
+
 namespace opendlv {
 namespace logic {
 namespace cfsd18 {
@@ -38,10 +49,27 @@ class DetectCone : public odcore::base::module::DataTriggeredConferenceClientMod
   DetectCone &operator=(DetectCone const &) = delete;
   virtual ~DetectCone();
   virtual void nextContainer(odcore::data::Container &);
+  void attachBus(common::InProcessBus &);
+  void setUp(odcore::base::KeyValueConfiguration const &);
+  void startPool(uint32_t, uint32_t);
 
  private:
   void setUp();
   void tearDown();
+  void receive(odcore::data::Container &);
+  void onAttention(opendlv::logic::sensation::Attention const &,
+      odcore::data::Container &);
+  void detect();
+
+  common::BusPort m_busPort;
+  common::Dispatcher<DetectCone> m_dispatcher;
+  ConeDetector m_coneDetector;
+  std::unique_ptr<common::WorkStealingPool> m_pool;
+  uint32_t m_minParallelClusters;
+  common::Arena m_arena;
+  std::vector<Eigen::Matrix3Xf> m_scratch;
+  std::vector<float> m_scan;
+  odcore::data::Container m_scanOrigin;
 };
 
 }
@@ -0,0 +1,202 @@
+/**
+* Copyright (C) 2017 Chalmers Revere
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+* USA.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "conedetector.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace perception {
+
+namespace {
+
+uint32_t rootOf(common::ArenaVector<uint32_t> &a_parents, uint32_t a_index)
+{
+  while (a_parents[a_index] != a_index) {
+    a_parents[a_index] = a_parents[a_parents[a_index]];
+    a_index = a_parents[a_index];
+  }
+  return a_index;
+}
+
+}
+
+ClusterFeatures::ClusterFeatures() :
+  count(0),
+  centroid(Eigen::Vector3f::Zero()),
+  min(Eigen::Vector3f::Zero()),
+  max(Eigen::Vector3f::Zero()),
+  heightProfile()
+{
+}
+
+/**
+ * Takes the largest horizontal distance [m] between neighbouring points of
+ * a cluster, the fewest points of a cone, the widest [m] and highest [m]
+ * cone, and the height [m] of the sensor above the ground.
+ */
+ConeDetector::ConeDetector(float a_clusterDistance, uint32_t a_minPoints,
+    float a_maxWidth, float a_maxHeight, float a_sensorHeight) :
+  m_clusterDistance(a_clusterDistance),
+  m_minPoints(a_minPoints),
+  m_maxWidth(a_maxWidth),
+  m_maxHeight(a_maxHeight),
+  m_sensorHeight(a_sensorHeight)
+{
+}
+
+ConeDetector::~ConeDetector()
+{
+}
+
+/**
+ * Groups the points into clusters of points that are connected through
+ * neighbours within the cluster distance of each other. The points are
+ * sorted along x, so that only the neighbours within the cluster distance
+ * along x are compared. The clusters are ordered by their first point, and
+ * the temporaries are taken from the arena of the indices.
+ */
+void ConeDetector::cluster(Eigen::Ref<Eigen::Matrix3Xf const> const &a_points,
+    common::ArenaVector<uint32_t> &a_indices,
+    common::ArenaVector<uint32_t> &a_offsets) const
+{
+  common::ArenaAllocator<uint32_t> const allocator = a_indices.get_allocator();
+  uint32_t const count = static_cast<uint32_t>(a_points.cols());
+  common::ArenaVector<uint32_t> order(count, 0, allocator);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&a_points](uint32_t a, uint32_t b) {
+      return a_points(0, a) < a_points(0, b);
+    });
+
+  float const maxDistanceSquared = m_clusterDistance * m_clusterDistance;
+  common::ArenaVector<uint32_t> parents(count, 0, allocator);
+  std::iota(parents.begin(), parents.end(), 0);
+  for (uint32_t i = 0; i < count; i++) {
+    for (uint32_t j = i + 1; j < count
+        && a_points(0, order[j]) - a_points(0, order[i]) <= m_clusterDistance;
+        j++) {
+      float const dy = a_points(1, order[j]) - a_points(1, order[i]);
+      float const dx = a_points(0, order[j]) - a_points(0, order[i]);
+      if (dx * dx + dy * dy <= maxDistanceSquared) {
+        parents[rootOf(parents, order[j])] = rootOf(parents, order[i]);
+      }
+    }
+  }
+
+  common::ArenaVector<uint32_t> clusterOfRoot(count, count, allocator);
+  common::ArenaVector<uint32_t> clusterOfPoint(count, 0, allocator);
+  a_offsets.assign(1, 0);
+  for (uint32_t i = 0; i < count; i++) {
+    uint32_t const root = rootOf(parents, i);
+    if (clusterOfRoot[root] == count) {
+      clusterOfRoot[root] = static_cast<uint32_t>(a_offsets.size() - 1);
+      a_offsets.push_back(0);
+    }
+    clusterOfPoint[i] = clusterOfRoot[root];
+    a_offsets[clusterOfPoint[i] + 1]++;
+  }
+  for (uint32_t i = 1; i < a_offsets.size(); i++) {
+    a_offsets[i] += a_offsets[i - 1];
+  }
+  common::ArenaVector<uint32_t> next(a_offsets.begin(), a_offsets.end(),
+      allocator);
+  a_indices.assign(count, 0);
+  for (uint32_t i = 0; i < count; i++) {
+    a_indices[next[clusterOfPoint[i]]++] = i;
+  }
+}
+
+/**
+ * Features of the cluster of the given number of points, with the given
+ * indices. The points are gathered into the scratch matrix first, which only
+ * grows, so that a caller that keeps it between clusters does not allocate
+ * once it is large enough.
+ */
+ClusterFeatures ConeDetector::extract(
+    Eigen::Ref<Eigen::Matrix3Xf const> const &a_points,
+    uint32_t const *a_indices, uint32_t a_count,
+    Eigen::Matrix3Xf &a_scratch) const
+{
+  uint32_t const count = a_count;
+  ClusterFeatures features;
+  features.count = count;
+  if (count == 0) {
+    return features;
+  }
+  if (a_scratch.cols() < count) {
+    a_scratch.resize(3, count);
+  }
+  for (uint32_t i = 0; i < count; i++) {
+    a_scratch.col(i) = a_points.col(a_indices[i]);
+  }
+  auto const points = a_scratch.leftCols(count);
+  features.centroid = points.rowwise().mean();
+  features.min = points.rowwise().minCoeff();
+  features.max = points.rowwise().maxCoeff();
+
+  features.heightProfile.fill(0.0f);
+  for (uint32_t i = 0; i < count; i++) {
+    uint32_t const slice = sliceOf(points(2, i));
+    float const radius = std::hypot(points(0, i) - features.centroid(0),
+        points(1, i) - features.centroid(1));
+    features.heightProfile[slice] =
+      std::max(features.heightProfile[slice], radius);
+  }
+  return features;
+}
+
+/**
+ * Whether the cluster has enough points, fits in a cone, and is no wider at
+ * its highest slice than at its lowest, with a margin of a quarter of the
+ * widest cone for the noise.
+ */
+bool ConeDetector::isCone(ClusterFeatures const &a_features) const
+{
+  if (a_features.count < m_minPoints) {
+    return false;
+  }
+  Eigen::Vector3f const size = a_features.max - a_features.min;
+  if (size(0) > m_maxWidth || size(1) > m_maxWidth
+      || a_features.max(2) + m_sensorHeight > m_maxHeight) {
+    return false;
+  }
+  return a_features.heightProfile[sliceOf(a_features.max(2))]
+    <= a_features.heightProfile[sliceOf(a_features.min(2))]
+    + 0.25f * m_maxWidth;
+}
+
+/**
+ * The slice of the height profile of a point at the given height [m] in the
+ * frame of the sensor.
+ */
+uint32_t ConeDetector::sliceOf(float a_z) const
+{
+  float const slices = static_cast<float>(ClusterFeatures::PROFILE_SLICES);
+  float const slice = (a_z + m_sensorHeight) / m_maxHeight * slices;
+  return static_cast<uint32_t>(std::min(std::max(slice, 0.0f), slices - 1.0f));
+}
+
+}
+}
+}
+}
@@ -17,13 +17,17 @@
 * USA.
 */
 
+#include <cmath>
 #include <iostream>
+#include <limits>
 
 #include <opendavinci/odcore/data/TimeStamp.h>
 #include <opendavinci/odcore/strings/StringToolbox.h>
 #include <opendavinci/odcore/wrapper/Eigen.h>
 
 #include "detectcone.hpp"
+#include "endofscan.hpp"
+#include "trace.hpp"
 
 namespace opendlv {
 namespace logic {
@@ -31,40 +35,205 @@ namespace cfsd18 {
 namespace perception {
 
 DetectCone::DetectCone(int32_t const &a_argc, char **a_argv) :
-  DataTriggeredConferenceClientModule(a_argc, a_argv, "logic-cfsd18-perception-detectcone")
+  DataTriggeredConferenceClientModule(a_argc, a_argv, "logic-cfsd18-perception-detectcone"),
+  m_busPort([this](odcore::data::Container &a_container) { receive(a_container); },
+      [this](odcore::data::Container &a_container) { getConference().send(a_container); }),
+  m_dispatcher(),
+  m_coneDetector(0.3f, 2, 0.4f, 0.5f, 0.4f),
+  m_pool(),
+  m_minParallelClusters(std::numeric_limits<uint32_t>::max()),
+  m_arena(),
+  m_scratch(1),
+  m_scan(),
+  m_scanOrigin()
 {
+  m_dispatcher
+    .add<opendlv::logic::sensation::Attention, &DetectCone::onAttention>();
 }
 
 DetectCone::~DetectCone()
 {
 }
 
+void DetectCone::attachBus(common::InProcessBus &a_bus)
+{
+  m_busPort.attach(a_bus);
+}
 
+/**
+ * Extracts the features of the clusters of a scan on a pool of the given
+ * number of workers, including the thread that receives the scan, when the
+ * scan has at least the given number of clusters. Fewer clusters are not
+ * worth waking the pool for, and are extracted in the receiving thread.
+ * Where that pays off depends on the cores, so it is measured on the car by
+ * comparing the detectSyntheticConesOnPool benchmarks with
+ * detectSyntheticCones. Without a pool, every scan is extracted serially.
+ */
+void DetectCone::startPool(uint32_t a_workers, uint32_t a_minParallelClusters)
+{
+  m_pool.reset(new common::WorkStealingPool(a_workers));
+  m_minParallelClusters = a_minParallelClusters;
+  m_scratch.resize(m_pool->size());
+}
 
 void DetectCone::nextContainer(odcore::data::Container &a_container)
 {
-  if (a_container.getDataType() == opendlv::logic::sensation::Attention::ID()) {
-    // auto kinematicState = a_container.getData<opendlv::coord::KinematicState>();
+  m_busPort.receive(a_container);
+}
 
-    opendlv::logic::perception::Object o1;
-    odcore::data::Container c1(o1);
-    getConference().send(c1);
+/**
+ * Containers from the conference and from the bus both end up here, so the
+ * frame of the arena is the handling of one container. A container that is
+ * delivered back while one is handled gets a frame inside that one.
+ */
+void DetectCone::receive(odcore::data::Container &a_container)
+{
+  common::ArenaFrame const frame(m_arena);
+  m_dispatcher.dispatch(*this, a_container);
+}
+
+/**
+ * Collects the points of a scan until it ends. A scan whose end was lost is
+ * detected when the next one starts.
+ */
+void DetectCone::onAttention(
+    opendlv::logic::sensation::Attention const &a_attention,
+    odcore::data::Container &a_container)
+{
+  if (common::isEndOfScan(a_attention)) {
+    detect();
+    return;
+  }
+  if (!m_scan.empty() && common::originOf(a_container).toMicroseconds()
+      != common::originOf(m_scanOrigin).toMicroseconds()) {
+    detect();
+  }
+  float const distance = a_attention.getDistance();
+  float const horizontal = distance * std::cos(a_attention.getZenithAngle());
+  m_scan.push_back(horizontal * std::cos(a_attention.getAzimuthAngle()));
+  m_scan.push_back(horizontal * std::sin(a_attention.getAzimuthAngle()));
+  m_scan.push_back(distance * std::sin(a_attention.getZenithAngle()));
+  m_scanOrigin = a_container;
+}
+
+/**
+ * Clusters the points of the scan, and sends every cluster that is taken as
+ * a cone as an object with its direction and distance. The temporaries are
+ * taken from the arena before the pool starts, since the arena is not shared
+ * between threads.
+ */
+void DetectCone::detect()
+{
+  if (m_scan.empty()) {
+    return;
+  }
+  Eigen::Map<Eigen::Matrix3Xf const> const points(m_scan.data(), 3,
+      static_cast<int64_t>(m_scan.size() / 3));
+
+  common::ArenaVector<uint32_t> indices{
+    common::ArenaAllocator<uint32_t>(m_arena)};
+  common::ArenaVector<uint32_t> offsets{
+    common::ArenaAllocator<uint32_t>(m_arena)};
+  m_coneDetector.cluster(points, indices, offsets);
+  uint32_t const count = static_cast<uint32_t>(offsets.size() - 1);
+  common::ArenaVector<ClusterFeatures> features(count, ClusterFeatures(),
+      common::ArenaAllocator<ClusterFeatures>(m_arena));
+  auto const extract = [this, &points, &indices, &offsets, &features](
+      uint32_t a_i, uint32_t a_worker) {
+    features[a_i] = m_coneDetector.extract(points,
+        indices.data() + offsets[a_i], offsets[a_i + 1] - offsets[a_i],
+        m_scratch[a_worker]);
+  };
+  if (m_pool != nullptr && count >= m_minParallelClusters) {
+    m_pool->parallelFor(count, extract);
+  } else {
+    for (uint32_t i = 0; i < count; i++) {
+      extract(i, 0);
+    }
+  }
+  m_scan.clear();
+
+  uint32_t objectId = 0;
+  for (auto const &cluster : features) {
+    if (!m_coneDetector.isCone(cluster)) {
+      continue;
+    }
+    Eigen::Vector3f const &centroid = cluster.centroid;
+    float const horizontal = std::hypot(centroid(0), centroid(1));
+    opendlv::logic::perception::Object object(objectId);
+    opendlv::logic::perception::ObjectDirection direction(objectId,
+        std::atan2(centroid(1), centroid(0)),
+        std::atan2(centroid(2), horizontal));
+    opendlv::logic::perception::ObjectDistance distance(objectId,
+        centroid.norm());
+    odcore::data::Container objectContainer(object);
+    odcore::data::Container directionContainer(direction);
+    odcore::data::Container distanceContainer(distance);
+    common::propagateOrigin(m_scanOrigin, objectContainer);
+    common::propagateOrigin(m_scanOrigin, directionContainer);
+    common::propagateOrigin(m_scanOrigin, distanceContainer);
+    m_busPort.send(objectContainer);
+    m_busPort.send(directionContainer);
+    m_busPort.send(distanceContainer);
+    objectId++;
   }
 }
 
 void DetectCone::setUp()
 {
-  // std::string const exampleConfig = 
-  //   getKeyValueConfiguration().getValue<std::string>(
-  //     "logic-cfsd18-perception-detectcone.example-config");
+  setUp(getKeyValueConfiguration());
+}
+
+void DetectCone::setUp(
+    odcore::base::KeyValueConfiguration const &a_configuration)
+{
+  float const statisticsPeriod =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-perception-detectcone.statistics-period");
+  m_busPort.publishStatistics(getName(), statisticsPeriod);
+
+  float const clusterDistance =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-perception-detectcone.cluster-distance");
+  uint32_t const minPoints =
+    a_configuration.getValue<uint32_t>(
+      "logic-cfsd18-perception-detectcone.min-points");
+  float const maxWidth =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-perception-detectcone.max-width");
+  float const maxHeight =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-perception-detectcone.max-height");
+  float const sensorHeight =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-perception-detectcone.sensor-height");
+  m_coneDetector = ConeDetector(clusterDistance, minPoints, maxWidth,
+      maxHeight, sensorHeight);
 
-  // if (isVerbose()) {
-  //   std::cout << "Example config is " << exampleConfig << std::endl;
-  // }
+  uint32_t const workers = a_configuration.getValue<uint32_t>(
+      "logic-cfsd18-perception-detectcone.workers");
+  if (workers > 1) {
+    uint32_t const minParallelClusters =
+      a_configuration.getValue<uint32_t>(
+        "logic-cfsd18-perception-detectcone.min-parallel-clusters");
+    startPool(workers, minParallelClusters);
+    if (isVerbose()) {
+      std::cout << "Extracting the features of " << minParallelClusters
+        << " or more clusters on " << workers << " workers." << std::endl;
+    }
+  }
 }
 
 void DetectCone::tearDown()
 {
+  if (m_pool != nullptr && isVerbose()) {
+    std::cout << "Work stealing: " << m_pool->steals() << " clusters stolen."
+      << std::endl;
+  }
+  if (isVerbose()) {
+    std::cout << "Stage trace: " << m_busPort.traceReport() << "."
+      << std::endl;
+  }
 }
 
 }
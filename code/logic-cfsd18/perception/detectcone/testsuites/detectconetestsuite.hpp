@@ -21,6 +21,15 @@
 
 #include "cxxtest/TestSuite.h"
 
+#include <cmath>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "endofscan.hpp"
+#include "inprocessbus.hpp"
+#include "trace.hpp"
+
+#include "../include/conedetector.hpp"
 #include "../include/detectcone.hpp"
 
 class DetectConeTest : public CxxTest::TestSuite {
@@ -37,6 +46,105 @@ class DetectConeTest : public CxxTest::TestSuite {
     {
       TS_ASSERT(true);
     }
+
+    void testConeDetectorClustersNeighbours()
+    {
+      // Two cones side by side, and one point that is far from both.
+      Eigen::Matrix3Xf points(3, 5);
+      points << 5.0f, 8.0f, 5.1f, 8.05f, 20.0f,
+        1.5f, -1.5f, 1.55f, -1.45f, 0.0f,
+        -0.2f, -0.2f, -0.1f, -0.1f, 0.0f;
+
+      opendlv::logic::cfsd18::perception::ConeDetector detector(0.3f, 2,
+          0.4f, 0.5f, 0.4f);
+      opendlv::logic::cfsd18::common::Arena arena;
+      opendlv::logic::cfsd18::common::ArenaVector<uint32_t> indices{
+        opendlv::logic::cfsd18::common::ArenaAllocator<uint32_t>(arena)};
+      opendlv::logic::cfsd18::common::ArenaVector<uint32_t> offsets{
+        opendlv::logic::cfsd18::common::ArenaAllocator<uint32_t>(arena)};
+      detector.cluster(points, indices, offsets);
+      TS_ASSERT_EQUALS(std::vector<uint32_t>(indices.begin(), indices.end()),
+          std::vector<uint32_t>({0, 2, 1, 3, 4}));
+      TS_ASSERT_EQUALS(std::vector<uint32_t>(offsets.begin(), offsets.end()),
+          std::vector<uint32_t>({0, 2, 4, 5}));
+    }
+
+    void testConeDetectorTellsConesFromOtherClusters()
+    {
+      opendlv::logic::cfsd18::perception::ConeDetector detector(0.3f, 2,
+          0.4f, 0.5f, 0.4f);
+      Eigen::Matrix3Xf scratch;
+      std::vector<uint32_t> const all = {0, 1, 2, 3};
+
+      // A cone tapers from 0.1 m at the ground towards its top.
+      Eigen::Matrix3Xf cone(3, 4);
+      cone << 4.9f, 5.1f, 4.95f, 5.05f,
+        0.0f, 0.0f, 0.0f, 0.0f,
+        -0.35f, -0.35f, -0.15f, -0.15f;
+      auto const features = detector.extract(cone, all.data(), 4, scratch);
+      TS_ASSERT_EQUALS(features.count, 4u);
+      TS_ASSERT_DELTA(features.centroid(0), 5.0f, 1e-5f);
+      TS_ASSERT_DELTA(features.heightProfile[0], 0.1f, 1e-5f);
+      TS_ASSERT_DELTA(features.heightProfile[2], 0.05f, 1e-5f);
+      TS_ASSERT(detector.isCone(features));
+      TS_ASSERT_LESS_THAN_EQUALS(4, scratch.cols());
+
+      // Too few points, too tall, and wider at the top than at the bottom.
+      TS_ASSERT(!detector.isCone(detector.extract(cone, all.data(), 1, scratch)));
+      Eigen::Matrix3Xf post = cone;
+      post.row(2) << -0.35f, -0.35f, 0.5f, 0.5f;
+      TS_ASSERT(!detector.isCone(detector.extract(post, all.data(), 4,
+              scratch)));
+      Eigen::Matrix3Xf bowl = cone;
+      bowl.row(0) << 4.95f, 5.05f, 4.8f, 5.2f;
+      TS_ASSERT(!detector.isCone(detector.extract(bowl, all.data(), 4,
+              scratch)));
+    }
+
+    void testDetectConeDetectsAtTheEndOfAScan()
+    {
+      opendlv::logic::cfsd18::common::InProcessBus bus(
+          opendlv::logic::cfsd18::common::Delivery::Direct,
+          opendlv::logic::cfsd18::common::Mirroring::None);
+      auto detectCone = opendlv::logic::cfsd18::common::createMicroservice<
+        opendlv::logic::cfsd18::perception::DetectCone>(bus);
+      uint32_t objects = 0;
+      bus.subscribe([&objects](odcore::data::Container &a_container) {
+          if (a_container.getDataType()
+              == opendlv::logic::perception::Object::ID()) {
+            objects++;
+          }
+        });
+
+      odcore::data::Container origin;
+      origin.setSampleTimeStamp(odcore::data::TimeStamp(1, 0));
+      auto point = [&detectCone, &origin](float a_x, float a_y, float a_z) {
+        opendlv::logic::sensation::Attention attention(std::atan2(a_y, a_x),
+            std::atan2(a_z, std::hypot(a_x, a_y)),
+            std::sqrt(a_x * a_x + a_y * a_y + a_z * a_z));
+        odcore::data::Container container(attention);
+        opendlv::logic::cfsd18::common::propagateOrigin(origin, container);
+        detectCone->nextContainer(container);
+      };
+      auto cone = [&point](float a_y) {
+        point(4.9f, a_y, -0.35f);
+        point(5.1f, a_y, -0.35f);
+        point(4.95f, a_y, -0.15f);
+        point(5.05f, a_y, -0.15f);
+      };
+      cone(0.0f);
+      // A point at zero distance is only a point, not the end of the scan.
+      point(0.0f, 0.0f, 0.0f);
+      cone(2.0f);
+      TS_ASSERT_EQUALS(objects, 0u);
+
+      odcore::data::Container end =
+        opendlv::logic::cfsd18::common::endOfScan(origin);
+      TS_ASSERT_EQUALS(end.getDataType(),
+          opendlv::logic::sensation::Attention::ID());
+      detectCone->nextContainer(end);
+      TS_ASSERT_EQUALS(objects, 2u);
+    }
 };
 
 #endif
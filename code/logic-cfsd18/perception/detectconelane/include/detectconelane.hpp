@@ -20,12 +20,16 @@
 #ifndef OPENDLV_LOGIC_CFSD18_PERCEPTION_DETECTCONELANE_HPP
 #define OPENDLV_LOGIC_CFSD18_PERCEPTION_DETECTCONELANE_HPP
 
+#include <opendavinci/odcore/base/KeyValueConfiguration.h>
 #include <opendavinci/odcore/base/module/DataTriggeredConferenceClientModule.h>
 #include <opendavinci/odcore/data/Container.h>
 
 //#include <odvdopendlvstandardmessageset/GeneratedHeaders_ODVDOpenDLVStandardMessageSet.h>
 #include <odvdcfsd18/GeneratedHeaders_ODVDcfsd18.h>
 
+#include "busport.hpp"
+#include "dispatcher.hpp"
+
 namespace opendlv {
 namespace logic {
 namespace cfsd18 {
@@ -38,10 +42,18 @@ class DetectConeLane : public odcore::base::module::DataTriggeredConferenceClien
   DetectConeLane &operator=(DetectConeLane const &) = delete;
   virtual ~DetectConeLane();
   virtual void nextContainer(odcore::data::Container &);
+  void attachBus(common::InProcessBus &);
+  void setUp(odcore::base::KeyValueConfiguration const &);
 
  private:
   void setUp();
   void tearDown();
+  void receive(odcore::data::Container &);
+  void onObject(opendlv::logic::perception::Object const &,
+      odcore::data::Container &);
+
+  common::BusPort m_busPort;
+  common::Dispatcher<DetectConeLane> m_dispatcher;
 };
 
 }
@@ -24,6 +24,7 @@
 #include <opendavinci/odcore/wrapper/Eigen.h>
 
 #include "detectconelane.hpp"
+#include "trace.hpp"
 
 namespace opendlv {
 namespace logic {
@@ -31,31 +32,58 @@ namespace cfsd18 {
 namespace perception {
 
 DetectConeLane::DetectConeLane(int32_t const &a_argc, char **a_argv) :
-  DataTriggeredConferenceClientModule(a_argc, a_argv, "logic-cfsd18-perception-detectconelane")
+  DataTriggeredConferenceClientModule(a_argc, a_argv, "logic-cfsd18-perception-detectconelane"),
+  m_busPort([this](odcore::data::Container &a_container) { receive(a_container); },
+      [this](odcore::data::Container &a_container) { getConference().send(a_container); }),
+  m_dispatcher()
 {
+  m_dispatcher
+    .add<opendlv::logic::perception::Object, &DetectConeLane::onObject>();
 }
 
 DetectConeLane::~DetectConeLane()
 {
 }
 
-
+void DetectConeLane::attachBus(common::InProcessBus &a_bus)
+{
+  m_busPort.attach(a_bus);
+}
 
 void DetectConeLane::nextContainer(odcore::data::Container &a_container)
 {
-  if (a_container.getDataType() == opendlv::logic::perception::Object::ID()) {
-    // auto kinematicState = a_container.getData<opendlv::coord::KinematicState>();
+  m_busPort.receive(a_container);
+}
 
-    opendlv::logic::perception::Surface o1;
-    odcore::data::Container c1(o1);
-    getConference().send(c1);
-  }
+void DetectConeLane::receive(odcore::data::Container &a_container)
+{
+  m_dispatcher.dispatch(*this, a_container);
+}
+
+void DetectConeLane::onObject(opendlv::logic::perception::Object const &,
+    odcore::data::Container &a_container)
+{
+  opendlv::logic::perception::Surface o1;
+  odcore::data::Container c1(o1);
+  common::propagateOrigin(a_container, c1);
+  m_busPort.send(c1);
 }
 
 void DetectConeLane::setUp()
 {
+  setUp(getKeyValueConfiguration());
+}
+
+void DetectConeLane::setUp(
+    odcore::base::KeyValueConfiguration const &a_configuration)
+{
+  float const statisticsPeriod =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-perception-detectconelane.statistics-period");
+  m_busPort.publishStatistics(getName(), statisticsPeriod);
+
   // std::string const exampleConfig = 
-  //   getKeyValueConfiguration().getValue<std::string>(
+  //   a_configuration.getValue<std::string>(
   //     "logic-cfsd18-perception-detectconelane.example-config");
 
   // if (isVerbose()) {
@@ -65,6 +93,10 @@ void DetectConeLane::setUp()
 
 void DetectConeLane::tearDown()
 {
+  if (isVerbose()) {
+    std::cout << "Stage trace: " << m_busPort.traceReport() << "."
+      << std::endl;
+  }
 }
 
 }
@@ -0,0 +1,173 @@
+/**
+* Copyright (C) 2017 Chalmers Revere
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+* USA.
+*/
+
+#include <array>
+#include <vector>
+
+#include <opendavinci/generated/odcore/data/CompactPointCloud.h>
+
+#include <odvdcfsd18/GeneratedHeaders_ODVDcfsd18.h>
+
+#include "arena.hpp"
+#include "attention.hpp"
+#include "benchmark.hpp"
+#include "inprocessbus.hpp"
+#include "pipeline.hpp"
+#include "scanfilter.hpp"
+#include "syntheticsensor.hpp"
+#include "synthetictrack.hpp"
+
+namespace {
+
+using opendlv::logic::cfsd18::common::BenchmarkState;
+using opendlv::logic::cfsd18::common::InProcessBus;
+
+void nextContainerPointCloud(BenchmarkState &a_state)
+{
+  InProcessBus bus(opendlv::logic::cfsd18::common::Delivery::Direct,
+      opendlv::logic::cfsd18::common::Mirroring::None);
+  auto attention = opendlv::logic::cfsd18::common::createMicroservice<
+    opendlv::logic::cfsd18::sensation::Attention>(bus);
+  odcore::data::CompactPointCloud input;
+  odcore::data::Container container(input);
+  while (a_state.keepRunning()) {
+    attention->nextContainer(container);
+  }
+  a_state.setItemsProcessed(a_state.iterations());
+}
+
+void nextContainerRecordedPointCloud(BenchmarkState &a_state)
+{
+  std::vector<odcore::data::Container> containers =
+    opendlv::logic::cfsd18::common::Benchmarks::instance().recorded(
+        odcore::data::CompactPointCloud::ID());
+  if (containers.empty()) {
+    a_state.skip("No recorded point clouds.");
+    return;
+  }
+  InProcessBus bus(opendlv::logic::cfsd18::common::Delivery::Direct,
+      opendlv::logic::cfsd18::common::Mirroring::None);
+  auto attention = opendlv::logic::cfsd18::common::createMicroservice<
+    opendlv::logic::cfsd18::sensation::Attention>(bus);
+  uint64_t i = 0;
+  while (a_state.keepRunning()) {
+    attention->nextContainer(containers[i++ % containers.size()]);
+  }
+  a_state.setItemsProcessed(a_state.iterations());
+}
+
+/**
+ * Noisy scans from a lap of a synthetic trackdrive at 10 m/s and 10 Hz.
+ */
+std::vector<odcore::data::CompactPointCloud> syntheticScans()
+{
+  auto const track =
+    opendlv::logic::cfsd18::common::SyntheticTrack::trackdrive(1000.0f, 1);
+  opendlv::logic::cfsd18::common::SyntheticSensor sensor(1, 30.0f, 0.02f,
+      0.002f, 0.01f);
+  std::vector<odcore::data::CompactPointCloud> scans;
+  for (float distance : track.drive(10.0f, 10.0f, 1000.0f)) {
+    scans.push_back(sensor.scan(track, track.poseAt(distance)));
+  }
+  return scans;
+}
+
+void attendSyntheticPointClouds(BenchmarkState &a_state)
+{
+  std::vector<odcore::data::Container> containers;
+  for (auto &scan : syntheticScans()) {
+    containers.push_back(odcore::data::Container(scan));
+  }
+  InProcessBus bus(opendlv::logic::cfsd18::common::Delivery::Direct,
+      opendlv::logic::cfsd18::common::Mirroring::None);
+  auto attention = opendlv::logic::cfsd18::common::createMicroservice<
+    opendlv::logic::cfsd18::sensation::Attention>(bus);
+  uint64_t i = 0;
+  while (a_state.keepRunning()) {
+    attention->nextContainer(containers[i++ % containers.size()]);
+  }
+  a_state.setItemsProcessed(a_state.iterations());
+}
+
+/**
+ * The stages one after the other in the same thread.
+ */
+void filterSyntheticScans(BenchmarkState &a_state)
+{
+  std::vector<odcore::data::CompactPointCloud> const scans = syntheticScans();
+  opendlv::logic::cfsd18::sensation::ScanFilter const filter(20.0f, 10.0f,
+      0.4f, 0.1f, 0.1f);
+  opendlv::logic::cfsd18::common::Arena arena;
+  uint64_t i = 0;
+  while (a_state.keepRunning()) {
+    Eigen::Matrix3Xf const points =
+      filter.decode(scans[i++ % scans.size()], arena);
+    opendlv::logic::cfsd18::common::doNotOptimize(
+        filter.segment(filter.filter(points, arena), arena));
+    arena.reset();
+  }
+  a_state.setItemsProcessed(a_state.iterations());
+}
+
+/**
+ * The stages on a pipeline of three threads, fed as fast as it takes the
+ * scans, which measures the throughput rather than the latency.
+ */
+void filterSyntheticScansPipelined(BenchmarkState &a_state)
+{
+  std::vector<odcore::data::CompactPointCloud> const scans = syntheticScans();
+  opendlv::logic::cfsd18::sensation::ScanFilter const filter(20.0f, 10.0f,
+      0.4f, 0.1f, 0.1f);
+  std::array<opendlv::logic::cfsd18::common::Arena, 3> arenas;
+  typedef std::pair<uint32_t, Eigen::Matrix3Xf> Frame;
+  opendlv::logic::cfsd18::common::Pipeline<Frame, 4> pipeline;
+  pipeline.add([&scans, &filter, &arenas](Frame &a_frame) {
+      a_frame.second = filter.decode(scans[a_frame.first], arenas[0]);
+      arenas[0].reset();
+    });
+  pipeline.add([&filter, &arenas](Frame &a_frame) {
+      a_frame.second = filter.filter(a_frame.second, arenas[1]);
+      arenas[1].reset();
+    });
+  pipeline.add([&filter, &arenas](Frame &a_frame) {
+      opendlv::logic::cfsd18::common::doNotOptimize(
+          filter.segment(a_frame.second, arenas[2]));
+      arenas[2].reset();
+    });
+  pipeline.start();
+  uint64_t i = 0;
+  while (a_state.keepRunning()) {
+    Frame frame(static_cast<uint32_t>(i++ % scans.size()), Eigen::Matrix3Xf());
+    pipeline.push(std::move(frame));
+    if (i == a_state.iterations()) {
+      pipeline.drain();
+    }
+  }
+  a_state.setItemsProcessed(a_state.iterations());
+}
+
+CFSD18_BENCHMARK(nextContainerPointCloud);
+CFSD18_BENCHMARK(nextContainerRecordedPointCloud);
+CFSD18_BENCHMARK(attendSyntheticPointClouds);
+CFSD18_BENCHMARK(filterSyntheticScans);
+CFSD18_BENCHMARK(filterSyntheticScansPipelined);
+
+}
+
+CFSD18_BENCHMARK_MAIN()
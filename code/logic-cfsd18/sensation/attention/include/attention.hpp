@@ -20,12 +20,25 @@
 #ifndef OPENDLV_LOGIC_CFSD18_SENSATION_ATTENTION_HPP
 #define OPENDLV_LOGIC_CFSD18_SENSATION_ATTENTION_HPP
 
+#include <array>
+#include <memory>
+#include <vector>
+
+#include <opendavinci/odcore/base/KeyValueConfiguration.h>
 #include <opendavinci/odcore/base/module/DataTriggeredConferenceClientModule.h>
 #include <opendavinci/odcore/data/Container.h>
+#include <opendavinci/generated/odcore/data/CompactPointCloud.h>
 
 //#include <odvdopendlvstandardmessageset/GeneratedHeaders_ODVDOpenDLVStandardMessageSet.h>
 #include <odvdcfsd18/GeneratedHeaders_ODVDcfsd18.h>
 
+#include "arena.hpp"
+#include "busport.hpp"
+#include "dispatcher.hpp"
+#include "pipeline.hpp"
+
+#include "scanfilter.hpp"
+
 namespace opendlv {
 namespace logic {
 namespace cfsd18 {
@@ -38,10 +51,42 @@ class Attention : public odcore::base::module::DataTriggeredConferenceClientModu
   Attention &operator=(Attention const &) = delete;
   virtual ~Attention();
   virtual void nextContainer(odcore::data::Container &);
+  void attachBus(common::InProcessBus &);
+  void setUp(odcore::base::KeyValueConfiguration const &);
+  void startPipeline(std::vector<int32_t> const &);
+  void drain();
 
  private:
+  static uint32_t const PIPELINE_CAPACITY = 4;
+
+  struct Scan {
+    Scan();
+    Scan(odcore::data::Container const &,
+        odcore::data::CompactPointCloud const &);
+    Scan(Scan const &);
+    Scan(Scan &&);
+    Scan &operator=(Scan const &);
+    Scan &operator=(Scan &&);
+    ~Scan();
+
+    odcore::data::Container container;
+    odcore::data::CompactPointCloud pointCloud;
+    Eigen::Matrix3Xf points;
+  };
+
   void setUp();
   void tearDown();
+  void receive(odcore::data::Container &);
+  void onCompactPointCloud(odcore::data::CompactPointCloud const &,
+      odcore::data::Container &);
+  void sendPoints(Eigen::Matrix3Xf const &, odcore::data::Container &);
+
+  common::BusPort m_busPort;
+  common::Dispatcher<Attention> m_dispatcher;
+  ScanFilter m_scanFilter;
+  common::Arena m_arena;
+  std::array<common::Arena, 3> m_stageArenas;
+  std::unique_ptr<common::Pipeline<Scan, PIPELINE_CAPACITY>> m_pipeline;
 };
 
 }
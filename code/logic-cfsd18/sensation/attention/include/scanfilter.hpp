@@ -0,0 +1,71 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_SENSATION_SCANFILTER_HPP
+#define OPENDLV_LOGIC_CFSD18_SENSATION_SCANFILTER_HPP
+
+#include <cstdint>
+
+#include <opendavinci/odcore/wrapper/Eigen.h>
+#include <opendavinci/generated/odcore/data/CompactPointCloud.h>
+
+#include "arena.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace sensation {
+
+/**
+ * The stages that turn a lidar scan into the points worth attending to. A
+ * scan is decoded into points in the frame of the sensor, with x forward, y
+ * to the left and z up, the points outside a box ahead of the car and those
+ * on the ground are filtered out, and the rest are segmented into voxels
+ * and replaced by the centroid of every voxel. The stages do not change the
+ * filter, so they can run in different threads on different scans. Their
+ * temporaries are taken from the arena of the calling thread, while the
+ * points they return are on the heap, since they outlive the stage.
+ */
+class ScanFilter {
+ public:
+  ScanFilter(float, float, float, float, float);
+  ScanFilter(ScanFilter const &) = default;
+  ScanFilter &operator=(ScanFilter const &) = default;
+  virtual ~ScanFilter();
+
+  static float elevation(uint32_t, uint32_t) __attribute__((const));
+  Eigen::Matrix3Xf decode(odcore::data::CompactPointCloud const &,
+      common::Arena &) const;
+  Eigen::Matrix3Xf filter(Eigen::Matrix3Xf const &, common::Arena &) const;
+  Eigen::Matrix3Xf segment(Eigen::Matrix3Xf const &, common::Arena &) const;
+
+ private:
+  float m_length;
+  float m_width;
+  float m_sensorHeight;
+  float m_groundThreshold;
+  float m_voxelSize;
+};
+
+}
+}
+}
+}
+
+#endif
@@ -17,14 +17,18 @@
 * USA.
 */
 
+#include <cmath>
 #include <iostream>
+#include <sstream>
+#include <string>
 
 #include <opendavinci/odcore/data/TimeStamp.h>
 #include <opendavinci/odcore/strings/StringToolbox.h>
 #include <opendavinci/odcore/wrapper/Eigen.h>
-#include <opendavinci/generated/odcore/data/CompactPointCloud.h>
 
 #include "attention.hpp"
+#include "endofscan.hpp"
+#include "trace.hpp"
 
 namespace opendlv {
 namespace logic {
@@ -32,40 +36,210 @@ namespace cfsd18 {
 namespace sensation {
 
 Attention::Attention(int32_t const &a_argc, char **a_argv) :
-  DataTriggeredConferenceClientModule(a_argc, a_argv, "logic-cfsd18-sensation-attention")
+  DataTriggeredConferenceClientModule(a_argc, a_argv, "logic-cfsd18-sensation-attention"),
+  m_busPort([this](odcore::data::Container &a_container) { receive(a_container); },
+      [this](odcore::data::Container &a_container) { getConference().send(a_container); }),
+  m_dispatcher(),
+  m_scanFilter(20.0f, 10.0f, 0.4f, 0.1f, 0.1f),
+  m_arena(),
+  m_stageArenas(),
+  m_pipeline()
 {
+  m_dispatcher
+    .add<odcore::data::CompactPointCloud, &Attention::onCompactPointCloud>();
 }
 
 Attention::~Attention()
 {
 }
 
+Attention::Scan::Scan() :
+  container(),
+  pointCloud(),
+  points(3, 0)
+{
+}
+
+Attention::Scan::Scan(odcore::data::Container const &a_container,
+    odcore::data::CompactPointCloud const &a_pointCloud) :
+  container(a_container),
+  pointCloud(a_pointCloud),
+  points(3, 0)
+{
+}
+
+Attention::Scan::Scan(Scan const &) = default;
 
+Attention::Scan::Scan(Scan &&) = default;
+
+Attention::Scan &Attention::Scan::operator=(Scan const &) = default;
+
+Attention::Scan &Attention::Scan::operator=(Scan &&) = default;
+
+Attention::Scan::~Scan()
+{
+}
+
+void Attention::attachBus(common::InProcessBus &a_bus)
+{
+  m_busPort.attach(a_bus);
+}
+
+/**
+ * Moves the stages onto a pipeline of their own threads, pinned to the given
+ * cores in the order decode, filter and segment, so that a scan is decoded
+ * while the one before it is filtered and the one before that segmented.
+ * The scans are then sent from the segmenting thread, and a scan that
+ * arrives while the pipeline is full is dropped, which keeps the latency of
+ * the others bounded. Every stage has an arena of its own, which is reset
+ * after each scan.
+ */
+void Attention::startPipeline(std::vector<int32_t> const &a_cores)
+{
+  auto core = [&a_cores](uint32_t a_stage) {
+    return (a_stage < a_cores.size()) ? a_cores[a_stage] : -1;
+  };
+  m_pipeline.reset(new common::Pipeline<Scan, PIPELINE_CAPACITY>);
+  m_pipeline->add([this](Scan &a_scan) {
+      a_scan.points = m_scanFilter.decode(a_scan.pointCloud, m_stageArenas[0]);
+      m_stageArenas[0].reset();
+    }, core(0));
+  m_pipeline->add([this](Scan &a_scan) {
+      a_scan.points = m_scanFilter.filter(a_scan.points, m_stageArenas[1]);
+      m_stageArenas[1].reset();
+    }, core(1));
+  m_pipeline->add([this](Scan &a_scan) {
+      sendPoints(m_scanFilter.segment(a_scan.points, m_stageArenas[2]),
+          a_scan.container);
+      m_stageArenas[2].reset();
+    }, core(2));
+  m_pipeline->start();
+}
+
+/**
+ * Waits until the scans in the pipeline, if any, have been sent.
+ */
+void Attention::drain()
+{
+  if (m_pipeline != nullptr) {
+    m_pipeline->drain();
+  }
+}
 
 void Attention::nextContainer(odcore::data::Container &a_container)
 {
-  if (a_container.getDataType() == odcore::data::CompactPointCloud::ID()) {
-    // auto kinematicState = a_container.getData<opendlv::coord::KinematicState>();
+  m_busPort.receive(a_container);
+}
+
+/**
+ * Containers from the conference and from the bus both end up here, so the
+ * frame of the arena is the handling of one container. A container that is
+ * delivered back while one is handled gets a frame inside that one.
+ */
+void Attention::receive(odcore::data::Container &a_container)
+{
+  common::ArenaFrame const frame(m_arena);
+  m_dispatcher.dispatch(*this, a_container);
+}
+
+void Attention::onCompactPointCloud(
+    odcore::data::CompactPointCloud const &a_pointCloud,
+    odcore::data::Container &a_container)
+{
+  if (m_pipeline != nullptr) {
+    Scan scan(a_container, a_pointCloud);
+    m_pipeline->tryPush(std::move(scan));
+    return;
+  }
+  Eigen::Matrix3Xf const points = m_scanFilter.decode(a_pointCloud, m_arena);
+  sendPoints(m_scanFilter.segment(m_scanFilter.filter(points, m_arena),
+        m_arena), a_container);
+}
 
-    opendlv::logic::sensation::Attention o1;
-    odcore::data::Container c1(o1);
-    getConference().send(c1);
+/**
+ * Sends every point as an attention, with the azimuth counter-clockwise and
+ * the zenith angle upwards from the horizontal plane, in radians, and then
+ * the end of the scan, so that the scan can be used as soon as it is
+ * complete.
+ */
+void Attention::sendPoints(Eigen::Matrix3Xf const &a_points,
+    odcore::data::Container &a_origin)
+{
+  for (uint32_t i = 0; i < a_points.cols(); i++) {
+    float const horizontal = std::hypot(a_points(0, i), a_points(1, i));
+    opendlv::logic::sensation::Attention attention(
+        std::atan2(a_points(1, i), a_points(0, i)),
+        std::atan2(a_points(2, i), horizontal), a_points.col(i).norm());
+    odcore::data::Container container(attention);
+    common::propagateOrigin(a_origin, container);
+    m_busPort.send(container);
   }
+  odcore::data::Container endOfScan = common::endOfScan(a_origin);
+  m_busPort.send(endOfScan);
 }
 
 void Attention::setUp()
 {
-  // std::string const exampleConfig = 
-  //   getKeyValueConfiguration().getValue<std::string>(
-  //     "logic-cfsd18-sensation-attention.example-config");
+  setUp(getKeyValueConfiguration());
+}
+
+void Attention::setUp(
+    odcore::base::KeyValueConfiguration const &a_configuration)
+{
+  float const statisticsPeriod =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-sensation-attention.statistics-period");
+  m_busPort.publishStatistics(getName(), statisticsPeriod);
+
+  float const roiLength =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-sensation-attention.roi-length");
+  float const roiWidth =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-sensation-attention.roi-width");
+  float const sensorHeight =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-sensation-attention.sensor-height");
+  float const groundThreshold =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-sensation-attention.ground-threshold");
+  float const voxelSize =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-sensation-attention.voxel-size");
+  m_scanFilter = ScanFilter(roiLength, roiWidth, sensorHeight,
+      groundThreshold, voxelSize);
 
-  // if (isVerbose()) {
-  //   std::cout << "Example config is " << exampleConfig << std::endl;
-  // }
+  bool const isPipelined = a_configuration.getValue<int32_t>(
+      "logic-cfsd18-sensation-attention.pipelined") == 1;
+  if (isPipelined) {
+    std::stringstream cores(a_configuration.getValue<std::string>(
+          "logic-cfsd18-sensation-attention.pipeline-cores"));
+    std::vector<int32_t> pinnedCores;
+    std::string core;
+    while (std::getline(cores, core, ',')) {
+      pinnedCores.push_back(std::stoi(core));
+    }
+    startPipeline(pinnedCores);
+    if (isVerbose()) {
+      std::cout << "Running pipelined on " << pinnedCores.size()
+        << " pinned cores." << std::endl;
+    }
+  }
 }
 
 void Attention::tearDown()
 {
+  if (m_pipeline != nullptr) {
+    m_pipeline->stop();
+    if (isVerbose()) {
+      std::cout << "Pipeline: " << m_pipeline->statistics() << "."
+        << std::endl;
+    }
+  }
+  if (isVerbose()) {
+    std::cout << "Stage trace: " << m_busPort.traceReport() << "."
+      << std::endl;
+  }
 }
 
 }
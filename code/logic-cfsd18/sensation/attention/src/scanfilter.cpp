@@ -0,0 +1,224 @@
+/**
+* Copyright (C) 2017 Chalmers Revere
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+* USA.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+#include "scanfilter.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace sensation {
+
+namespace {
+
+float const pi = static_cast<float>(M_PI);
+float const lowestElevation = -15.0f;
+float const highestElevation = 15.0f;
+
+/**
+ * Voxel index along one axis, packed into 21 bits.
+ */
+uint64_t voxelIndex(float a_coordinate, float a_inverseSize)
+{
+  int64_t const index = static_cast<int64_t>(
+      std::floor(a_coordinate * a_inverseSize));
+  return static_cast<uint64_t>(index) & 0x1fffff;
+}
+
+}
+
+/**
+ * Takes the length [m] of the box ahead of the sensor in which points are
+ * kept, its width [m], the height [m] of the sensor above the ground, the
+ * height [m] above the ground below which points are taken as ground, and
+ * the edge [m] of the voxels.
+ */
+ScanFilter::ScanFilter(float a_length, float a_width, float a_sensorHeight,
+    float a_groundThreshold, float a_voxelSize) :
+  m_length(a_length),
+  m_width(a_width),
+  m_sensorHeight(a_sensorHeight),
+  m_groundThreshold(a_groundThreshold),
+  m_voxelSize(a_voxelSize)
+{
+}
+
+ScanFilter::~ScanFilter()
+{
+}
+
+/**
+ * Elevation in radians of a layer of a lidar with the given number of
+ * layers, spread evenly from -15 to 15 degrees and ordered from the lowest
+ * upwards, as on a VLP-16.
+ */
+float ScanFilter::elevation(uint32_t a_layer, uint32_t a_layers)
+{
+  float const step = (a_layers > 1)
+    ? (highestElevation - lowestElevation) / static_cast<float>(a_layers - 1)
+    : 0.0f;
+  return (lowestElevation + step * static_cast<float>(a_layer)) * pi / 180.0f;
+}
+
+/**
+ * Points of a scan whose distances are sent column by column, layer by
+ * layer, as big-endian 16 bit centimetres, with zero meaning no return and
+ * the intensity bits, if any, at the top. The azimuth runs clockwise in
+ * degrees from the start to the end azimuth, and wraps at 360.
+ */
+Eigen::Matrix3Xf ScanFilter::decode(
+    odcore::data::CompactPointCloud const &a_scan,
+    common::Arena &a_arena) const
+{
+  std::string const distances = a_scan.getDistances();
+  uint32_t const layers = a_scan.getEntriesPerAzimuth();
+  uint32_t const columns = (layers > 0)
+    ? static_cast<uint32_t>(distances.size()) / (2 * layers) : 0;
+  if (columns == 0) {
+    return Eigen::Matrix3Xf(3, 0);
+  }
+  uint32_t const intensityBits =
+    std::min(static_cast<uint32_t>(a_scan.getNumberOfBitsForIntensity()), 15u);
+  uint32_t const mask = 0xffffu >> intensityBits;
+
+  float const startAzimuth = a_scan.getStartAzimuth();
+  float endAzimuth = a_scan.getEndAzimuth();
+  if (endAzimuth <= startAzimuth) {
+    endAzimuth += 360.0f;
+  }
+  float const azimuthStep =
+    (endAzimuth - startAzimuth) / static_cast<float>(columns);
+
+  common::ArenaVector<float> cosElevation(layers, 0.0f,
+      common::ArenaAllocator<float>(a_arena));
+  common::ArenaVector<float> sinElevation(layers, 0.0f,
+      common::ArenaAllocator<float>(a_arena));
+  for (uint32_t layer = 0; layer < layers; layer++) {
+    cosElevation[layer] = std::cos(elevation(layer, layers));
+    sinElevation[layer] = std::sin(elevation(layer, layers));
+  }
+
+  uint32_t const entries = columns * layers;
+  common::ArenaVector<uint32_t> centimetres(entries, 0,
+      common::ArenaAllocator<uint32_t>(a_arena));
+  uint32_t count = 0;
+  for (uint32_t i = 0; i < entries; i++) {
+    uint32_t const value = ((static_cast<uint32_t>(
+            static_cast<uint8_t>(distances[2 * i])) << 8)
+        | static_cast<uint8_t>(distances[2 * i + 1])) & mask;
+    centimetres[i] = value;
+    count += (value > 0) ? 1 : 0;
+  }
+
+  Eigen::Matrix3Xf points(3, count);
+  uint32_t n = 0;
+  for (uint32_t column = 0; column < columns; column++) {
+    float const azimuth = (startAzimuth
+        + azimuthStep * static_cast<float>(column)) * pi / 180.0f;
+    float const cosAzimuth = std::cos(azimuth);
+    float const sinAzimuth = std::sin(azimuth);
+    for (uint32_t layer = 0; layer < layers; layer++) {
+      uint32_t const value = centimetres[column * layers + layer];
+      if (value == 0) {
+        continue;
+      }
+      float const distance = 0.01f * static_cast<float>(value);
+      float const horizontal = distance * cosElevation[layer];
+      points.col(n++) << horizontal * cosAzimuth, -horizontal * sinAzimuth,
+        distance * sinElevation[layer];
+    }
+  }
+  return points;
+}
+
+/**
+ * The points in the box ahead of the sensor that are above the ground, which
+ * is taken to be flat at the height of the sensor below it.
+ */
+Eigen::Matrix3Xf ScanFilter::filter(Eigen::Matrix3Xf const &a_points,
+    common::Arena &a_arena) const
+{
+  float const halfWidth = 0.5f * m_width;
+  float const groundLevel = m_groundThreshold - m_sensorHeight;
+
+  common::ArenaVector<uint32_t> kept{
+    common::ArenaAllocator<uint32_t>(a_arena)};
+  kept.reserve(static_cast<uint32_t>(a_points.cols()));
+  for (uint32_t i = 0; i < a_points.cols(); i++) {
+    if (a_points(0, i) > 0.0f && a_points(0, i) <= m_length
+        && std::fabs(a_points(1, i)) <= halfWidth
+        && a_points(2, i) > groundLevel) {
+      kept.push_back(i);
+    }
+  }
+
+  Eigen::Matrix3Xf points(3, kept.size());
+  for (uint32_t i = 0; i < kept.size(); i++) {
+    points.col(i) = a_points.col(kept[i]);
+  }
+  return points;
+}
+
+/**
+ * The centroids of the occupied voxels, in the order the voxels were first
+ * hit, so that the result does not depend on the hashing.
+ */
+Eigen::Matrix3Xf ScanFilter::segment(Eigen::Matrix3Xf const &a_points,
+    common::Arena &a_arena) const
+{
+  float const inverseSize = 1.0f / m_voxelSize;
+  uint32_t const count = static_cast<uint32_t>(a_points.cols());
+
+  common::ArenaUnorderedMap<uint64_t, uint32_t> voxels(count,
+      std::hash<uint64_t>(), std::equal_to<uint64_t>(),
+      common::ArenaAllocator<std::pair<uint64_t const, uint32_t>>(a_arena));
+  Eigen::Map<Eigen::Matrix3Xf> sums(static_cast<float *>(
+        a_arena.allocate(3 * count * sizeof(float), alignof(float))), 3, count);
+  common::ArenaVector<uint32_t> counts{
+    common::ArenaAllocator<uint32_t>(a_arena)};
+  counts.reserve(count);
+  for (uint32_t i = 0; i < count; i++) {
+    uint64_t const key = (voxelIndex(a_points(0, i), inverseSize) << 42)
+      | (voxelIndex(a_points(1, i), inverseSize) << 21)
+      | voxelIndex(a_points(2, i), inverseSize);
+    uint32_t const next = static_cast<uint32_t>(counts.size());
+    auto const voxel = voxels.emplace(key, next);
+    if (voxel.second) {
+      sums.col(next) = a_points.col(i);
+      counts.push_back(1);
+    } else {
+      sums.col(voxel.first->second) += a_points.col(i);
+      counts[voxel.first->second]++;
+    }
+  }
+
+  Eigen::Matrix3Xf centroids(3, counts.size());
+  for (uint32_t i = 0; i < counts.size(); i++) {
+    centroids.col(i) = sums.col(i) / static_cast<float>(counts[i]);
+  }
+  return centroids;
+}
+
+}
+}
+}
+}
@@ -21,7 +21,11 @@
 
 #include "cxxtest/TestSuite.h"
 
+#include <cmath>
+#include <string>
+
 #include "../include/attention.hpp"
+#include "../include/scanfilter.hpp"
 
 class AttentionTest : public CxxTest::TestSuite {
   public:
@@ -37,6 +41,49 @@ class AttentionTest : public CxxTest::TestSuite {
     {
       TS_ASSERT(true);
     }
+
+    void testScanFilterDecodesColumnsAndLayers()
+    {
+      // Four columns of 16 layers, with intensity in the top two bits.
+      std::string distances(2 * 4 * 16, '\0');
+      distances[2 * 15] = static_cast<char>(0xc0);
+      distances[2 * 15 + 1] = static_cast<char>(200);
+      distances[2 * (16 + 7)] = static_cast<char>(1000 >> 8);
+      distances[2 * (16 + 7) + 1] = static_cast<char>(1000 & 0xff);
+      odcore::data::CompactPointCloud scan(0.0f, 360.0f, 16, distances, 2);
+
+      opendlv::logic::cfsd18::sensation::ScanFilter filter(20.0f, 10.0f,
+          0.4f, 0.1f, 0.1f);
+      opendlv::logic::cfsd18::common::Arena arena;
+      Eigen::Matrix3Xf const points = filter.decode(scan, arena);
+      TS_ASSERT_EQUALS(points.cols(), 2);
+      float const pi = static_cast<float>(M_PI);
+      TS_ASSERT_DELTA(points(0, 0), 2.0f * std::cos(pi / 12.0f), 1e-4f);
+      TS_ASSERT_DELTA(points(1, 0), 0.0f, 1e-4f);
+      TS_ASSERT_DELTA(points(2, 0), 2.0f * std::sin(pi / 12.0f), 1e-4f);
+      TS_ASSERT_DELTA(points(0, 1), 0.0f, 1e-4f);
+      TS_ASSERT_DELTA(points(1, 1), -10.0f * std::cos(pi / 180.0f), 1e-4f);
+      TS_ASSERT_DELTA(points(2, 1), -10.0f * std::sin(pi / 180.0f), 1e-4f);
+    }
+
+    void testScanFilterRemovesGroundAndVoxelises()
+    {
+      Eigen::Matrix3Xf points(3, 5);
+      points << 5.0f, -2.0f, 5.0f, 5.0f, 5.02f,
+        0.0f, 0.0f, 8.0f, 0.01f, 0.02f,
+        -0.4f, 0.0f, 0.0f, -0.15f, -0.12f;
+
+      opendlv::logic::cfsd18::sensation::ScanFilter filter(20.0f, 10.0f,
+          0.4f, 0.1f, 0.1f);
+      opendlv::logic::cfsd18::common::Arena arena;
+      Eigen::Matrix3Xf const kept = filter.filter(points, arena);
+      TS_ASSERT_EQUALS(kept.cols(), 2);
+      Eigen::Matrix3Xf const centroids = filter.segment(kept, arena);
+      TS_ASSERT_EQUALS(centroids.cols(), 1);
+      TS_ASSERT_DELTA(centroids(0, 0), 5.01f, 1e-5f);
+      TS_ASSERT_DELTA(centroids(1, 0), 0.015f, 1e-5f);
+      TS_ASSERT_DELTA(centroids(2, 0), -0.135f, 1e-5f);
+    }
 };
 
 #endif
@@ -20,12 +20,16 @@
 #ifndef OPENDLV_LOGIC_CFSD18_SENSATION_SLAM_HPP
 #define OPENDLV_LOGIC_CFSD18_SENSATION_SLAM_HPP
 
+#include <opendavinci/odcore/base/KeyValueConfiguration.h>
 #include <opendavinci/odcore/base/module/DataTriggeredConferenceClientModule.h>
 #include <opendavinci/odcore/data/Container.h>
 
 //#include <odvdopendlvstandardmessageset/GeneratedHeaders_ODVDOpenDLVStandardMessageSet.h>
 #include <odvdcfsd18/GeneratedHeaders_ODVDcfsd18.h>
 
+#include "busport.hpp"
+#include "dispatcher.hpp"
+
 namespace opendlv {
 namespace logic {
 namespace cfsd18 {
@@ -38,10 +42,18 @@ class Slam : public odcore::base::module::DataTriggeredConferenceClientModule {
   Slam &operator=(Slam const &) = delete;
   virtual ~Slam();
   virtual void nextContainer(odcore::data::Container &);
+  void attachBus(common::InProcessBus &);
+  void setUp(odcore::base::KeyValueConfiguration const &);
 
  private:
   void setUp();
   void tearDown();
+  void receive(odcore::data::Container &);
+  void onGeolocation(opendlv::logic::sensation::Geolocation const &,
+      odcore::data::Container &);
+
+  common::BusPort m_busPort;
+  common::Dispatcher<Slam> m_dispatcher;
 };
 
 }
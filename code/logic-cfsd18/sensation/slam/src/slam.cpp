@@ -24,6 +24,7 @@
 #include <opendavinci/odcore/wrapper/Eigen.h>
 
 #include "slam.hpp"
+#include "trace.hpp"
 
 namespace opendlv {
 namespace logic {
@@ -31,34 +32,58 @@ namespace cfsd18 {
 namespace sensation {
 
 Slam::Slam(int32_t const &a_argc, char **a_argv) :
-  DataTriggeredConferenceClientModule(a_argc, a_argv, "logic-cfsd18-sensation-slam")
+  DataTriggeredConferenceClientModule(a_argc, a_argv, "logic-cfsd18-sensation-slam"),
+  m_busPort([this](odcore::data::Container &a_container) { receive(a_container); },
+      [this](odcore::data::Container &a_container) { getConference().send(a_container); }),
+  m_dispatcher()
 {
+  m_dispatcher
+    .add<opendlv::logic::sensation::Geolocation, &Slam::onGeolocation>();
 }
 
 Slam::~Slam()
 {
 }
 
-
+void Slam::attachBus(common::InProcessBus &a_bus)
+{
+  m_busPort.attach(a_bus);
+}
 
 void Slam::nextContainer(odcore::data::Container &a_container)
 {
-  if (a_container.getDataType() == opendlv::logic::perception::Object::ID()) {
-    // auto kinematicState = a_container.getData<opendlv::coord::KinematicState>();
-  }
-  if (a_container.getDataType() == opendlv::logic::sensation::Geolocation::ID()) {
-    // auto kinematicState = a_container.getData<opendlv::coord::KinematicState>();
+  m_busPort.receive(a_container);
+}
 
-    opendlv::logic::perception::Object o1;
-    odcore::data::Container c1(o1);
-    getConference().send(c1);
-  }
+void Slam::receive(odcore::data::Container &a_container)
+{
+  m_dispatcher.dispatch(*this, a_container);
+}
+
+void Slam::onGeolocation(opendlv::logic::sensation::Geolocation const &,
+    odcore::data::Container &a_container)
+{
+  opendlv::logic::perception::Object o1;
+  odcore::data::Container c1(o1);
+  common::propagateOrigin(a_container, c1);
+  m_busPort.send(c1);
 }
 
 void Slam::setUp()
 {
+  setUp(getKeyValueConfiguration());
+}
+
+void Slam::setUp(
+    odcore::base::KeyValueConfiguration const &a_configuration)
+{
+  float const statisticsPeriod =
+    a_configuration.getValue<float>(
+      "logic-cfsd18-sensation-slam.statistics-period");
+  m_busPort.publishStatistics(getName(), statisticsPeriod);
+
   // std::string const exampleConfig = 
-  //   getKeyValueConfiguration().getValue<std::string>(
+  //   a_configuration.getValue<std::string>(
   //     "logic-cfsd18-sensation-slam.example-config");
 
   // if (isVerbose()) {
@@ -68,6 +93,10 @@ void Slam::setUp()
 
 void Slam::tearDown()
 {
+  if (isVerbose()) {
+    std::cout << "Stage trace: " << m_busPort.traceReport() << "."
+      << std::endl;
+  }
 }
 
 }
@@ -0,0 +1,78 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_TOOLS_COMPOSITION_HPP
+#define OPENDLV_LOGIC_CFSD18_TOOLS_COMPOSITION_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <opendavinci/odcore/base/KeyValueConfiguration.h>
+#include <opendavinci/odcore/base/module/DataTriggeredConferenceClientModule.h>
+
+#include "inprocessbus.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace tools {
+
+/**
+ * Hosts several microservices in one process, each running in its own
+ * thread, and connects them through an in-process bus. With --bus=queued the
+ * bus hands containers over through rings, so that every microservice also
+ * handles them in a thread of its own.
+ */
+class Composition {
+ public:
+  Composition(int32_t const &, char **);
+  Composition(Composition const &) = delete;
+  Composition &operator=(Composition const &) = delete;
+  virtual ~Composition();
+
+  int32_t run();
+  static std::unique_ptr<
+    odcore::base::module::DataTriggeredConferenceClientModule> create(
+        std::string const &, int32_t const &, char **, common::InProcessBus &,
+        odcore::base::KeyValueConfiguration const * = nullptr);
+  static std::vector<std::string> parseMicroservices(int32_t const &, char **);
+  static common::Delivery parseDelivery(int32_t const &, char **);
+  static std::string argument(int32_t const &, char **, std::string const &);
+
+ private:
+  template<typename T>
+  static std::unique_ptr<
+    odcore::base::module::DataTriggeredConferenceClientModule> create(
+        int32_t const &, char **, common::InProcessBus &,
+        odcore::base::KeyValueConfiguration const *);
+
+  int32_t m_argc;
+  char **m_argv;
+  common::InProcessBus m_bus;
+  std::vector<std::unique_ptr<
+    odcore::base::module::DataTriggeredConferenceClientModule>> m_microservices;
+};
+
+}
+}
+}
+}
+
+#endif
@@ -0,0 +1,203 @@
+/**
+* Copyright (C) 2017 Chalmers Revere
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+* USA.
+*/
+
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <utility>
+
+#include "acceleration.hpp"
+#include "attention.hpp"
+#include "brake.hpp"
+#include "detectcone.hpp"
+#include "detectconelane.hpp"
+#include "lateral.hpp"
+#include "limitlateral.hpp"
+#include "longitudinal.hpp"
+#include "skidpad.hpp"
+#include "slam.hpp"
+#include "track.hpp"
+
+#include "composition.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace tools {
+
+Composition::Composition(int32_t const &a_argc, char **a_argv) :
+  m_argc(a_argc),
+  m_argv(a_argv),
+  m_bus(parseDelivery(a_argc, a_argv)),
+  m_microservices()
+{
+}
+
+Composition::~Composition()
+{
+}
+
+/**
+ * Creates the microservices given by --microservices, attaches all of them
+ * to the bus before any of them starts, and runs them until they stop.
+ */
+int32_t Composition::run()
+{
+  std::vector<std::string> const names = parseMicroservices(m_argc, m_argv);
+  if (names.empty()) {
+    std::cerr << "Usage: " << m_argv[0] << " --cid=<CID> "
+      << "--microservices=<name>[,<name>...] [--bus=direct|queued]"
+      << std::endl;
+    return 1;
+  }
+  for (auto const &name : names) {
+    auto microservice = create(name, m_argc, m_argv, m_bus);
+    if (microservice == nullptr) {
+      std::cerr << "Unknown microservice " << name << "." << std::endl;
+      return 1;
+    }
+    m_microservices.push_back(std::move(microservice));
+  }
+
+  m_bus.start();
+  std::vector<std::thread> threads;
+  for (auto &microservice : m_microservices) {
+    auto module = microservice.get();
+    threads.push_back(std::thread([module]() { module->runModule(); }));
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  m_bus.stop();
+  if (m_bus.dropped() > 0) {
+    std::cerr << "Dropped " << m_bus.dropped()
+      << " containers that were waiting for the rings." << std::endl;
+  }
+  return 0;
+}
+
+/**
+ * Names from the comma separated --microservices argument.
+ */
+std::vector<std::string> Composition::parseMicroservices(int32_t const &a_argc,
+    char **a_argv)
+{
+  std::vector<std::string> names;
+  std::stringstream list(argument(a_argc, a_argv, "microservices"));
+  std::string name;
+  while (std::getline(list, name, ',')) {
+    if (!name.empty()) {
+      names.push_back(name);
+    }
+  }
+  return names;
+}
+
+common::Delivery Composition::parseDelivery(int32_t const &a_argc,
+    char **a_argv)
+{
+  return (argument(a_argc, a_argv, "bus") == "queued")
+    ? common::Delivery::Queued : common::Delivery::Direct;
+}
+
+/**
+ * Value of the last --<name>=<value> argument, or an empty string.
+ */
+std::string Composition::argument(int32_t const &a_argc, char **a_argv,
+    std::string const &a_name)
+{
+  std::string const prefix = "--" + a_name + "=";
+  std::string value;
+  for (int32_t i = 1; i < a_argc; i++) {
+    std::string const argument(a_argv[i]);
+    if (argument.compare(0, prefix.size(), prefix) == 0) {
+      value = argument.substr(prefix.size());
+    }
+  }
+  return value;
+}
+
+/**
+ * Creates a microservice by name, attached to a bus, or returns null for an
+ * unknown name. Given a configuration, the microservice is also set up from
+ * it, for running it without a conference. Otherwise it is set up from the
+ * conference when it runs.
+ */
+std::unique_ptr<odcore::base::module::DataTriggeredConferenceClientModule>
+Composition::create(std::string const &a_name, int32_t const &a_argc,
+    char **a_argv, common::InProcessBus &a_bus,
+    odcore::base::KeyValueConfiguration const *a_configuration)
+{
+  if (a_name == "attention") {
+    return create<sensation::Attention>(a_argc, a_argv, a_bus,
+        a_configuration);
+  } else if (a_name == "slam") {
+    return create<sensation::Slam>(a_argc, a_argv, a_bus,
+        a_configuration);
+  } else if (a_name == "detectcone") {
+    return create<perception::DetectCone>(a_argc, a_argv, a_bus,
+        a_configuration);
+  } else if (a_name == "detectconelane") {
+    return create<perception::DetectConeLane>(a_argc, a_argv, a_bus,
+        a_configuration);
+  } else if (a_name == "acceleration") {
+    return create<cognition::Acceleration>(a_argc, a_argv, a_bus,
+        a_configuration);
+  } else if (a_name == "brake") {
+    return create<cognition::Brake>(a_argc, a_argv, a_bus,
+        a_configuration);
+  } else if (a_name == "limitlateral") {
+    return create<cognition::LimitLateral>(a_argc, a_argv, a_bus,
+        a_configuration);
+  } else if (a_name == "skidpad") {
+    return create<cognition::Skidpad>(a_argc, a_argv, a_bus,
+        a_configuration);
+  } else if (a_name == "track") {
+    return create<cognition::Track>(a_argc, a_argv, a_bus,
+        a_configuration);
+  } else if (a_name == "lateral") {
+    return create<action::Lateral>(a_argc, a_argv, a_bus,
+        a_configuration);
+  } else if (a_name == "longitudinal") {
+    return create<action::Longitudinal>(a_argc, a_argv, a_bus,
+        a_configuration);
+  }
+  return nullptr;
+}
+
+template<typename T>
+std::unique_ptr<odcore::base::module::DataTriggeredConferenceClientModule>
+Composition::create(int32_t const &a_argc, char **a_argv,
+    common::InProcessBus &a_bus,
+    odcore::base::KeyValueConfiguration const *a_configuration)
+{
+  std::unique_ptr<T> microservice(new T(a_argc, a_argv));
+  microservice->attachBus(a_bus);
+  if (a_configuration != nullptr) {
+    microservice->setUp(*a_configuration);
+  }
+  return std::unique_ptr<
+    odcore::base::module::DataTriggeredConferenceClientModule>(
+        microservice.release());
+}
+
+}
+}
+}
+}
@@ -0,0 +1,62 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_TOOLS_COMPOSITION_TESTSUITE_HPP
+#define OPENDLV_LOGIC_CFSD18_TOOLS_COMPOSITION_TESTSUITE_HPP
+
+#include "cxxtest/TestSuite.h"
+
+#include "../include/composition.hpp"
+
+class CompositionTest : public CxxTest::TestSuite {
+  public:
+    void setUp()
+    {
+    }
+
+    void tearDown()
+    {
+    }
+
+    void testApplication()
+    {
+      TS_ASSERT(true);
+    }
+
+    void testParseMicroservices()
+    {
+      char name[] = "composition";
+      char cid[] = "--cid=111";
+      char microservices[] = "--microservices=attention,,detectcone,slam";
+      char *argv[] = {name, cid, microservices};
+      auto const names = opendlv::logic::cfsd18::tools::Composition::parseMicroservices(3, argv);
+      TS_ASSERT_EQUALS(names.size(), 3u);
+      TS_ASSERT_EQUALS(names[0], "attention");
+      TS_ASSERT_EQUALS(names[2], "slam");
+      TS_ASSERT(opendlv::logic::cfsd18::tools::Composition::parseDelivery(3, argv)
+          == opendlv::logic::cfsd18::common::Delivery::Direct);
+
+      char queued[] = "--bus=queued";
+      char *queuedArgv[] = {name, queued};
+      TS_ASSERT(opendlv::logic::cfsd18::tools::Composition::parseDelivery(2, queuedArgv)
+          == opendlv::logic::cfsd18::common::Delivery::Queued);
+    }
+};
+
+#endif
@@ -0,0 +1,40 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "latency.hpp"
+
+int32_t main(int32_t a_argc, char **a_argv) {
+  std::string const recording =
+    opendlv::logic::cfsd18::tools::Latency::parseRecording(a_argc, a_argv);
+  std::ifstream file(recording, std::ios::in | std::ios::binary);
+  if (!file.good()) {
+    std::cerr << a_argv[0] << ": cannot open the recording '" << recording
+      << "'." << std::endl;
+    return 1;
+  }
+
+  opendlv::logic::cfsd18::tools::Latency latency;
+  uint32_t const containers = latency.read(file);
+  std::cout << "Read " << containers << " containers." << std::endl
+    << latency.report();
+  return 0;
+}
@@ -0,0 +1,74 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_TOOLS_LATENCY_HPP
+#define OPENDLV_LOGIC_CFSD18_TOOLS_LATENCY_HPP
+
+#include <array>
+#include <cstdint>
+#include <istream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <opendavinci/odcore/data/Container.h>
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace tools {
+
+/**
+ * Measures the latency of the pipeline from point cloud to steering request
+ * in a recording. Containers are grouped by their origin, which every stage
+ * passes on, and the time between the sending of two consecutive stages is
+ * the latency of the later one.
+ */
+class Latency {
+ public:
+  static uint32_t const STAGES = 6;
+  static uint32_t const MAX_PENDING = 4096;
+
+  Latency();
+  Latency(Latency const &) = default;
+  Latency &operator=(Latency const &) = default;
+  virtual ~Latency();
+
+  void add(odcore::data::Container &);
+  uint32_t read(std::istream &);
+  uint32_t size(uint32_t) const;
+  double stagePercentile(uint32_t, float) const;
+  double totalPercentile(float) const;
+  std::string report() const;
+  static std::string parseRecording(int32_t const &, char **);
+
+ private:
+  static int32_t stageOf(int32_t) __attribute__((const));
+
+  std::map<int64_t, std::array<int64_t, STAGES>> m_pending;
+  std::array<std::vector<double>, STAGES> m_stageTimes;
+  std::vector<double> m_totalTimes;
+};
+
+}
+}
+}
+}
+
+#endif
@@ -0,0 +1,177 @@
+/**
+* Copyright (C) 2017 Chalmers Revere
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+* USA.
+*/
+
+#include <sstream>
+#include <utility>
+
+#include <opendavinci/generated/odcore/data/CompactPointCloud.h>
+
+#include <odvdcfsd18/GeneratedHeaders_ODVDcfsd18.h>
+
+#include "latency.hpp"
+#include "trace.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace tools {
+
+namespace {
+
+char const *const STAGE_NAMES[] = {"point cloud", "attention", "detectcone",
+  "detectconelane", "planner", "lateral"};
+
+}
+
+Latency::Latency() :
+  m_pending(),
+  m_stageTimes(),
+  m_totalTimes()
+{
+}
+
+Latency::~Latency()
+{
+}
+
+/**
+ * Records when a container of the pipeline was sent. A trace is complete
+ * when the steering request is sent, and only the first container of every
+ * stage counts. The oldest trace is dropped if too many are incomplete.
+ */
+void Latency::add(odcore::data::Container &a_container)
+{
+  int32_t const stage = stageOf(a_container.getDataType());
+  if (stage < 0) {
+    return;
+  }
+
+  int64_t const origin = common::originOf(a_container).toMicroseconds();
+  auto pending = m_pending.find(origin);
+  if (pending == m_pending.end()) {
+    if (m_pending.size() >= MAX_PENDING) {
+      m_pending.erase(m_pending.begin());
+    }
+    std::array<int64_t, STAGES> sentTimes;
+    sentTimes.fill(0);
+    pending = m_pending.insert(std::make_pair(origin, sentTimes)).first;
+  }
+
+  auto &sentTimes = pending->second;
+  if (sentTimes[stage] != 0) {
+    return;
+  }
+  int64_t const sentTime = a_container.getSentTimeStamp().toMicroseconds();
+  sentTimes[stage] = sentTime;
+  if (stage > 0 && sentTimes[stage - 1] != 0) {
+    m_stageTimes[stage].push_back(
+        static_cast<double>(sentTime - sentTimes[stage - 1]) / 1000000.0);
+  }
+  if (stage == static_cast<int32_t>(STAGES) - 1) {
+    m_totalTimes.push_back(static_cast<double>(sentTime - origin) / 1000000.0);
+    m_pending.erase(pending);
+  }
+}
+
+/**
+ * Adds every container of a recording, and returns how many there were.
+ */
+uint32_t Latency::read(std::istream &a_recording)
+{
+  uint32_t containers = 0;
+  while (a_recording.good()) {
+    odcore::data::Container container;
+    a_recording >> container;
+    if (a_recording.fail()) {
+      break;
+    }
+    add(container);
+    containers++;
+  }
+  return containers;
+}
+
+uint32_t Latency::size(uint32_t a_stage) const
+{
+  return static_cast<uint32_t>(m_stageTimes[a_stage].size());
+}
+
+double Latency::stagePercentile(uint32_t a_stage, float a_percentile) const
+{
+  return common::percentile(m_stageTimes[a_stage], a_percentile);
+}
+
+double Latency::totalPercentile(float a_percentile) const
+{
+  return common::percentile(m_totalTimes, a_percentile);
+}
+
+std::string Latency::report() const
+{
+  std::stringstream report;
+  for (uint32_t i = 1; i < STAGES; i++) {
+    report << STAGE_NAMES[i] << ": p50 " << stagePercentile(i, 50.0f) * 1000.0
+      << " ms, p99 " << stagePercentile(i, 99.0f) * 1000.0 << " ms over "
+      << size(i) << " samples" << std::endl;
+  }
+  report << "pipeline: p50 " << totalPercentile(50.0f) * 1000.0
+    << " ms, p99 " << totalPercentile(99.0f) * 1000.0 << " ms over "
+    << m_totalTimes.size() << " samples" << std::endl;
+  return report.str();
+}
+
+std::string Latency::parseRecording(int32_t const &a_argc, char **a_argv)
+{
+  std::string const prefix = "--rec=";
+  for (int32_t i = 1; i < a_argc; i++) {
+    std::string const argument(a_argv[i]);
+    if (argument.compare(0, prefix.size(), prefix) == 0) {
+      return argument.substr(prefix.size());
+    }
+  }
+  return "";
+}
+
+int32_t Latency::stageOf(int32_t a_dataType)
+{
+  if (a_dataType == odcore::data::CompactPointCloud::ID()) {
+    return 0;
+  }
+  if (a_dataType == opendlv::logic::sensation::Attention::ID()) {
+    return 1;
+  }
+  if (a_dataType == opendlv::logic::perception::Object::ID()) {
+    return 2;
+  }
+  if (a_dataType == opendlv::logic::perception::Surface::ID()) {
+    return 3;
+  }
+  if (a_dataType == opendlv::logic::action::AimPoint::ID()) {
+    return 4;
+  }
+  if (a_dataType == opendlv::proxy::GroundSteeringRequest::ID()) {
+    return 5;
+  }
+  return -1;
+}
+
+}
+}
+}
+}
@@ -0,0 +1,116 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_TOOLS_LATENCY_TESTSUITE_HPP
+#define OPENDLV_LOGIC_CFSD18_TOOLS_LATENCY_TESTSUITE_HPP
+
+#include <sstream>
+
+#include "cxxtest/TestSuite.h"
+
+#include <opendavinci/generated/odcore/data/CompactPointCloud.h>
+#include <opendavinci/odcore/data/TimeStamp.h>
+
+#include <odvdcfsd18/GeneratedHeaders_ODVDcfsd18.h>
+
+#include "../include/latency.hpp"
+
+class LatencyTest : public CxxTest::TestSuite {
+  public:
+    void setUp()
+    {
+    }
+
+    void tearDown()
+    {
+    }
+
+    void testApplication()
+    {
+      TS_ASSERT(true);
+    }
+
+    void testPipeline()
+    {
+      opendlv::logic::cfsd18::tools::Latency latency;
+
+      for (int32_t i = 0; i < 10; i++) {
+        odcore::data::TimeStamp const origin(100 + i, 0);
+        odcore::data::CompactPointCloud pointCloud;
+        odcore::data::Container c0(pointCloud);
+        c0.setSampleTimeStamp(origin);
+        c0.setSentTimeStamp(origin);
+        latency.add(c0);
+
+        opendlv::logic::sensation::Attention attention;
+        opendlv::logic::perception::Object object;
+        opendlv::logic::perception::Surface surface;
+        opendlv::logic::action::AimPoint aimPoint;
+        opendlv::proxy::GroundSteeringRequest groundSteeringRequest;
+        odcore::data::Container c1(attention);
+        odcore::data::Container c2(object);
+        odcore::data::Container c3(surface);
+        odcore::data::Container c4(aimPoint);
+        odcore::data::Container c5(groundSteeringRequest);
+        odcore::data::Container *stages[] = {&c1, &c2, &c3, &c4, &c5};
+        for (int32_t j = 0; j < 5; j++) {
+          stages[j]->setSampleTimeStamp(origin);
+          stages[j]->setSentTimeStamp(
+              odcore::data::TimeStamp(100 + i, 1000 * (j + 1) * (i + 1)));
+          latency.add(*stages[j]);
+        }
+        // A repeated request is not part of the trace.
+        latency.add(c5);
+      }
+
+      TS_ASSERT_EQUALS(latency.size(1), 10u);
+      TS_ASSERT_EQUALS(latency.size(5), 10u);
+      TS_ASSERT_DELTA(latency.stagePercentile(3, 50.0f), 0.005, 1e-9);
+      TS_ASSERT_DELTA(latency.stagePercentile(3, 99.0f), 0.010, 1e-9);
+      TS_ASSERT_DELTA(latency.totalPercentile(50.0f), 0.025, 1e-9);
+      TS_ASSERT_DELTA(latency.totalPercentile(99.0f), 0.050, 1e-9);
+    }
+
+    void testIncompleteTrace()
+    {
+      opendlv::logic::cfsd18::tools::Latency latency;
+      opendlv::logic::perception::Surface surface;
+      odcore::data::Container container(surface);
+      container.setSampleTimeStamp(odcore::data::TimeStamp(1, 0));
+      container.setSentTimeStamp(odcore::data::TimeStamp(1, 5000));
+      latency.add(container);
+
+      TS_ASSERT_EQUALS(latency.size(3), 0u);
+      TS_ASSERT_DELTA(latency.totalPercentile(50.0f), 0.0, 1e-9);
+    }
+
+    void testParseRecording()
+    {
+      char name[] = "latency";
+      char recording[] = "--rec=track.rec";
+      char *argv[] = {name, recording};
+      TS_ASSERT_EQUALS(
+          opendlv::logic::cfsd18::tools::Latency::parseRecording(2, argv),
+          "track.rec");
+      TS_ASSERT_EQUALS(
+          opendlv::logic::cfsd18::tools::Latency::parseRecording(1, argv), "");
+    }
+};
+
+#endif
@@ -0,0 +1,81 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_TOOLS_REPLAY_HPP
+#define OPENDLV_LOGIC_CFSD18_TOOLS_REPLAY_HPP
+
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <opendavinci/odcore/base/KeyValueConfiguration.h>
+#include <opendavinci/odcore/base/module/DataTriggeredConferenceClientModule.h>
+#include <opendavinci/odcore/data/Container.h>
+
+#include "inprocessbus.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace tools {
+
+/**
+ * Replays a recording into one microservice without a conference. The
+ * microservice is set up from a configuration file, the recording is read
+ * into memory, and its containers are then passed to the microservice's
+ * nextContainer, as fast as possible or at the pace they were recorded. The
+ * clock of the microservices follows the recorded time stamps, so that the
+ * containers are as old as they were on the car. What the microservice sends
+ * is kept in memory.
+ */
+class Replay {
+ public:
+  Replay(int32_t const &, char **);
+  Replay(Replay const &) = delete;
+  Replay &operator=(Replay const &) = delete;
+  virtual ~Replay();
+
+  int32_t run();
+  bool load(std::string const &, odcore::base::KeyValueConfiguration const &);
+  void replay(std::vector<odcore::data::Container> &, bool);
+  std::vector<odcore::data::Container> const &sent() const
+    __attribute__((const));
+  std::string report() const;
+  static std::vector<odcore::data::Container> read(std::istream &);
+
+ private:
+  int32_t m_argc;
+  char **m_argv;
+  common::InProcessBus m_bus;
+  std::unique_ptr<
+    odcore::base::module::DataTriggeredConferenceClientModule> m_microservice;
+  std::string m_name;
+  std::vector<odcore::data::Container> m_sent;
+  uint32_t m_replayed;
+  double m_duration;
+};
+
+}
+}
+}
+}
+
+#endif
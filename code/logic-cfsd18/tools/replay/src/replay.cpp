@@ -0,0 +1,193 @@
+/**
+* Copyright (C) 2017 Chalmers Revere
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+* USA.
+*/
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <thread>
+
+#include "composition.hpp"
+#include "replay.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace tools {
+
+Replay::Replay(int32_t const &a_argc, char **a_argv) :
+  m_argc(a_argc),
+  m_argv(a_argv),
+  m_bus(common::Delivery::Direct, common::Mirroring::None),
+  m_microservice(),
+  m_name(),
+  m_sent(),
+  m_replayed(0),
+  m_duration(0.0)
+{
+}
+
+Replay::~Replay()
+{
+}
+
+/**
+ * Replays the recording given by --rec into the microservice given by
+ * --microservice, set up from the configuration file given by
+ * --configuration, at the pace given by --pace, and reports the throughput.
+ */
+int32_t Replay::run()
+{
+  std::string const recording = Composition::argument(m_argc, m_argv, "rec");
+  std::string const configurationFile =
+    Composition::argument(m_argc, m_argv, "configuration");
+  std::string const name =
+    Composition::argument(m_argc, m_argv, "microservice");
+  if (recording.empty() || configurationFile.empty() || name.empty()) {
+    std::cerr << "Usage: " << m_argv[0] << " --rec=<FILE> "
+      << "--configuration=<FILE> --microservice=<name> "
+      << "[--pace=max|real-time]" << std::endl;
+    return 1;
+  }
+
+  std::ifstream configurationStream(configurationFile);
+  if (!configurationStream.good()) {
+    std::cerr << "Cannot open the configuration '" << configurationFile
+      << "'." << std::endl;
+    return 1;
+  }
+  odcore::base::KeyValueConfiguration configuration;
+  configurationStream >> configuration;
+  if (!load(name, configuration)) {
+    std::cerr << "Unknown microservice " << name << "." << std::endl;
+    return 1;
+  }
+
+  std::ifstream file(recording, std::ios::in | std::ios::binary);
+  if (!file.good()) {
+    std::cerr << "Cannot open the recording '" << recording << "'."
+      << std::endl;
+    return 1;
+  }
+  std::vector<odcore::data::Container> containers = read(file);
+
+  bool const isRealTime =
+    Composition::argument(m_argc, m_argv, "pace") == "real-time";
+  replay(containers, isRealTime);
+  std::cout << report();
+  return 0;
+}
+
+/**
+ * Creates the microservice on a bus without mirroring, so that it never uses
+ * its conference, sets it up from the configuration, and captures everything
+ * it sends.
+ */
+bool Replay::load(std::string const &a_name,
+    odcore::base::KeyValueConfiguration const &a_configuration)
+{
+  m_microservice = Composition::create(a_name, m_argc, m_argv, m_bus,
+      &a_configuration);
+  if (m_microservice == nullptr) {
+    return false;
+  }
+  m_name = a_name;
+  m_bus.subscribe([this](odcore::data::Container &a_container) {
+      m_sent.push_back(a_container);
+    });
+  return true;
+}
+
+/**
+ * Passes the containers to the microservice in order, with the clock held at
+ * the time each one was received during the recording. In real time, each
+ * one is also held back until as much time has passed since the first as
+ * between when they were received.
+ */
+void Replay::replay(std::vector<odcore::data::Container> &a_containers,
+    bool a_isRealTime)
+{
+  if (m_microservice == nullptr || a_containers.empty()) {
+    return;
+  }
+
+  int64_t const firstTime =
+    a_containers.front().getReceivedTimeStamp().toMicroseconds();
+  auto const start = std::chrono::steady_clock::now();
+  for (auto &container : a_containers) {
+    if (a_isRealTime) {
+      int64_t const offset =
+        container.getReceivedTimeStamp().toMicroseconds() - firstTime;
+      std::this_thread::sleep_until(start + std::chrono::microseconds(offset));
+    }
+    m_bus.clock().simulate(container.getReceivedTimeStamp());
+    m_microservice->nextContainer(container);
+  }
+  m_bus.clock().release();
+  m_duration = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+  m_replayed += static_cast<uint32_t>(a_containers.size());
+}
+
+std::vector<odcore::data::Container> const &Replay::sent() const
+{
+  return m_sent;
+}
+
+std::string Replay::report() const
+{
+  std::map<int32_t, uint32_t> sentPerDataType;
+  for (auto const &container : m_sent) {
+    sentPerDataType[container.getDataType()]++;
+  }
+
+  std::stringstream report;
+  report << "Replayed " << m_replayed << " containers to " << m_name << " in "
+    << m_duration << " s";
+  if (m_duration > 0.0) {
+    report << " (" << static_cast<double>(m_replayed) / m_duration
+      << " containers/s)";
+  }
+  report << ", which sent " << m_sent.size() << " containers." << std::endl;
+  for (auto const &count : sentPerDataType) {
+    report << "  data type " << count.first << ": " << count.second
+      << std::endl;
+  }
+  return report.str();
+}
+
+std::vector<odcore::data::Container> Replay::read(std::istream &a_recording)
+{
+  std::vector<odcore::data::Container> containers;
+  while (a_recording.good()) {
+    odcore::data::Container container;
+    a_recording >> container;
+    if (a_recording.fail()) {
+      break;
+    }
+    containers.push_back(container);
+  }
+  return containers;
+}
+
+}
+}
+}
+}
@@ -0,0 +1,116 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_TOOLS_SIMULATOR_HPP
+#define OPENDLV_LOGIC_CFSD18_TOOLS_SIMULATOR_HPP
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <opendavinci/odcore/base/KeyValueConfiguration.h>
+#include <opendavinci/odcore/base/module/DataTriggeredConferenceClientModule.h>
+#include <opendavinci/odcore/data/Container.h>
+
+#include "inprocessbus.hpp"
+#include "syntheticsensor.hpp"
+#include "synthetictrack.hpp"
+#include "vehicle.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace tools {
+
+/**
+ * Closes the loop around the logic without the car. The microservices run
+ * on an in-process bus without a conference, and the simulator takes the
+ * place of the car and its perception: it answers their steering,
+ * acceleration and deceleration requests with the vehicle dynamics, and
+ * sends ground speed readings, geolocations and detections of a synthetic
+ * track. The microservices are set up from a configuration file, as they
+ * would be by the conference. The simulator steps the clock of their bus, so
+ * the loop runs as fast as they can handle it, and the detections can be
+ * delayed to measure how the lap time depends on the perception latency.
+ */
+class Simulator {
+ public:
+  static float const TIME_STEP;
+
+  Simulator(int32_t const &, char **);
+  Simulator(Simulator const &) = delete;
+  Simulator &operator=(Simulator const &) = delete;
+  virtual ~Simulator();
+
+  int32_t run();
+  bool load(std::string const &, std::vector<std::string> const &,
+      odcore::base::KeyValueConfiguration const &, float, uint32_t);
+  void simulate(float, float, bool);
+  bool hasFinished() const;
+  bool hasLeftTrack() const;
+  float lapTime() const;
+  float maxCrossTrackError() const;
+  std::string report() const;
+  static std::vector<std::string> microservicesOf(std::string const &);
+
+ private:
+  void receive(odcore::data::Container &);
+  void publish(odcore::data::Container &);
+  void sense(bool, float);
+  void track();
+
+  int32_t m_argc;
+  char **m_argv;
+  std::vector<std::string> m_arguments;
+  int32_t m_microserviceArgc;
+  std::vector<char *> m_microserviceArgv;
+  common::InProcessBus m_bus;
+  std::vector<std::unique_ptr<
+    odcore::base::module::DataTriggeredConferenceClientModule>> m_microservices;
+  uint32_t m_id;
+  std::string m_mission;
+  common::SyntheticTrack m_track;
+  common::SyntheticSensor m_sensor;
+  Vehicle m_vehicle;
+  std::deque<std::pair<int64_t, std::vector<odcore::data::Container>>>
+    m_pendingDetections;
+  float m_finish;
+  int64_t m_epoch;
+  int64_t m_time;
+  float m_distance;
+  float m_acceleration;
+  float m_deceleration;
+  float m_lapTime;
+  float m_maxCrossTrackError;
+  float m_maxLateralAcceleration;
+  bool m_hasLeftTrack;
+  uint32_t m_steeringRequests;
+  uint32_t m_accelerationRequests;
+  double m_duration;
+};
+
+}
+}
+}
+}
+
+#endif
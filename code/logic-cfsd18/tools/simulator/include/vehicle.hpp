@@ -0,0 +1,77 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_TOOLS_VEHICLE_HPP
+#define OPENDLV_LOGIC_CFSD18_TOOLS_VEHICLE_HPP
+
+#include <opendavinci/odcore/wrapper/Eigen.h>
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace tools {
+
+/**
+ * Planar vehicle dynamics for the simulator: a single-track (bicycle) model
+ * with a simplified Pacejka tyre on each axle, first order steering and
+ * acceleration actuators, and aerodynamic drag. Below walking pace, where
+ * slip angles are undefined, it falls back to the kinematic model.
+ */
+class Vehicle {
+ public:
+  Vehicle(float, float, float);
+  Vehicle(Vehicle const &) = default;
+  Vehicle &operator=(Vehicle const &) = default;
+  virtual ~Vehicle();
+
+  void place(Eigen::Vector3f const &);
+  void setSteeringRequest(float);
+  void setAccelerationRequest(float);
+  void step(float);
+  Eigen::Vector3f pose() const;
+  float speed() const;
+  float steering() const;
+  float lateralAcceleration() const;
+
+ private:
+  float tyreForce(float, float) const;
+
+  float m_mass;
+  float m_wheelBase;
+  float m_friction;
+  float m_yawInertia;
+  float m_steeringRequest;
+  float m_accelerationRequest;
+  float m_x;
+  float m_y;
+  float m_yaw;
+  float m_longitudinalSpeed;
+  float m_lateralSpeed;
+  float m_yawRate;
+  float m_steering;
+  float m_acceleration;
+  float m_lateralAcceleration;
+};
+
+}
+}
+}
+}
+
+#endif
@@ -0,0 +1,429 @@
+/**
+* Copyright (C) 2017 Chalmers Revere
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+* USA.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <utility>
+
+#include <opendavinci/odcore/data/TimeStamp.h>
+
+#include <odvdcfsd18/GeneratedHeaders_ODVDcfsd18.h>
+
+#include "composition.hpp"
+#include "missionsupervisor.hpp"
+#include "simulator.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace tools {
+
+namespace {
+
+odcore::data::TimeStamp toTimeStamp(int64_t a_microseconds)
+{
+  return odcore::data::TimeStamp(static_cast<int32_t>(a_microseconds / 1000000),
+      static_cast<int32_t>(a_microseconds % 1000000));
+}
+
+common::MissionId missionIdOf(std::string const &a_mission)
+{
+  if (a_mission == "trackdrive") {
+    return common::MissionId::Trackdrive;
+  } else if (a_mission == "skidpad") {
+    return common::MissionId::Skidpad;
+  } else if (a_mission == "acceleration") {
+    return common::MissionId::Acceleration;
+  }
+  return common::MissionId::None;
+}
+
+}
+
+float const Simulator::TIME_STEP = 0.001f;
+
+Simulator::Simulator(int32_t const &a_argc, char **a_argv) :
+  m_argc(a_argc),
+  m_argv(a_argv),
+  m_arguments(a_argv, a_argv + a_argc),
+  m_microserviceArgc(0),
+  m_microserviceArgv(),
+  m_bus(common::Delivery::Direct, common::Mirroring::None),
+  m_microservices(),
+  m_id(0),
+  m_mission(),
+  m_track(),
+  m_sensor(1, 30.0f, 0.02f, 0.002f, 0.0f),
+  m_vehicle(210.0f, 1.53f, 1.5f),
+  m_pendingDetections(),
+  m_finish(0.0f),
+  m_epoch(0),
+  m_time(0),
+  m_distance(0.0f),
+  m_acceleration(0.0f),
+  m_deceleration(0.0f),
+  m_lapTime(-1.0f),
+  m_maxCrossTrackError(0.0f),
+  m_maxLateralAcceleration(0.0f),
+  m_hasLeftTrack(false),
+  m_steeringRequests(0),
+  m_accelerationRequests(0),
+  m_duration(0.0)
+{
+  // The microservices never join a conference, but they are still
+  // constructed with the arguments of one.
+  if (Composition::argument(a_argc, a_argv, "cid").empty()) {
+    m_arguments.push_back("--cid=253");
+  }
+  for (auto &argument : m_arguments) {
+    m_microserviceArgv.push_back(&argument[0]);
+  }
+  m_microserviceArgc = static_cast<int32_t>(m_arguments.size());
+  m_microserviceArgv.push_back(nullptr);
+}
+
+Simulator::~Simulator()
+{
+}
+
+/**
+ * Simulates the mission given by --mission with the microservices set up
+ * from the configuration file given by --configuration, until the car
+ * finishes, leaves the track or the time given by --duration [s] runs out,
+ * and reports the lap. The exit code tells whether the car finished.
+ */
+int32_t Simulator::run()
+{
+  std::string const configurationFile =
+    Composition::argument(m_argc, m_argv, "configuration");
+  std::string mission = Composition::argument(m_argc, m_argv, "mission");
+  mission = mission.empty() ? "trackdrive" : mission;
+  std::vector<std::string> names =
+    Composition::parseMicroservices(m_argc, m_argv);
+  if (names.empty()) {
+    names = microservicesOf(mission);
+  }
+  std::string const length = Composition::argument(m_argc, m_argv, "length");
+  std::string const laps = Composition::argument(m_argc, m_argv, "laps");
+  std::string const latency = Composition::argument(m_argc, m_argv, "latency");
+  std::string const duration =
+    Composition::argument(m_argc, m_argv, "duration");
+
+  if (configurationFile.empty()) {
+    std::cerr << "Usage: " << m_argv[0] << " --configuration=<FILE>"
+      << " [--mission=trackdrive|skidpad|acceleration] [--length=<m>]"
+      << " [--laps=<n>] [--latency=<s>] [--duration=<s>]"
+      << " [--microservices=<name>[,<name>...]] [--pace=max|real-time]"
+      << std::endl;
+    return 1;
+  }
+  std::ifstream configurationStream(configurationFile);
+  if (!configurationStream.good()) {
+    std::cerr << "Cannot open the configuration '" << configurationFile
+      << "'." << std::endl;
+    return 1;
+  }
+  odcore::base::KeyValueConfiguration configuration;
+  configurationStream >> configuration;
+  if (!load(mission, names, configuration,
+        length.empty() ? 1000.0f : std::stof(length),
+        laps.empty() ? 1 : static_cast<uint32_t>(std::stoul(laps)))) {
+    std::cerr << "Cannot load the mission " << mission << "." << std::endl;
+    return 1;
+  }
+  simulate(duration.empty() ? 600.0f : std::stof(duration),
+      latency.empty() ? 0.05f : std::stof(latency),
+      Composition::argument(m_argc, m_argv, "pace") == "real-time");
+  std::cout << report();
+  return hasFinished() ? 0 : 1;
+}
+
+/**
+ * Builds the track of the mission, of the given length and number of laps
+ * for the trackdrive, and creates the microservices on the bus, set up from
+ * the configuration. The
+ * trackdrive layout only depends on its length, so that lap times stay
+ * comparable between runs.
+ */
+bool Simulator::load(std::string const &a_mission,
+    std::vector<std::string> const &a_microservices,
+    odcore::base::KeyValueConfiguration const &a_configuration,
+    float a_length, uint32_t a_laps)
+{
+  if (a_mission == "trackdrive") {
+    m_track = common::SyntheticTrack::trackdrive(a_length, 1);
+    m_finish = static_cast<float>(a_laps) * m_track.centreline().length();
+  } else if (a_mission == "skidpad") {
+    m_track = common::SyntheticTrack::skidpad();
+    m_finish = m_track.centreline().length() - 20.0f;
+  } else if (a_mission == "acceleration") {
+    m_track = common::SyntheticTrack::acceleration();
+    m_finish = 75.0f;
+  } else {
+    return false;
+  }
+
+  for (auto const &name : a_microservices) {
+    auto microservice = Composition::create(name, m_microserviceArgc,
+        m_microserviceArgv.data(), m_bus, &a_configuration);
+    if (microservice == nullptr) {
+      std::cerr << "Unknown microservice " << name << "." << std::endl;
+      return false;
+    }
+    m_microservices.push_back(std::move(microservice));
+  }
+  m_id = m_bus.subscribe([this](odcore::data::Container &a_container) {
+      receive(a_container);
+    });
+  m_mission = a_mission;
+  m_vehicle.place(m_track.poseAt(0.0f));
+  return true;
+}
+
+/**
+ * Runs the loop for at most the given time [s], in steps of one
+ * millisecond. Ground speed and geolocation are sent at 100 Hz, and the
+ * detections are captured at 10 Hz and sent after the given latency [s]. In
+ * real time, every step waits for the wall clock to catch up.
+ */
+void Simulator::simulate(float a_duration, float a_latency, bool a_isRealTime)
+{
+  uint32_t const sensorSteps = 10;
+  uint32_t const detectionSteps = 100;
+  int64_t const timeStep = static_cast<int64_t>(TIME_STEP * 1000000.0f);
+  int64_t const duration = static_cast<int64_t>(a_duration * 1000000.0f);
+
+  m_epoch = odcore::data::TimeStamp().toMicroseconds();
+  auto const start = std::chrono::steady_clock::now();
+  m_bus.clock().simulate(toTimeStamp(m_epoch + m_time));
+  opendlv::system::SystemOperationState systemOperationState(
+      static_cast<int32_t>(missionIdOf(m_mission)), "");
+  odcore::data::Container mission(systemOperationState);
+  publish(mission);
+
+  for (uint64_t i = 0; m_time < duration && !hasFinished() && !m_hasLeftTrack;
+      i++) {
+    m_bus.clock().simulate(toTimeStamp(m_epoch + m_time));
+    if (i % sensorSteps == 0) {
+      sense(i % detectionSteps == 0, a_latency);
+    }
+    while (!m_pendingDetections.empty()
+        && m_pendingDetections.front().first <= m_time) {
+      for (auto &container : m_pendingDetections.front().second) {
+        publish(container);
+      }
+      m_pendingDetections.pop_front();
+    }
+
+    m_vehicle.step(TIME_STEP);
+    m_time += timeStep;
+    if (i % sensorSteps == 0) {
+      track();
+    }
+    if (a_isRealTime) {
+      std::this_thread::sleep_until(start + std::chrono::microseconds(m_time));
+    }
+  }
+  m_duration = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+  m_bus.clock().release();
+}
+
+bool Simulator::hasFinished() const
+{
+  return m_lapTime >= 0.0f;
+}
+
+bool Simulator::hasLeftTrack() const
+{
+  return m_hasLeftTrack;
+}
+
+float Simulator::lapTime() const
+{
+  return m_lapTime;
+}
+
+float Simulator::maxCrossTrackError() const
+{
+  return m_maxCrossTrackError;
+}
+
+std::string Simulator::report() const
+{
+  float const time = static_cast<float>(m_time) / 1000000.0f;
+  std::stringstream report;
+  report << "Mission " << m_mission << " over "
+    << m_track.centreline().length() << " m: ";
+  if (hasFinished()) {
+    report << "finished in " << m_lapTime << " s";
+  } else if (m_hasLeftTrack) {
+    report << "left the track after " << m_distance << " m and " << time
+      << " s";
+  } else {
+    report << "did not finish, " << m_distance << " m in " << time << " s";
+  }
+  report << ", max cross-track error " << m_maxCrossTrackError
+    << " m, max lateral acceleration " << m_maxLateralAcceleration
+    << " m/s^2, " << m_steeringRequests << " steering and "
+    << m_accelerationRequests << " acceleration requests." << std::endl
+    << "Simulated " << time << " s in " << m_duration << " s";
+  if (m_duration > 0.0) {
+    report << " (" << static_cast<double>(time) / m_duration
+      << " times real time)";
+  }
+  report << "." << std::endl;
+  return report.str();
+}
+
+/**
+ * The microservices that drive a mission: its planner, the steering limit
+ * and the two controllers.
+ */
+std::vector<std::string> Simulator::microservicesOf(
+    std::string const &a_mission)
+{
+  std::vector<std::string> names;
+  if (a_mission == "trackdrive") {
+    names.push_back("track");
+  } else if (a_mission == "skidpad" || a_mission == "acceleration") {
+    names.push_back(a_mission);
+  } else {
+    return names;
+  }
+  names.push_back("limitlateral");
+  names.push_back("lateral");
+  names.push_back("longitudinal");
+  return names;
+}
+
+/**
+ * Requests from the controllers go to the actuators of the vehicle. The
+ * active one of acceleration and deceleration sets the command, since the
+ * other is released with a zero.
+ */
+void Simulator::receive(odcore::data::Container &a_container)
+{
+  int32_t const dataType = a_container.getDataType();
+  if (dataType == opendlv::proxy::GroundSteeringRequest::ID()) {
+    auto request =
+      a_container.getData<opendlv::proxy::GroundSteeringRequest>();
+    m_vehicle.setSteeringRequest(request.getGroundSteering());
+    m_steeringRequests++;
+  } else if (dataType == opendlv::proxy::GroundAccelerationRequest::ID()) {
+    auto request =
+      a_container.getData<opendlv::proxy::GroundAccelerationRequest>();
+    m_acceleration = request.getGroundAcceleration();
+    m_vehicle.setAccelerationRequest(m_acceleration - m_deceleration);
+    m_accelerationRequests++;
+  } else if (dataType == opendlv::proxy::GroundDecelerationRequest::ID()) {
+    auto request =
+      a_container.getData<opendlv::proxy::GroundDecelerationRequest>();
+    m_deceleration = request.getGroundDeceleration();
+    m_vehicle.setAccelerationRequest(m_acceleration - m_deceleration);
+    m_accelerationRequests++;
+  }
+}
+
+/**
+ * Stamps the container as the conference would and hands it to the
+ * microservices.
+ */
+void Simulator::publish(odcore::data::Container &a_container)
+{
+  odcore::data::TimeStamp const now = m_bus.clock().now();
+  a_container.setSentTimeStamp(now);
+  a_container.setReceivedTimeStamp(now);
+  m_bus.publish(m_id, a_container);
+}
+
+/**
+ * Sends the ground speed and the geolocation, and captures the detections:
+ * the surfaces ahead, as the lane detection would send them, and the cones
+ * in view. Detections keep the time of capture as their sample time, so
+ * that the microservices see their age.
+ */
+void Simulator::sense(bool a_isDetecting, float a_latency)
+{
+  uint32_t const surfaceCount = 10;
+
+  Eigen::Vector3f const pose = m_vehicle.pose();
+  odcore::data::TimeStamp const now = m_bus.clock().now();
+
+  opendlv::proxy::GroundSpeedReading groundSpeedReading(m_vehicle.speed());
+  odcore::data::Container speed(groundSpeedReading);
+  speed.setSampleTimeStamp(now);
+  publish(speed);
+  opendlv::logic::sensation::Geolocation geolocation =
+    m_sensor.geolocation(pose);
+  odcore::data::Container position(geolocation);
+  position.setSampleTimeStamp(now);
+  publish(position);
+
+  if (a_isDetecting) {
+    std::vector<odcore::data::Container> detections =
+      m_sensor.surfaces(m_track, pose, m_distance, surfaceCount);
+    std::vector<odcore::data::Container> const objects =
+      m_sensor.objects(m_track, pose);
+    detections.insert(detections.end(), objects.begin(), objects.end());
+    for (auto &detection : detections) {
+      detection.setSampleTimeStamp(now);
+    }
+    m_pendingDetections.push_back(std::make_pair(
+          m_time + static_cast<int64_t>(a_latency * 1000000.0f),
+          std::move(detections)));
+  }
+}
+
+/**
+ * Follows the car along the centreline, and ends the run when it finishes
+ * or is more than half a metre outside the track.
+ */
+void Simulator::track()
+{
+  float const window = 4.0f;
+  float const margin = 0.5f;
+
+  Eigen::Vector3f const pose = m_vehicle.pose();
+  Eigen::Vector2f const position(pose(0), pose(1));
+  m_distance = m_track.distanceAlong(position, m_distance, window);
+  Eigen::Vector3f const centre = m_track.poseAt(m_distance);
+  float const crossTrackError =
+    (position - Eigen::Vector2f(centre(0), centre(1))).norm();
+
+  m_maxCrossTrackError = std::max(m_maxCrossTrackError, crossTrackError);
+  m_maxLateralAcceleration = std::max(m_maxLateralAcceleration,
+      std::fabs(m_vehicle.lateralAcceleration()));
+  if (crossTrackError > 0.5f * common::SyntheticTrack::WIDTH + margin) {
+    m_hasLeftTrack = true;
+  }
+  if (!hasFinished() && m_distance >= m_finish) {
+    m_lapTime = static_cast<float>(m_time) / 1000000.0f;
+  }
+}
+
+}
+}
+}
+}
@@ -0,0 +1,197 @@
+/**
+* Copyright (C) 2017 Chalmers Revere
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+* USA.
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include "vehicle.hpp"
+
+namespace opendlv {
+namespace logic {
+namespace cfsd18 {
+namespace tools {
+
+namespace {
+
+float const gravity = 9.81f;
+float const maxSteering = 0.4f;
+float const maxSteeringRate = 3.0f;
+float const steeringTimeConstant = 0.05f;
+float const accelerationTimeConstant = 0.1f;
+float const dragCoefficient = 0.7f;
+float const rollingResistance = 0.015f;
+float const tyreStiffness = 12.0f;
+float const tyreShape = 1.4f;
+float const kinematicSpeed = 2.0f;
+
+}
+
+/**
+ * Takes the mass [kg], the wheel base [m] and the tyre friction coefficient.
+ * The weight is split evenly between the axles, and the yaw inertia is that
+ * of the mass at half the wheel base from the centre of mass.
+ */
+Vehicle::Vehicle(float a_mass, float a_wheelBase, float a_friction) :
+  m_mass(a_mass),
+  m_wheelBase(a_wheelBase),
+  m_friction(a_friction),
+  m_yawInertia(a_mass * 0.25f * a_wheelBase * a_wheelBase),
+  m_steeringRequest(0.0f),
+  m_accelerationRequest(0.0f),
+  m_x(0.0f),
+  m_y(0.0f),
+  m_yaw(0.0f),
+  m_longitudinalSpeed(0.0f),
+  m_lateralSpeed(0.0f),
+  m_yawRate(0.0f),
+  m_steering(0.0f),
+  m_acceleration(0.0f),
+  m_lateralAcceleration(0.0f)
+{
+}
+
+Vehicle::~Vehicle()
+{
+}
+
+/**
+ * Puts the car standing still at the given position and heading.
+ */
+void Vehicle::place(Eigen::Vector3f const &a_pose)
+{
+  m_x = a_pose(0);
+  m_y = a_pose(1);
+  m_yaw = a_pose(2);
+  m_longitudinalSpeed = 0.0f;
+  m_lateralSpeed = 0.0f;
+  m_yawRate = 0.0f;
+  m_steering = 0.0f;
+  m_acceleration = 0.0f;
+  m_lateralAcceleration = 0.0f;
+}
+
+void Vehicle::setSteeringRequest(float a_steering)
+{
+  m_steeringRequest = std::min(std::max(a_steering, -maxSteering), maxSteering);
+}
+
+/**
+ * Positive values accelerate and negative ones brake.
+ */
+void Vehicle::setAccelerationRequest(float a_acceleration)
+{
+  m_accelerationRequest = a_acceleration;
+}
+
+/**
+ * Advances the state by the given time step [s] with explicit Euler, which
+ * is stable for steps of a few milliseconds.
+ */
+void Vehicle::step(float a_timeStep)
+{
+  float const halfWheelBase = 0.5f * m_wheelBase;
+  float const maxAcceleration = m_friction * gravity;
+
+  float const steeringRate = std::min(std::max(
+        (m_steeringRequest - m_steering) / steeringTimeConstant,
+        -maxSteeringRate), maxSteeringRate);
+  m_steering += steeringRate * a_timeStep;
+  float const acceleration = std::min(std::max(m_accelerationRequest,
+        -maxAcceleration), maxAcceleration);
+  m_acceleration += (acceleration - m_acceleration) * a_timeStep
+    / accelerationTimeConstant;
+
+  float const resistance = (m_longitudinalSpeed > 0.0f)
+    ? rollingResistance * gravity + dragCoefficient * m_longitudinalSpeed
+      * m_longitudinalSpeed / m_mass : 0.0f;
+
+  if (m_longitudinalSpeed < kinematicSpeed) {
+    m_longitudinalSpeed += (m_acceleration - resistance) * a_timeStep;
+    float const slip = std::atan(0.5f * std::tan(m_steering));
+    m_lateralSpeed = m_longitudinalSpeed * std::tan(slip);
+    m_yawRate = m_longitudinalSpeed * std::tan(m_steering) * std::cos(slip)
+      / m_wheelBase;
+    m_lateralAcceleration = m_longitudinalSpeed * m_yawRate;
+  } else {
+    float const axleLoad = 0.5f * m_mass * gravity;
+    float const frontSlip = m_steering - std::atan2(
+        m_lateralSpeed + halfWheelBase * m_yawRate, m_longitudinalSpeed);
+    float const rearSlip = -std::atan2(
+        m_lateralSpeed - halfWheelBase * m_yawRate, m_longitudinalSpeed);
+    float const frontForce = tyreForce(frontSlip, axleLoad);
+    float const rearForce = tyreForce(rearSlip, axleLoad);
+
+    float const lateralForce = frontForce * std::cos(m_steering) + rearForce;
+    m_longitudinalSpeed += (m_acceleration - resistance
+        - frontForce * std::sin(m_steering) / m_mass
+        + m_lateralSpeed * m_yawRate) * a_timeStep;
+    m_lateralSpeed += (lateralForce / m_mass
+        - m_longitudinalSpeed * m_yawRate) * a_timeStep;
+    m_yawRate += halfWheelBase * (frontForce * std::cos(m_steering)
+        - rearForce) / m_yawInertia * a_timeStep;
+    m_lateralAcceleration = lateralForce / m_mass;
+  }
+  if (m_longitudinalSpeed < 0.0f) {
+    m_longitudinalSpeed = 0.0f;
+    m_lateralSpeed = 0.0f;
+    m_yawRate = 0.0f;
+  }
+
+  float const cosYaw = std::cos(m_yaw);
+  float const sinYaw = std::sin(m_yaw);
+  m_x += (m_longitudinalSpeed * cosYaw - m_lateralSpeed * sinYaw) * a_timeStep;
+  m_y += (m_longitudinalSpeed * sinYaw + m_lateralSpeed * cosYaw) * a_timeStep;
+  m_yaw += m_yawRate * a_timeStep;
+}
+
+Eigen::Vector3f Vehicle::pose() const
+{
+  return Eigen::Vector3f(m_x, m_y, m_yaw);
+}
+
+float Vehicle::speed() const
+{
+  return m_longitudinalSpeed;
+}
+
+float Vehicle::steering() const
+{
+  return m_steering;
+}
+
+float Vehicle::lateralAcceleration() const
+{
+  return m_lateralAcceleration;
+}
+
+/**
+ * Lateral force of an axle at the given slip angle [rad] and load [N], from
+ * the magic formula without curvature factor, which saturates at the
+ * friction limit.
+ */
+float Vehicle::tyreForce(float a_slip, float a_load) const
+{
+  return m_friction * a_load
+    * std::sin(tyreShape * std::atan(tyreStiffness * a_slip));
+}
+
+}
+}
+}
+}
@@ -0,0 +1,176 @@
+/**
+ * Copyright (C) 2017 Chalmers Revere
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301,
+ * USA.
+ */
+
+#ifndef OPENDLV_LOGIC_CFSD18_TOOLS_SIMULATOR_TESTSUITE_HPP
+#define OPENDLV_LOGIC_CFSD18_TOOLS_SIMULATOR_TESTSUITE_HPP
+
+#include <sstream>
+#include <string>
+
+#include <opendavinci/odcore/base/KeyValueConfiguration.h>
+
+#include "cxxtest/TestSuite.h"
+
+#include "../include/simulator.hpp"
+#include "../include/vehicle.hpp"
+
+class SimulatorTest : public CxxTest::TestSuite {
+  public:
+    // The defaults of the microservices, with the controllers triggered by
+    // their data.
+    static odcore::base::KeyValueConfiguration configuration()
+    {
+      std::stringstream file(
+          "logic-cfsd18-cognition-acceleration.statistics-period = 1.0\n"
+          "logic-cfsd18-cognition-acceleration.aim-distance = 10.0\n"
+          "logic-cfsd18-cognition-acceleration.preview-distance = 20.0\n"
+          "logic-cfsd18-cognition-acceleration.max-speed = 30.0\n"
+          "logic-cfsd18-cognition-track.statistics-period = 1.0\n"
+          "logic-cfsd18-cognition-track.aim-distance = 6.0\n"
+          "logic-cfsd18-cognition-track.preview-distance = 15.0\n"
+          "logic-cfsd18-cognition-track.max-lateral-acceleration = 10.0\n"
+          "logic-cfsd18-cognition-track.max-deceleration = 10.0\n"
+          "logic-cfsd18-cognition-track.max-speed = 20.0\n"
+          "logic-cfsd18-cognition-limitlateral.statistics-period = 1.0\n"
+          "logic-cfsd18-cognition-limitlateral.wheel-base = 1.53\n"
+          "logic-cfsd18-cognition-limitlateral.understeer-gradient = 0.0\n"
+          "logic-cfsd18-cognition-limitlateral.max-steering = 0.4\n"
+          "logic-cfsd18-cognition-limitlateral.max-speed = 30.0\n"
+          "logic-cfsd18-cognition-limitlateral.min-friction = 0.3\n"
+          "logic-cfsd18-cognition-limitlateral.max-friction = 1.5\n"
+          "logic-cfsd18-cognition-limitlateral.friction = 1.0\n"
+          "logic-cfsd18-cognition-limitlateral.publish-threshold = 0.005\n"
+          "logic-cfsd18-cognition-limitlateral.min-publish-interval = 0.02\n"
+          "logic-cfsd18-cognition-limitlateral.max-publish-interval = 0.5\n"
+          "logic-cfsd18-action-lateral.statistics-period = 1.0\n"
+          "logic-cfsd18-action-lateral.wheel-base = 1.53\n"
+          "logic-cfsd18-action-lateral.sample-time = 0.02\n"
+          "logic-cfsd18-action-lateral.lateral-weight = 1.0\n"
+          "logic-cfsd18-action-lateral.heading-weight = 1.0\n"
+          "logic-cfsd18-action-lateral.steering-weight = 0.1\n"
+          "logic-cfsd18-action-lateral.steering-rate-weight = 1.0\n"
+          "logic-cfsd18-action-lateral.actuator-delay = 0.05\n"
+          "logic-cfsd18-action-lateral.aim-point-deadline = 0.1\n"
+          "logic-cfsd18-action-lateral.mpc-deadline = 0.001\n"
+          "logic-cfsd18-action-lateral.controller = model-predictive\n"
+          "logic-cfsd18-action-lateral.max-steering = 0.4\n"
+          "logic-cfsd18-action-lateral.time-triggered = 0\n"
+          "logic-cfsd18-action-lateral.control-frequency = 100.0\n"
+          "logic-cfsd18-action-longitudinal.statistics-period = 1.0\n"
+          "logic-cfsd18-action-longitudinal.proportional-gain = 1.0\n"
+          "logic-cfsd18-action-longitudinal.integral-gain = 0.2\n"
+          "logic-cfsd18-action-longitudinal.anti-windup-gain = 10.0\n"
+          "logic-cfsd18-action-longitudinal.max-acceleration = 5.0\n"
+          "logic-cfsd18-action-longitudinal.max-deceleration = 10.0\n"
+          "logic-cfsd18-action-longitudinal.friction = 1.0\n"
+          "logic-cfsd18-action-longitudinal.target-slip = 0.1\n"
+          "logic-cfsd18-action-longitudinal.slip-gain = 5.0\n"
+          "logic-cfsd18-action-longitudinal.preview-distance = 15.0\n"
+          "logic-cfsd18-action-longitudinal.actuator-lag = 0.2\n"
+          "logic-cfsd18-action-longitudinal.max-lateral-acceleration = 10.0\n"
+          "logic-cfsd18-action-longitudinal.max-speed = 25.0\n"
+          "logic-cfsd18-action-longitudinal.time-triggered = 0\n"
+          "logic-cfsd18-action-longitudinal.control-frequency = 100.0\n");
+      odcore::base::KeyValueConfiguration configuration;
+      file >> configuration;
+      return configuration;
+    }
+
+    void setUp()
+    {
+    }
+
+    void tearDown()
+    {
+    }
+
+    void testApplication()
+    {
+      TS_ASSERT(true);
+    }
+
+    void testVehicleFollowsRequests()
+    {
+      opendlv::logic::cfsd18::tools::Vehicle vehicle(210.0f, 1.53f, 1.5f);
+      vehicle.place(Eigen::Vector3f(0.0f, 0.0f, 0.0f));
+      vehicle.setAccelerationRequest(2.0f);
+      for (uint32_t i = 0; i < 2000; i++) {
+        vehicle.step(0.001f);
+      }
+      TS_ASSERT(vehicle.speed() > 3.0f && vehicle.speed() < 4.0f);
+      TS_ASSERT_DELTA(vehicle.pose()(1), 0.0f, 1e-3f);
+
+      vehicle.setAccelerationRequest(0.0f);
+      vehicle.setSteeringRequest(1.0f);
+      for (uint32_t i = 0; i < 1000; i++) {
+        vehicle.step(0.001f);
+      }
+      TS_ASSERT_DELTA(vehicle.steering(), 0.4f, 1e-3f);
+      TS_ASSERT(vehicle.pose()(1) > 0.0f);
+      TS_ASSERT(vehicle.pose()(2) > 0.0f);
+      TS_ASSERT(vehicle.lateralAcceleration() > 0.0f);
+
+      vehicle.setAccelerationRequest(-10.0f);
+      for (uint32_t i = 0; i < 2000; i++) {
+        vehicle.step(0.001f);
+      }
+      TS_ASSERT_EQUALS(vehicle.speed(), 0.0f);
+    }
+
+    void testSimulatorFinishesAcceleration()
+    {
+      using opendlv::logic::cfsd18::tools::Simulator;
+
+      TS_ASSERT(Simulator::microservicesOf("unknown").empty());
+      char name[] = "simulator";
+      char *argv[] = {name};
+      Simulator simulator(1, argv);
+      TS_ASSERT(!simulator.load("unknown", {}, configuration(), 0.0f, 1));
+      TS_ASSERT(simulator.load("acceleration",
+            Simulator::microservicesOf("acceleration"), configuration(),
+            0.0f, 1));
+
+      simulator.simulate(30.0f, 0.05f, false);
+      TS_ASSERT(simulator.hasFinished());
+      TS_ASSERT(!simulator.hasLeftTrack());
+      TS_ASSERT(simulator.lapTime() > 3.0f && simulator.lapTime() < 15.0f);
+      TS_ASSERT(simulator.maxCrossTrackError() < 0.5f);
+      TS_ASSERT(simulator.report().find("finished in") != std::string::npos);
+    }
+
+    void testSimulatorSteersOnLateDetections()
+    {
+      using opendlv::logic::cfsd18::tools::Simulator;
+
+      // Detections older than the aim point deadline still steer the car,
+      // since the deadline only counts the last hop.
+      char name[] = "simulator";
+      char *argv[] = {name};
+      Simulator simulator(1, argv);
+      TS_ASSERT(simulator.load("trackdrive",
+            Simulator::microservicesOf("trackdrive"), configuration(),
+            300.0f, 1));
+
+      simulator.simulate(120.0f, 0.2f, false);
+      TS_ASSERT(simulator.hasFinished());
+      TS_ASSERT(!simulator.hasLeftTrack());
+    }
+};
+
+#endif